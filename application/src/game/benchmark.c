@@ -0,0 +1,531 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "game/benchmark.h"
+#include "game/level/level_scene.h"
+
+/// @brief Nombre de répétitions des mesures de sauvegarde de la scène.
+#define BENCHMARK_STATE_ITERATIONS 10000
+
+/// @brief Nombre d'images rendues pour chaque mesure des zones modifiées.
+#define BENCHMARK_DIRTY_FRAMES 300
+
+/// @brief Nombre maximal de particules et nombre d'images de chaque mesure
+/// des particules.
+#define BENCHMARK_PARTICLE_COUNT 50000
+#define BENCHMARK_PARTICLE_FRAMES 300
+
+/// @brief Nombre d'images rendues pour chaque mesure du SoftBlitter.
+#define BENCHMARK_BLITTER_FRAMES 120
+
+/// @brief Structure représentant un sprite animé par la mesure des zones
+/// modifiées (position et vitesse en pixels).
+typedef struct BenchmarkSprite
+{
+    float x, y;
+    float vx, vy;
+} BenchmarkSprite;
+
+/// @brief Structure représentant une scène de la mesure du SoftBlitter.
+typedef struct BenchmarkBlitScene
+{
+    const char *name;
+
+    /// @brief Agrandissement des sprites.
+    float scale;
+
+    /// @brief Booléen indiquant si les sprites sont tournés d'un nombre
+    /// variable de quarts de tour et retournés.
+    bool rotate;
+
+    /// @brief Opacité des sprites.
+    Uint8 alpha;
+} BenchmarkBlitScene;
+
+static double Benchmark_getMicroseconds(Uint64 start, Uint64 end, int count)
+{
+    double ticks = (double)(end - start);
+    return 1000000.0 * ticks / (double)SDL_GetPerformanceFrequency() / (double)count;
+}
+
+static void Benchmark_fillLevelScene(LevelScene *scene)
+{
+    // Remplit la scène jusqu'à sa capacité maximale
+    for (int i = LevelScene_getEnemyCount(scene); i < ENEMY_CAPACITY; i++)
+    {
+        Vec2 position = Vec2_set(8.0f + 0.25f * (i % 16), 1.0f + 0.5f * (i / 16));
+        Enemy *enemy = Enemy_create(scene, ENEMY_TYPE_FIGHTER, position);
+        LevelScene_addEnemy(scene, enemy);
+    }
+    for (int i = scene->m_bulletCount; i < BULLET_CAPACITY; i++)
+    {
+        Vec2 position = Vec2_set(0.5f * (i % 32), 0.5f * (i / 32));
+        Vec2 velocity = Vec2_set((i % 2) ? -3.5f : 8.0f, 0.0f);
+        int playerID = (i % 2) ? -1 : 0;
+        Bullet *bullet = Bullet_create(
+            scene, position, velocity,
+            BULLET_PLAYER_DEFAULT, 90.0f, DAMAGE_SMALL, playerID);
+        LevelScene_addBullet(scene, bullet);
+    }
+    for (int i = LevelScene_getItemCount(scene); i < ITEM_CAPACITY; i++)
+    {
+        Vec2 position = Vec2_set(2.0f * i, 8.0f);
+        Item *item = Item_create(scene, ITEM_CURE, position);
+        LevelScene_addItem(scene, item);
+    }
+}
+
+static void Benchmark_levelState(GameConfig *gameConfig)
+{
+    LevelScene *scene = LevelScene_create(gameConfig);
+    Benchmark_fillLevelScene(scene);
+
+    LevelSceneSave *saveA = (LevelSceneSave *)calloc(1, sizeof(LevelSceneSave));
+    LevelSceneSave *saveB = (LevelSceneSave *)calloc(1, sizeof(LevelSceneSave));
+    AssertNew(saveA);
+    AssertNew(saveB);
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < BENCHMARK_STATE_ITERATIONS; i++)
+    {
+        LevelScene_saveState(scene, saveA);
+    }
+    Uint64 end = SDL_GetPerformanceCounter();
+    double saveUS = Benchmark_getMicroseconds(start, end, BENCHMARK_STATE_ITERATIONS);
+
+    start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < BENCHMARK_STATE_ITERATIONS; i++)
+    {
+        LevelScene_restoreState(scene, saveA);
+    }
+    end = SDL_GetPerformanceCounter();
+    double restoreUS = Benchmark_getMicroseconds(start, end, BENCHMARK_STATE_ITERATIONS);
+
+    // Restauration après quelques pas de simulation : certaines entités
+    // doivent être recréées.
+    const int stepCount = 30;
+    for (int i = 0; i < stepCount; i++)
+    {
+        Timer_step(g_time, 16);
+        LevelScene_step(scene);
+    }
+    start = SDL_GetPerformanceCounter();
+    LevelScene_restoreState(scene, saveA);
+    end = SDL_GetPerformanceCounter();
+    double rebuildUS = Benchmark_getMicroseconds(start, end, 1);
+
+    LevelScene_saveState(scene, saveB);
+    bool identical = (memcmp(saveA, saveB, sizeof(LevelSceneSave)) == 0);
+
+    printf("INFO - Level state benchmark (%d enemies, %d bullets, %d items)\n",
+        scene->m_enemyCount, scene->m_bulletCount, scene->m_itemCount);
+    printf("     - save size %u bytes\n", (unsigned)sizeof(LevelSceneSave));
+    printf("     - save %.2f us, restore %.2f us (mean over %d)\n",
+        saveUS, restoreUS, BENCHMARK_STATE_ITERATIONS);
+    printf("     - restore after %d ticks %.2f us\n", stepCount, rebuildUS);
+    printf("     - round trip %s\n", identical ? "OK" : "MISMATCH");
+
+    // Historique de retour arrière sur quelques secondes de simulation
+    const int frameCount = 600;
+    RewindBuffer *rewind = RewindBuffer_create(sizeof(LevelSceneSave), frameCount, 30, 8 << 20);
+    start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < frameCount; i++)
+    {
+        Timer_step(g_time, 16);
+        LevelScene_step(scene);
+        LevelScene_saveState(scene, saveA);
+        RewindBuffer_push(rewind, saveA);
+    }
+    end = SDL_GetPerformanceCounter();
+    double pushUS = Benchmark_getMicroseconds(start, end, frameCount);
+
+    RewindBuffer_printStats(rewind, 60.f);
+
+    start = SDL_GetPerformanceCounter();
+    int popCount = 0;
+    while (RewindBuffer_getFrameCount(rewind) > 1)
+    {
+        RewindBuffer_pop(rewind, saveB);
+        popCount++;
+    }
+    end = SDL_GetPerformanceCounter();
+    double popUS = Benchmark_getMicroseconds(start, end, popCount > 0 ? popCount : 1);
+
+    printf("     - rewind step+save+push %.2f us, pop %.2f us\n", pushUS, popUS);
+    RewindBuffer_destroy(rewind);
+
+    free(saveA);
+    free(saveB);
+    LevelScene_destroy(scene);
+}
+
+static void Benchmark_resetSprites(BenchmarkSprite *sprites, int count)
+{
+    // Générateur congruentiel : les deux modes voient la même animation
+    Uint32 seed = 0x2545F491u;
+    for (int i = 0; i < count; i++)
+    {
+        BenchmarkSprite *sprite = sprites + i;
+        seed = seed * 1664525u + 1013904223u;
+        sprite->x = (float)((seed >> 8) & 0x3FF) / 1024.f * (float)(Game_getWidth() - 48);
+        seed = seed * 1664525u + 1013904223u;
+        sprite->y = (float)((seed >> 8) & 0x3FF) / 1024.f * (float)(Game_getHeight() - 48);
+        seed = seed * 1664525u + 1013904223u;
+        sprite->vx = (float)((int)((seed >> 8) & 0x7) - 4);
+        seed = seed * 1664525u + 1013904223u;
+        sprite->vy = (float)((int)((seed >> 8) & 0x7) - 4);
+    }
+}
+
+static double Benchmark_renderSprites(
+    LevelScene *scene, RenderSnapshot *snapshot, int sheetID,
+    BenchmarkSprite *sprites, int count)
+{
+    const float w = (float)(Game_getWidth() - 48);
+    const float h = (float)(Game_getHeight() - 48);
+    Uint64 ticks = 0;
+
+    Benchmark_resetSprites(sprites, count);
+    for (int frame = 0; frame < BENCHMARK_DIRTY_FRAMES; frame++)
+    {
+        RenderSnapshot_clear(snapshot);
+        RenderSnapshot_setLayer(snapshot, RENDER_LAYER_ENEMIES);
+        for (int i = 0; i < count; i++)
+        {
+            BenchmarkSprite *sprite = sprites + i;
+            sprite->x += sprite->vx;
+            sprite->y += sprite->vy;
+            if (sprite->x < 0.f || sprite->x > w) sprite->vx = -sprite->vx;
+            if (sprite->y < 0.f || sprite->y > h) sprite->vy = -sprite->vy;
+
+            SDL_FRect dst = { sprite->x, sprite->y, 48.f, 48.f };
+            RenderSnapshot_addSprite(snapshot, sheetID, 0, &dst, 0.0, SDL_FLIP_NONE);
+        }
+
+        // Seul le dessin est mesuré, pas la présentation à l'écran
+        Uint64 start = SDL_GetPerformanceCounter();
+        LevelScene_render(scene, snapshot);
+        SDL_RenderFlush(g_renderer);
+        ticks += SDL_GetPerformanceCounter() - start;
+
+        SDL_RenderPresent(g_renderer);
+        RenderState_endFrame(g_renderState);
+    }
+    return Benchmark_getMicroseconds(0, ticks, BENCHMARK_DIRTY_FRAMES) / 1000.0;
+}
+
+static void Benchmark_dirtyRects(GameConfig *gameConfig)
+{
+    GameConfig config = *gameConfig;
+    config.dirtyRects = true;
+
+    LevelScene *scene = LevelScene_create(&config);
+    DirtyRects *dirtyRects = scene->m_dirtyRects;
+    if (dirtyRects == NULL)
+    {
+        printf("ERROR - Dirty rectangles benchmark needs the software renderer\n");
+        LevelScene_destroy(scene);
+        return;
+    }
+
+    RenderSnapshot *snapshot = (RenderSnapshot *)calloc(1, sizeof(RenderSnapshot));
+    BenchmarkSprite *sprites = (BenchmarkSprite *)calloc(
+        RENDER_SNAPSHOT_SPRITE_CAPACITY, sizeof(BenchmarkSprite));
+    AssertNew(snapshot);
+    AssertNew(sprites);
+
+    snapshot->m_sceneState = SCENE_STATE_RUNNING;
+    snapshot->m_playerCount = scene->m_playerCount;
+    for (int i = 0; i < snapshot->m_playerCount; i++)
+    {
+        snapshot->m_playerHP[i] = 100;
+    }
+
+    const int counts[] = { 8, 32, 128, RENDER_SNAPSHOT_SPRITE_CAPACITY };
+    const int countCount = sizeof(counts) / sizeof(counts[0]);
+
+    printf("INFO - Dirty rectangles benchmark (%d frames of %dx%d)\n",
+        BENCHMARK_DIRTY_FRAMES, Game_getWidth(), Game_getHeight());
+    for (int i = 0; i < countCount; i++)
+    {
+        // Rendu complet
+        scene->m_dirtyRects = NULL;
+        double fullMS = Benchmark_renderSprites(scene, snapshot, SPRITE_FIGHTER_FIRING, sprites, counts[i]);
+
+        // Rendu des zones modifiées
+        scene->m_dirtyRects = dirtyRects;
+        DirtyRects_invalidate(dirtyRects);
+        Uint64 pixelCount = dirtyRects->m_totalPixelCount;
+        Uint64 fullFrameCount = dirtyRects->m_fullFrameCount;
+        double dirtyMS = Benchmark_renderSprites(scene, snapshot, SPRITE_FIGHTER_FIRING, sprites, counts[i]);
+        pixelCount = dirtyRects->m_totalPixelCount - pixelCount;
+        fullFrameCount = dirtyRects->m_fullFrameCount - fullFrameCount;
+
+        double screenPixels = (double)Game_getWidth() * (double)Game_getHeight();
+        printf("     - %3d sprites: full %.3f ms, dirty %.3f ms (x%.2f), "
+            "%.1f%% redrawn, %llu full frames\n",
+            counts[i], fullMS, dirtyMS, dirtyMS > 0.0 ? fullMS / dirtyMS : 0.0,
+            100.0 * (double)pixelCount / BENCHMARK_DIRTY_FRAMES / screenPixels,
+            (unsigned long long)fullFrameCount);
+    }
+
+    free(sprites);
+    free(snapshot);
+    LevelScene_destroy(scene);
+}
+
+static void Benchmark_particleFrames(
+    ParticleSystem *particles, Camera *camera, double *updateMS, double *renderMS)
+{
+    Uint64 updateTicks = 0;
+    Uint64 renderTicks = 0;
+    for (int frame = 0; frame < BENCHMARK_PARTICLE_FRAMES; frame++)
+    {
+        Uint64 start = SDL_GetPerformanceCounter();
+        ParticleSystem_update(particles, 1.f / 60.f);
+        Uint64 mid = SDL_GetPerformanceCounter();
+
+        RenderState_setDrawColor(g_renderState, 0, 0, 0, 255);
+        SDL_RenderClear(g_renderer);
+        ParticleSystem_render(particles, camera);
+        SDL_RenderFlush(g_renderer);
+        Uint64 end = SDL_GetPerformanceCounter();
+
+        SDL_RenderPresent(g_renderer);
+        RenderState_endFrame(g_renderState);
+        updateTicks += mid - start;
+        renderTicks += end - mid;
+    }
+
+    *updateMS = Benchmark_getMicroseconds(0, updateTicks, BENCHMARK_PARTICLE_FRAMES) / 1000.0;
+    *renderMS = Benchmark_getMicroseconds(0, renderTicks, BENCHMARK_PARTICLE_FRAMES) / 1000.0;
+}
+
+static void Benchmark_particles()
+{
+    ParticleSystem *particles = ParticleSystem_create(g_renderer, BENCHMARK_PARTICLE_COUNT);
+    Camera *camera = Camera_create(Game_getWidth(), Game_getHeight());
+
+    // Particules à longue durée de vie : leur nombre reste constant
+    ParticleParams sparks = *ParticleEffects_get(PARTICLE_EFFECT_SPARKS);
+    ParticleParams smoke = *ParticleEffects_get(PARTICLE_EFFECT_DEBRIS);
+    sparks.lifeMin = sparks.lifeMax = 1000.f;
+    smoke.lifeMin = smoke.lifeMax = 1000.f;
+    sparks.drag = smoke.drag = 0.f;
+    sparks.speedMin = smoke.speedMin = 0.05f;
+    sparks.speedMax = smoke.speedMax = 0.5f;
+
+    SDL_RendererInfo info = { 0 };
+    SDL_GetRendererInfo(g_renderer, &info);
+
+    // Le nombre de particules tenant 60 images par seconde dépend de la
+    // machine : plusieurs quantités sont mesurées
+    const int counts[] = { 5000, 10000, 20000, BENCHMARK_PARTICLE_COUNT };
+    const int countCount = sizeof(counts) / sizeof(counts[0]);
+    const int sourceCount = 100;
+    int sustainedCount = 0;
+
+    printf("INFO - Particle benchmark (%d frames, %s renderer)\n",
+        BENCHMARK_PARTICLE_FRAMES, info.name);
+    for (int i = 0; i < countCount; i++)
+    {
+        ParticleSystem_clear(particles);
+        for (int j = 0; j < sourceCount; j++)
+        {
+            Vec2 position = Vec2_set(1.f + 14.f * (j % 10) / 9.f, 1.f + 7.f * (j / 10) / 9.f);
+            int count = counts[i] / sourceCount;
+            ParticleSystem_emit(particles, &sparks, position, Vec2_zero, count / 2);
+            ParticleSystem_emit(particles, &smoke, position, Vec2_zero, count - count / 2);
+        }
+
+        double updateMS = 0.0, renderMS = 0.0;
+        Benchmark_particleFrames(particles, camera, &updateMS, &renderMS);
+        double frameMS = updateMS + renderMS;
+        if (frameMS <= 1000.0 / 60.0)
+        {
+            sustainedCount = ParticleSystem_getCount(particles);
+        }
+
+        printf("     - %5d particles: update %.3f ms, render %.3f ms, "
+            "%.1f frames/s at most\n",
+            ParticleSystem_getCount(particles), updateMS, renderMS,
+            frameMS > 0.0 ? 1000.0 / frameMS : 0.0);
+    }
+    if (sustainedCount > 0)
+    {
+        printf("     - 60 fps sustained up to %d particles\n", sustainedCount);
+    }
+    else
+    {
+        printf("     - 60 fps not sustained with %d particles\n", counts[0]);
+    }
+
+    Camera_destroy(camera);
+    ParticleSystem_destroy(particles);
+}
+
+static double Benchmark_blitFrames(
+    SpriteBatch *batch, SoftBlitter *blitter, SpriteSheet *spriteSheet,
+    const BenchmarkBlitScene *scene, BenchmarkSprite *sprites, int count)
+{
+    // Taille des images d'origine, avant la rotation intégrée
+    SDL_Rect rect = spriteSheet->rects[0];
+    bool swap = (spriteSheet->orientation == SPRITE_ORIENTATION_90 ||
+        spriteSheet->orientation == SPRITE_ORIENTATION_270);
+    float spriteW = scene->scale * (float)(swap ? rect.h : rect.w);
+    float spriteH = scene->scale * (float)(swap ? rect.w : rect.h);
+    const float w = (float)Game_getWidth() - spriteW;
+    const float h = (float)Game_getHeight() - spriteH;
+    const SDL_Color background = { 37, 37, 37, 255 };
+    Uint64 ticks = 0;
+
+    SpriteBatch_setSoftBlitter(batch, blitter);
+    SpriteSheet_setOpacity(spriteSheet, scene->alpha);
+    Benchmark_resetSprites(sprites, count);
+    for (int frame = 0; frame < BENCHMARK_BLITTER_FRAMES; frame++)
+    {
+        // Seul le dessin est mesuré, y compris l'envoi de l'image logicielle
+        Uint64 start = SDL_GetPerformanceCounter();
+        if (blitter)
+        {
+            SoftBlitter_clear(blitter, background);
+        }
+        else
+        {
+            RenderState_setDrawColor(g_renderState, background.r, background.g, background.b, 255);
+            SDL_RenderClear(g_renderer);
+        }
+
+        SpriteBatch_begin(batch);
+        for (int i = 0; i < count; i++)
+        {
+            BenchmarkSprite *sprite = sprites + i;
+            sprite->x += sprite->vx;
+            sprite->y += sprite->vy;
+            if (sprite->x < 0.f || sprite->x > w) sprite->vx = -sprite->vx;
+            if (sprite->y < 0.f || sprite->y > h) sprite->vy = -sprite->vy;
+
+            // Sans rotation, l'angle est celui intégré à la sprite sheet
+            double angle = (double)spriteSheet->orientation;
+            SDL_RendererFlip flip = SDL_FLIP_NONE;
+            if (scene->rotate)
+            {
+                angle += 90.0 * (i % 4);
+                flip = (i % 3 == 0) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+            }
+
+            SDL_FRect dst = { sprite->x, sprite->y, spriteW, spriteH };
+            SpriteBatch_drawSprite(batch, spriteSheet, i + frame, &dst, angle, flip);
+        }
+        SpriteBatch_end(batch);
+
+        if (blitter)
+        {
+            SoftBlitter_upload(blitter);
+        }
+        SDL_RenderFlush(g_renderer);
+        ticks += SDL_GetPerformanceCounter() - start;
+
+        SDL_RenderPresent(g_renderer);
+        RenderState_endFrame(g_renderState);
+    }
+    SpriteSheet_setOpacity(spriteSheet, 255);
+    SpriteBatch_setSoftBlitter(batch, NULL);
+
+    return Benchmark_getMicroseconds(0, ticks, BENCHMARK_BLITTER_FRAMES) / 1000.0;
+}
+
+static void Benchmark_blitter()
+{
+    SoftBlitter *blitter = SoftBlitter_create(g_renderer, Game_getWidth(), Game_getHeight());
+    if (blitter == NULL)
+    {
+        printf("ERROR - Software blitter benchmark needs a streaming texture\n");
+        return;
+    }
+
+    // Les deux moteurs utilisent les mêmes sprite sheets et le même atlas
+    AssetManager *assets = AssetManager_create(
+        SPRITE_COUNT, FONT_COUNT, SOUND_COUNT, MUSIC_COUNT);
+    Game_addAssets(assets);
+    AssetManager_setKeepImages(assets, true);
+    AssetManager_buildAtlas(assets);
+
+    SpriteBatch *batch = SpriteBatch_create(g_renderer);
+    BenchmarkSprite *sprites = (BenchmarkSprite *)calloc(
+        SPRITE_BATCH_CAPACITY, sizeof(BenchmarkSprite));
+    AssertNew(sprites);
+
+    SpriteSheet *spriteSheet = AssetManager_getSpriteSheet(assets, SPRITE_FIGHTER_FIRING);
+    const BenchmarkBlitScene scenes[] = {
+        { "copy", 1.0f, false, 255 },
+        { "scaled", 1.5f, false, 255 },
+        { "rotated", 1.0f, true, 255 },
+        { "faded", 1.0f, false, 160 },
+    };
+    const int sceneCount = sizeof(scenes) / sizeof(scenes[0]);
+    const int counts[] = { 128, 512, SPRITE_BATCH_CAPACITY };
+    const int countCount = sizeof(counts) / sizeof(counts[0]);
+
+    SDL_RendererInfo info = { 0 };
+    SDL_GetRendererInfo(g_renderer, &info);
+    SoftBlitter_setSIMD(blitter, true);
+    bool hasSIMD = blitter->m_useSIMD;
+
+    printf("INFO - Software blitter benchmark (%d frames of %dx%d, %s renderer, %s)\n",
+        BENCHMARK_BLITTER_FRAMES, Game_getWidth(), Game_getHeight(),
+        info.name, hasSIMD ? "SIMD" : "scalar only");
+    for (int i = 0; i < sceneCount; i++)
+    {
+        for (int j = 0; j < countCount; j++)
+        {
+            double sdlMS = Benchmark_blitFrames(
+                batch, NULL, spriteSheet, scenes + i, sprites, counts[j]);
+
+            SoftBlitter_setSIMD(blitter, true);
+            double simdMS = Benchmark_blitFrames(
+                batch, blitter, spriteSheet, scenes + i, sprites, counts[j]);
+
+            SoftBlitter_setSIMD(blitter, false);
+            double scalarMS = Benchmark_blitFrames(
+                batch, blitter, spriteSheet, scenes + i, sprites, counts[j]);
+
+            printf("     - %-7s %4d sprites: SDL %.3f ms, blitter %.3f ms (x%.2f), "
+                "scalar %.3f ms (x%.2f)\n",
+                scenes[i].name, counts[j], sdlMS, simdMS,
+                simdMS > 0.0 ? sdlMS / simdMS : 0.0,
+                scalarMS, simdMS > 0.0 ? scalarMS / simdMS : 0.0);
+        }
+    }
+
+    free(sprites);
+    SpriteBatch_destroy(batch);
+    AssetManager_destroy(assets);
+    SoftBlitter_destroy(blitter);
+}
+
+void Benchmark_run(GameConfig *gameConfig)
+{
+    assert(gameConfig);
+    switch (gameConfig->benchmark)
+    {
+    case BENCHMARK_LEVEL_STATE:
+        Benchmark_levelState(gameConfig);
+        break;
+    case BENCHMARK_DIRTY_RECTS:
+        Benchmark_dirtyRects(gameConfig);
+        break;
+    case BENCHMARK_PARTICLES:
+        Benchmark_particles();
+        break;
+    case BENCHMARK_BLITTER:
+        Benchmark_blitter();
+        break;
+    case BENCHMARK_NONE:
+    default:
+        break;
+    }
+}
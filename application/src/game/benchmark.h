@@ -0,0 +1,16 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+#include "game/game_common.h"
+
+/// @brief Exécute la mesure de performances demandée par la configuration
+/// du jeu (membre benchmark) et affiche les résultats.
+/// Le moteur de rendu doit avoir été créé.
+/// @param gameConfig la configuration globale du jeu.
+void Benchmark_run(GameConfig *gameConfig);
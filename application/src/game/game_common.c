@@ -30,15 +30,18 @@ void Game_addAssets(AssetManager *assets)
     /* TODO : Affichage du joueur
     AssetManager_addSpriteSheet(
         assets, SPRITE_PLAYER,
-        ASSETS_PATH, "player/player.png", 1, 48, 48
+        ASSETS_PATH, "player/player.png", 1, 48, 48,
+        SPRITE_ORIENTATION_90
     );
     AssetManager_addSpriteSheet(
         assets, SPRITE_PLAYER_ENGINE,
-        ASSETS_PATH, "player/engine.png", 1, 48, 48
+        ASSETS_PATH, "player/engine.png", 1, 48, 48,
+        SPRITE_ORIENTATION_90
     );
     AssetManager_addSpriteSheet(
         assets, SPRITE_PLAYER_POWERING,
-        ASSETS_PATH, "player/engine_powering.png", 4, 48, 48
+        ASSETS_PATH, "player/engine_powering.png", 4, 48, 48,
+        SPRITE_ORIENTATION_90
     );
     //*/
 
@@ -46,13 +49,15 @@ void Game_addAssets(AssetManager *assets)
     /* TODO : Tir du joueur
     AssetManager_addSpriteSheet(
         assets, SPRITE_BULLET_PLAYER_DEFAULT,
-        ASSETS_PATH, "player/bullet_default.png", 4, 8, 16
+        ASSETS_PATH, "player/bullet_default.png", 4, 8, 16,
+        SPRITE_ORIENTATION_90
     );
     //*/
     /* TODO : Tir d'un ennemi
     AssetManager_addSpriteSheet(
         assets, SPRITE_BULLET_FIGHTER,
-        ASSETS_PATH, "enemy/fighter_bullet.png", 4, 4, 16
+        ASSETS_PATH, "enemy/fighter_bullet.png", 4, 4, 16,
+        SPRITE_ORIENTATION_270
     );
     //*/
 
@@ -60,22 +65,26 @@ void Game_addAssets(AssetManager *assets)
     /* TODO : Affichage d'un ennemi
     AssetManager_addSpriteSheet(
         assets, SPRITE_FIGHTER_FIRING,
-        ASSETS_PATH, "enemy/fighter_firing.png", 6, 64, 64
+        ASSETS_PATH, "enemy/fighter_firing.png", 6, 64, 64,
+        SPRITE_ORIENTATION_270
     );
     AssetManager_addSpriteSheet(
         assets, SPRITE_FIGHTER_DYING,
-        ASSETS_PATH, "enemy/fighter_dying.png", 9, 64, 64
+        ASSETS_PATH, "enemy/fighter_dying.png", 9, 64, 64,
+        SPRITE_ORIENTATION_270
     );
     //*/
 
     // Background
     AssetManager_addSpriteSheet(
         assets, SPRITE_BACKGROUND_BLUE_NEBULA,
-        ASSETS_PATH, "background/blue_nebula.png", 1, 1024, 1024
+        ASSETS_PATH, "background/blue_nebula.png", 1, 1024, 1024,
+        SPRITE_ORIENTATION_0
     );
     AssetManager_addSpriteSheet(
         assets, SPRITE_BACKGROUND_PURPLE_NEBULA,
-        ASSETS_PATH, "background/purple_nebula.png", 1, 1024, 1024
+        ASSETS_PATH, "background/purple_nebula.png", 1, 1024, 1024,
+        SPRITE_ORIENTATION_0
     );
 
     // -------------------------------------------------------------------------
@@ -144,3 +153,21 @@ void Game_addAssets(AssetManager *assets)
         assets, FONT_MAIN_TITLE, ASSETS_PATH, "font/futile_pro.ttf", 96
     );
 }
+
+float Game_getSpriteScale(GameConfig *gameConfig, float worldToViewScale)
+{
+    assert(gameConfig);
+    if (gameConfig->spriteScaleMode == SPRITE_SCALE_NONE)
+        return 1.f;
+
+    // Agrandissement du rendu logique vers la sortie (bandes noires comprises)
+    float scaleX = 1.f, scaleY = 1.f;
+    SDL_RenderGetScale(g_renderer, &scaleX, &scaleY);
+    float scale = PIX_TO_WORLD * worldToViewScale * fminf(scaleX, scaleY);
+
+    if (gameConfig->spriteScaleMode == SPRITE_SCALE_INTEGER)
+    {
+        scale = fmaxf(1.f, floorf(scale + 1e-3f));
+    }
+    return fmaxf(scale, 1.f);
+}
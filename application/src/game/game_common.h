@@ -37,11 +37,96 @@ typedef enum GameScene
     GAME_SCENE_QUIT
 } GameScene;
 
+typedef enum BenchmarkID
+{
+    BENCHMARK_NONE,
+    BENCHMARK_LEVEL_STATE,
+    BENCHMARK_DIRTY_RECTS,
+    BENCHMARK_PARTICLES,
+    BENCHMARK_BLITTER,
+} BenchmarkID;
+
+/// @brief Modes d'agrandissement des sprite sheets au chargement.
+typedef enum SpriteScaleMode
+{
+    /// @brief Images d'origine, mises à l'échelle lors du dessin.
+    SPRITE_SCALE_NONE,
+
+    /// @brief Images agrandies d'un facteur entier, le reste de la mise à
+    /// l'échelle est fait lors du dessin.
+    SPRITE_SCALE_INTEGER,
+
+    /// @brief Images agrandies au plus proche voisin à la taille exacte
+    /// de l'affichage, les dessins sont des copies pixel à pixel.
+    SPRITE_SCALE_EXACT,
+} SpriteScaleMode;
+
 typedef struct GameConfig
 {
     int playerCount;
     int nextScene;
     int levelID;
+
+    /// @brief Booléen indiquant si la simulation d'un niveau s'exécute
+    /// dans un thread séparé du rendu.
+    bool threadedSimulation;
+
+    /// @brief Booléen indiquant si l'avance rapide est active au lancement
+    /// d'un niveau. Elle peut aussi être basculée avec la touche Tab.
+    bool fastForward;
+
+    /// @brief Nombre de pas de simulation par image en avance rapide.
+    int fastForwardTicks;
+
+    /// @brief Booléen indiquant si un niveau est simulé sans rendu ni attente.
+    bool headless;
+
+    /// @brief Nombre maximal de pas de simulation d'un niveau
+    /// (0 pour ne pas limiter).
+    Uint64 maxTicks;
+
+    /// @brief Booléen indiquant si l'historique permettant de revenir en
+    /// arrière dans un niveau est enregistré (touche R).
+    bool rewind;
+
+    /// @brief Booléen indiquant si seules les zones modifiées de l'écran
+    /// sont redessinées. Ce mode nécessite le moteur de rendu logiciel,
+    /// qui conserve le contenu de l'écran d'une image à l'autre.
+    bool dirtyRects;
+
+    /// @brief Booléen indiquant si les sprites des niveaux sont dessinés
+    /// par le SoftBlitter dans une image en mémoire centrale.
+    bool softBlitter;
+
+    /// @brief Mesure de performances à exécuter à la place du jeu.
+    /// Les valeurs possibles sont données dans BenchmarkID.
+    int benchmark;
+
+    /// @brief Dossier des images de référence du test de rendu, ou NULL
+    /// pour lancer le jeu normalement.
+    const char *goldenDir;
+
+    /// @brief Booléen indiquant si le test de rendu remplace les images de
+    /// référence au lieu de les comparer.
+    bool goldenUpdate;
+
+    /// @brief Mode d'agrandissement des sprite sheets au chargement
+    /// (SpriteScaleMode).
+    int spriteScaleMode;
+
+    /// @brief Nom du pilote de rendu imposé, ou NULL pour utiliser celui
+    /// enregistré par la mesure des pilotes.
+    const char *renderer;
+
+    /// @brief Booléen indiquant si les pilotes de rendu sont mesurés au
+    /// démarrage, même si un choix est déjà enregistré.
+    bool rendererBenchmark;
+
+    /// @brief Facteurs minimal et maximal de la résolution dynamique du
+    /// rendu des niveaux. La résolution dynamique est désactivée si le
+    /// facteur minimal est nul.
+    float dynamicResMin;
+    float dynamicResMax;
 } GameConfig;
 
 typedef enum SceneState
@@ -120,3 +205,13 @@ typedef enum MusicID
 } MusicID;
 
 void Game_addAssets(AssetManager *assets);
+
+/// @brief Renvoie le facteur d'agrandissement à appliquer aux sprite sheets
+/// pour que leurs pixels soient copiés un pour un sur la sortie du moteur
+/// de rendu, selon le mode choisi dans la configuration.
+/// Les sprites sont dessinés à PIX_TO_WORLD unités monde par pixel d'image,
+/// puis le rendu logique est agrandi à la taille de la fenêtre.
+/// @param gameConfig la configuration globale du jeu.
+/// @param worldToViewScale le facteur d'échelle monde vers vue de la caméra.
+/// @return Le facteur d'agrandissement (1 pour les images d'origine).
+float Game_getSpriteScale(GameConfig *gameConfig, float worldToViewScale);
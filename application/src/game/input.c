@@ -10,6 +10,10 @@
 
 #define TRIGGER_MAX_VALUE 32767
 
+/// @brief Délai maximal entre deux lectures des événements lorsque la
+/// fenêtre est minimisée (en millisecondes).
+#define INPUT_MINIMIZED_WAIT_MS 500
+
 void PlayerInput_setTriggerL(PlayerInput *playerInput, Sint16 value)
 {
     float trigger = Float_clamp((float)value / 32767.f, -1.f, 1.f);
@@ -45,6 +49,14 @@ Input *Input_create()
         AxisData_init(&(self->players[i].axisLeftData), 0.3f);
     }
 
+    self->windowFocused = true;
+    if (g_window)
+    {
+        Uint32 flags = SDL_GetWindowFlags(g_window);
+        self->windowMinimized = (flags & SDL_WINDOW_MINIMIZED) != 0;
+        self->windowFocused = (flags & SDL_WINDOW_INPUT_FOCUS) != 0;
+    }
+
     return self;
 }
 
@@ -54,18 +66,19 @@ void Input_destroy(Input *self)
     free(self);
 }
 
-void Input_update(Input *self)
+void Input_resetPressed(Input *self)
 {
     assert(self);
-    PlayerInput *playerInput = &(self->players[0]);
-    AxisData *axisLeftData = &(playerInput->axisLeftData);
-    SDL_GameController *controller = NULL;
-    int playerID = 0;
+    PlayerInput *playerInput = NULL;
 
     self->quitPressed = false;
     self->cancelPressed = false;
     self->validatePressed = false;
     self->pausePressed = false;
+    self->fastForwardPressed = false;
+    self->windowRestoredPressed = false;
+    self->windowExposedPressed = false;
+    self->renderTargetsResetPressed = false;
 
     self->upPressed = false;
     self->downPressed = false;
@@ -88,6 +101,63 @@ void Input_update(Input *self)
         playerInput->leftPressed = false;
         playerInput->rightPressed = false;
     }
+}
+
+void Input_accumulate(Input *self, const Input *src)
+{
+    assert(self && src);
+
+    self->quitPressed |= src->quitPressed;
+    self->cancelPressed |= src->cancelPressed;
+    self->validatePressed |= src->validatePressed;
+    self->pausePressed |= src->pausePressed;
+    self->fastForwardPressed |= src->fastForwardPressed;
+    self->rewindDown = src->rewindDown;
+    self->windowMinimized = src->windowMinimized;
+    self->windowFocused = src->windowFocused;
+    self->windowRestoredPressed |= src->windowRestoredPressed;
+    self->windowExposedPressed |= src->windowExposedPressed;
+    self->renderTargetsResetPressed |= src->renderTargetsResetPressed;
+
+    self->upPressed |= src->upPressed;
+    self->downPressed |= src->downPressed;
+    self->leftPressed |= src->leftPressed;
+    self->rightPressed |= src->rightPressed;
+
+    for (int i = 0; i < MAX_PLAYER_COUNT; i++)
+    {
+        PlayerInput *dst = &(self->players[i]);
+        const PlayerInput *playerInput = &(src->players[i]);
+
+        AxisData_accumulate(&(dst->axisLeftData), &(playerInput->axisLeftData));
+
+        dst->axis = playerInput->axis;
+        dst->triggerL = playerInput->triggerL;
+        dst->triggerR = playerInput->triggerR;
+        dst->shootDown = playerInput->shootDown;
+
+        dst->shootPressed |= playerInput->shootPressed;
+
+        dst->validatePressed |= playerInput->validatePressed;
+        dst->cancelPressed |= playerInput->cancelPressed;
+        dst->pausePressed |= playerInput->pausePressed;
+
+        dst->upPressed |= playerInput->upPressed;
+        dst->downPressed |= playerInput->downPressed;
+        dst->leftPressed |= playerInput->leftPressed;
+        dst->rightPressed |= playerInput->rightPressed;
+    }
+}
+
+void Input_update(Input *self)
+{
+    assert(self);
+    PlayerInput *playerInput = &(self->players[0]);
+    AxisData *axisLeftData = &(playerInput->axisLeftData);
+    SDL_GameController *controller = NULL;
+    int playerID = 0;
+
+    Input_resetPressed(self);
 
     SDL_Event evt = { 0 };
     while (SDL_PollEvent(&evt))
@@ -98,6 +168,15 @@ void Input_update(Input *self)
             self->quitPressed = true;
             break;
 
+        case SDL_WINDOWEVENT:
+            Input_updateWindowEvent(self, evt.window.event);
+            break;
+
+        case SDL_RENDER_TARGETS_RESET:
+        case SDL_RENDER_DEVICE_RESET:
+            self->renderTargetsResetPressed = true;
+            break;
+
         case SDL_CONTROLLERBUTTONDOWN:
             controller = SDL_GameControllerFromInstanceID(evt.cbutton.which);
             playerID = SDL_GameControllerGetPlayerIndex(controller);
@@ -156,6 +235,48 @@ void Input_update(Input *self)
     }
 }
 
+bool Input_waitWhileMinimized(Input *self)
+{
+    assert(self);
+    if (self->windowMinimized == false)
+        return false;
+
+    while (self->windowMinimized && (self->quitPressed == false))
+    {
+        SDL_WaitEventTimeout(NULL, INPUT_MINIMIZED_WAIT_MS);
+        Input_update(self);
+    }
+    return true;
+}
+
+void Input_updateWindowEvent(Input *self, int event)
+{
+    switch (event)
+    {
+    case SDL_WINDOWEVENT_MINIMIZED:
+    case SDL_WINDOWEVENT_HIDDEN:
+        self->windowMinimized = true;
+        break;
+    case SDL_WINDOWEVENT_RESTORED:
+    case SDL_WINDOWEVENT_MAXIMIZED:
+    case SDL_WINDOWEVENT_SHOWN:
+        if (self->windowMinimized) self->windowRestoredPressed = true;
+        self->windowMinimized = false;
+        break;
+    case SDL_WINDOWEVENT_EXPOSED:
+    case SDL_WINDOWEVENT_SIZE_CHANGED:
+        self->windowExposedPressed = true;
+        break;
+    case SDL_WINDOWEVENT_FOCUS_GAINED:
+        self->windowFocused = true;
+        break;
+    case SDL_WINDOWEVENT_FOCUS_LOST:
+        self->windowFocused = false;
+        break;
+    default: break;
+    }
+}
+
 void Input_updateControllerButtonDown(Input *self, PlayerInput *playerInput, int button)
 {
     AxisData *axisLeftData = &(playerInput->axisLeftData);
@@ -172,6 +293,9 @@ void Input_updateControllerButtonDown(Input *self, PlayerInput *playerInput, int
     case SDL_CONTROLLER_BUTTON_START:
         playerInput->pausePressed = true;
         break;
+    case SDL_CONTROLLER_BUTTON_LEFTSHOULDER:
+        self->rewindDown = true;
+        break;
     case SDL_CONTROLLER_BUTTON_DPAD_UP:
         AxisData_setDirectionUp(axisLeftData, true);
         break;
@@ -196,6 +320,9 @@ void Input_updateControllerButtonUp(Input *self, PlayerInput *playerInput, int b
     case SDL_CONTROLLER_BUTTON_A:
         playerInput->shootDown = false;
         break;
+    case SDL_CONTROLLER_BUTTON_LEFTSHOULDER:
+        self->rewindDown = false;
+        break;
     case SDL_CONTROLLER_BUTTON_DPAD_UP:
         AxisData_setDirectionUp(axisLeftData, false);
         break;
@@ -276,6 +403,12 @@ void Input_updateKeyDown(Input *self, PlayerInput *playerInput, bool repeat, int
     case SDL_SCANCODE_BACKSPACE:
         playerInput->cancelPressed = true;
         break;
+    case SDL_SCANCODE_TAB:
+        self->fastForwardPressed = true;
+        break;
+    case SDL_SCANCODE_R:
+        self->rewindDown = true;
+        break;
     default: break;
     }
 }
@@ -308,6 +441,9 @@ void Input_updateKeyUp(Input *self, PlayerInput *playerInput, bool repeat, int s
     case SDL_SCANCODE_SPACE:
         PlayerInput_setTriggerR(playerInput, 0);
         break;
+    case SDL_SCANCODE_R:
+        self->rewindDown = false;
+        break;
     default: break;
     }
 }
@@ -51,6 +51,29 @@ typedef struct Input
     bool cancelPressed;
     bool pausePressed;
 
+    /// @brief Booléen indiquant si le bouton "avance rapide" vient d'être pressé.
+    bool fastForwardPressed;
+
+    /// @brief Booléen indiquant si le bouton "retour arrière" est maintenu.
+    bool rewindDown;
+
+    /// @brief Booléen indiquant si la fenêtre est minimisée ou cachée.
+    bool windowMinimized;
+
+    /// @brief Booléen indiquant si la fenêtre a le focus clavier.
+    bool windowFocused;
+
+    /// @brief Booléen indiquant si la fenêtre vient d'être restaurée.
+    bool windowRestoredPressed;
+
+    /// @brief Booléen indiquant si le contenu de la fenêtre doit être
+    /// redessiné (fenêtre découverte ou redimensionnée).
+    bool windowExposedPressed;
+
+    /// @brief Booléen indiquant si le contenu des cibles de rendu
+    /// vient d'être perdu (SDL_RENDER_TARGETS_RESET).
+    bool renderTargetsResetPressed;
+
     PlayerInput players[MAX_PLAYER_COUNT];
 } Input;
 
@@ -67,6 +90,27 @@ void Input_destroy(Input *self);
 /// @param self le gestionnaire.
 void Input_update(Input *self);
 
+/// @brief Réinitialise les booléens "vient d'être pressé" du gestionnaire.
+/// @param self le gestionnaire.
+void Input_resetPressed(Input *self);
+
+/// @brief Cumule l'état d'un gestionnaire dans un autre.
+/// Les états continus (axes, boutons maintenus) sont copiés et les booléens
+/// "vient d'être pressé" sont conservés jusqu'au prochain Input_resetPressed().
+/// Cela permet de transmettre les entrées à un thread qui ne les lit pas
+/// au même rythme.
+/// @param self le gestionnaire destination.
+/// @param src le gestionnaire source.
+void Input_accumulate(Input *self, const Input *src);
+
+/// @brief Bloque tant que la fenêtre est minimisée.
+/// Les événements sont lus au plus tous les INPUT_MINIMIZED_WAIT_MS
+/// millisecondes. L'attente s'arrête aussi si "quitter" est pressé.
+/// @param self le gestionnaire.
+/// @return true si la fenêtre était minimisée, false sinon.
+bool Input_waitWhileMinimized(Input *self);
+
+void Input_updateWindowEvent(Input *self, int event);
 void Input_updateControllerButtonDown(Input *self, PlayerInput *playerInput, int button);
 void Input_updateControllerButtonUp(Input *self, PlayerInput *playerInput, int button);
 void Input_updateControllerAxisMotion(Input *self, PlayerInput *playerInput, int axis, Sint16 value);
@@ -63,7 +63,7 @@ void Bullet_update(Bullet *self)
     // if (self->m_anim) SpriteAnim_update(self->m_anim, delta);
 }
 
-void Bullet_render(Bullet *self)
+void Bullet_render(Bullet *self, RenderSnapshot *snapshot)
 {
     assert(self);
     LevelScene *scene = self->m_scene;
@@ -78,17 +78,14 @@ void Bullet_render(Bullet *self)
     dst.x -= 0.50f * dst.w;
     dst.y -= 0.50f * dst.h;
 
-    SDL_Rect *src = NULL;
-    SDL_Texture *texture = NULL;
-    SpriteSheet *spriteSheet = NULL;
     int index = 0;
 
+    // Le sprite est ajouté au snapshot par le code à compléter
+    (void)snapshot;
+
     /* TODO : Tir du joueur
-    spriteSheet = self->m_spriteSheet;
     index = 0;//SpriteAnim_getFrameIndex(self->m_anim);
-    src = &(spriteSheet->rects[index]);
-    texture = spriteSheet->texture;
-    SDL_RenderCopyExF(g_renderer, texture, src, &dst, self->m_angle, NULL, 0);
+    RenderSnapshot_addSprite(snapshot, SPRITE_BULLET_PLAYER_DEFAULT, index, &dst, self->m_angle, 0);
     //*/
 }
 
@@ -96,3 +93,43 @@ void Bullet_drawGizmos(Bullet *self, Gizmos *gizmos)
 {
     Gizmos_drawCircle(gizmos, self->m_position, self->m_radius);
 }
+
+void Bullet_save(Bullet *self, BulletRecord *record)
+{
+    assert(self && record);
+    record->position = self->m_position;
+    record->velocity = self->m_velocity;
+    record->extent = self->m_extent;
+    record->radius = self->m_radius;
+    record->angle = self->m_angle;
+    record->playerID = self->m_playerID;
+    record->type = self->m_type;
+    record->state = self->m_state;
+    record->damage = self->m_damage;
+    // if (self->m_anim) record->anim = *(self->m_anim);
+}
+
+void Bullet_restore(Bullet *self, const BulletRecord *record)
+{
+    assert(self && record);
+    self->m_position = record->position;
+    self->m_velocity = record->velocity;
+    self->m_extent = record->extent;
+    self->m_radius = record->radius;
+    self->m_angle = record->angle;
+    self->m_playerID = record->playerID;
+    self->m_type = record->type;
+    self->m_state = record->state;
+    self->m_damage = record->damage;
+    // if (self->m_anim) *(self->m_anim) = record->anim;
+}
+
+Bullet *Bullet_createFromRecord(LevelScene *scene, const BulletRecord *record)
+{
+    assert(record);
+    Bullet *self = Bullet_create(
+        scene, record->position, record->velocity,
+        record->type, record->angle, record->damage, record->playerID);
+    Bullet_restore(self, record);
+    return self;
+}
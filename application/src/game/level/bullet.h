@@ -11,6 +11,7 @@
 #include "utils/sprite_anim.h"
 #include "utils/gizmos.h"
 #include "game/game_common.h"
+#include "game/level/render_snapshot.h"
 
 typedef struct LevelScene LevelScene;
 
@@ -69,15 +70,35 @@ typedef struct Bullet
     // SpriteAnim *m_anim;
 } Bullet;
 
+/// @brief Etat d'un projectile sans pointeur, utilisé pour la sauvegarde
+/// de la scène. La sprite sheet est déduite du type.
+typedef struct BulletRecord
+{
+    Vec2 position;
+    Vec2 velocity;
+    Vec2 extent;
+    float radius;
+    float angle;
+    int playerID;
+    int type;
+    int state;
+    int damage;
+    // SpriteAnim anim;
+} BulletRecord;
+
 Bullet *Bullet_create(
     LevelScene *scene, Vec2 position, Vec2 velocity,
     int type, float angle, int damage, int playerID);
 void Bullet_destroy(Bullet *self);
 void Bullet_update(Bullet *self);
 
-void Bullet_render(Bullet *self);
+void Bullet_render(Bullet *self, RenderSnapshot *snapshot);
 void Bullet_drawGizmos(Bullet *self, Gizmos *gizmos);
 
+void Bullet_save(Bullet *self, BulletRecord *record);
+void Bullet_restore(Bullet *self, const BulletRecord *record);
+Bullet *Bullet_createFromRecord(LevelScene *scene, const BulletRecord *record);
+
 INLINE void Bullet_setState(Bullet *self, int state)
 {
     self->m_state = state;
@@ -26,6 +26,10 @@ Enemy *Enemy_create(LevelScene *scene, int type, Vec2 position)
         self->m_extent = Vec2_set(64 * PIX_TO_WORLD, 64 * PIX_TO_WORLD);
         self->m_radius = 1.25f;
 
+        self->m_engineEmitter.effect = PARTICLE_EFFECT_FIGHTER_ENGINE;
+        self->m_engineEmitter.offset = Vec2_set(0.6f, 0.f);
+        self->m_engineEmitter.rate = 60.f;
+
         /* TODO : Affichage d'un ennemi
         self->m_firingSpriteSheet = AssetManager_getSpriteSheet(assets, SPRITE_FIGHTER_FIRING);
         self->m_firingAnim = SpriteAnim_create(self->m_firingSpriteSheet->rectCount, 1.5f, -1);
@@ -56,6 +60,14 @@ void Enemy_update(Enemy *self)
     float shootTime = 2.0f;
     float delta = Timer_getDelta(g_time);
 
+    // Explosion au passage dans l'état ENEMY_STATE_DYING,
+    // quel que soit le code qui a vaincu l'ennemi
+    if (self->m_state == ENEMY_STATE_DYING && self->m_exploded == false)
+    {
+        self->m_exploded = true;
+        LevelScene_addExplosion(scene, self->m_position);
+    }
+
     /* TODO : Affichage d'un ennemi
     if (self->m_state == ENEMY_STATE_FIRING)
     {
@@ -114,14 +126,11 @@ void Enemy_updateFigther(Enemy *self)
     //*/
 }
 
-void Enemy_render(Enemy *self)
+void Enemy_render(Enemy *self, RenderSnapshot *snapshot)
 {
     LevelScene *scene = self->m_scene;
     AssetManager *assets = LevelScene_getAssetManager(scene);
     Camera *camera = LevelScene_getCamera(scene);
-    SDL_Rect *src = NULL;
-    SDL_Texture *texture = NULL;
-    SpriteSheet *spriteSheet = NULL;
     int index = 0;
 
     float scale = Camera_getWorldToViewScale(camera);
@@ -132,23 +141,23 @@ void Enemy_render(Enemy *self)
     dst.x -= 0.50f * dst.w;
     dst.y -= 0.50f * dst.h;
 
+    if ((self->m_state == ENEMY_STATE_FIRING) ||
+        (self->m_state == ENEMY_STATE_SHOWING))
+    {
+        RenderSnapshot_addEmitter(snapshot, &(self->m_engineEmitter), self->m_position, Vec2_zero);
+    }
+
     /* TODO : Affichage d'un ennemi
     if ((self->m_state == ENEMY_STATE_FIRING) ||
         (self->m_state == ENEMY_STATE_SHOWING))
     {
-        spriteSheet = self->m_firingSpriteSheet;
         index = SpriteAnim_getFrameIndex(self->m_firingAnim);
-        src = &(spriteSheet->rects[index]);
-        texture = spriteSheet->texture;
-        SDL_RenderCopyExF(g_renderer, texture, src, &dst, -90.0, NULL, 0);
+        RenderSnapshot_addSprite(snapshot, SPRITE_FIGHTER_FIRING, index, &dst, -90.0, 0);
     }
     else if (self->m_state == ENEMY_STATE_DYING)
     {
-        spriteSheet = self->m_dyingSpriteSheet;
         index = SpriteAnim_getFrameIndex(self->m_dyingAnim);
-        src = &(spriteSheet->rects[index]);
-        texture = spriteSheet->texture;
-        SDL_RenderCopyExF(g_renderer, texture, src, &dst, -90.0, NULL, 0);
+        RenderSnapshot_addSprite(snapshot, SPRITE_FIGHTER_DYING, index, &dst, -90.0, 0);
     }
     //*/
 }
@@ -184,3 +193,45 @@ void Enemy_drawGizmos(Enemy *self, Gizmos *gizmos)
 {
     Gizmos_drawCircle(gizmos, self->m_position, self->m_radius);
 }
+
+void Enemy_save(Enemy *self, EnemyRecord *record)
+{
+    assert(self && record);
+    record->position = self->m_position;
+    record->extent = self->m_extent;
+    record->radius = self->m_radius;
+    record->type = self->m_type;
+    record->state = self->m_state;
+    record->hp = self->m_hp;
+    record->exploded = self->m_exploded;
+
+    /* TODO : Affichage d'un ennemi
+    record->firingAnim = *(self->m_firingAnim);
+    record->dyingAnim = *(self->m_dyingAnim);
+    //*/
+}
+
+void Enemy_restore(Enemy *self, const EnemyRecord *record)
+{
+    assert(self && record);
+    self->m_position = record->position;
+    self->m_extent = record->extent;
+    self->m_radius = record->radius;
+    self->m_type = record->type;
+    self->m_state = record->state;
+    self->m_hp = record->hp;
+    self->m_exploded = record->exploded;
+
+    /* TODO : Affichage d'un ennemi
+    *(self->m_firingAnim) = record->firingAnim;
+    *(self->m_dyingAnim) = record->dyingAnim;
+    //*/
+}
+
+Enemy *Enemy_createFromRecord(LevelScene *scene, const EnemyRecord *record)
+{
+    assert(record);
+    Enemy *self = Enemy_create(scene, record->type, record->position);
+    Enemy_restore(self, record);
+    return self;
+}
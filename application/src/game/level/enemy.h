@@ -11,6 +11,7 @@
 #include "utils/sprite_anim.h"
 #include "utils/gizmos.h"
 #include "game/game_common.h"
+#include "game/level/render_snapshot.h"
 
 typedef struct LevelScene LevelScene;
 
@@ -55,6 +56,12 @@ typedef struct Enemy
     /// @brief Points de vie de l'ennemi.
     int m_hp;
 
+    /// @brief Traînée de particules des réacteurs.
+    ParticleEmitter m_engineEmitter;
+
+    /// @brief Booléen indiquant si l'explosion de l'ennemi a été émise.
+    bool m_exploded;
+
     /// @brief Sprite sheet associée à l'attaque.
     //SpriteSheet *m_firingSpriteSheet;
 
@@ -68,16 +75,35 @@ typedef struct Enemy
     //SpriteAnim *m_dyingAnim;
 } Enemy;
 
+/// @brief Etat d'un ennemi sans pointeur, utilisé pour la sauvegarde
+/// de la scène. Les sprite sheets sont déduites du type.
+typedef struct EnemyRecord
+{
+    Vec2 position;
+    Vec2 extent;
+    float radius;
+    int type;
+    int state;
+    int hp;
+    bool exploded;
+    SpriteAnim firingAnim;
+    SpriteAnim dyingAnim;
+} EnemyRecord;
+
 Enemy *Enemy_create(LevelScene *scene, int type, Vec2 position);
 void Enemy_destroy(Enemy *self);
 
 void Enemy_update(Enemy *self);
-void Enemy_render(Enemy *self);
+void Enemy_render(Enemy *self, RenderSnapshot *snapshot);
 int Enemy_damage(Enemy *self, int damage);
 void Enemy_drawGizmos(Enemy *self, Gizmos *gizmos);
 
 void Enemy_updateFigther(Enemy *self);
 
+void Enemy_save(Enemy *self, EnemyRecord *record);
+void Enemy_restore(Enemy *self, const EnemyRecord *record);
+Enemy *Enemy_createFromRecord(LevelScene *scene, const EnemyRecord *record);
+
 INLINE bool Enemy_shouldBeDestroyed(Enemy *self)
 {
     return (self->m_state == ENEMY_STATE_DEAD);
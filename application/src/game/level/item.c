@@ -39,11 +39,13 @@ void Item_update(Item *self)
 {
     LevelScene *scene = self->m_scene;
     float delta = Timer_getDelta(g_time);
-    SpriteAnim_update(self->m_anim, delta);
+    if (self->m_anim) SpriteAnim_update(self->m_anim, delta);
 }
 
-void Item_render(Item *self)
+void Item_render(Item *self, RenderSnapshot *snapshot)
 {
+    // Les objets n'ont pas encore de sprite à ajouter au snapshot
+    (void)snapshot;
 }
 
 void Item_pickUp(Item *self, Player *player)
@@ -54,3 +56,33 @@ void Item_drawGizmos(Item *self, Gizmos *gizmos)
 {
     Gizmos_drawCircle(gizmos, self->m_position, self->m_radius);
 }
+
+void Item_save(Item *self, ItemRecord *record)
+{
+    assert(self && record);
+    record->position = self->m_position;
+    record->extent = self->m_extent;
+    record->radius = self->m_radius;
+    record->type = self->m_type;
+    record->state = self->m_state;
+    if (self->m_anim) record->anim = *(self->m_anim);
+}
+
+void Item_restore(Item *self, const ItemRecord *record)
+{
+    assert(self && record);
+    self->m_position = record->position;
+    self->m_extent = record->extent;
+    self->m_radius = record->radius;
+    self->m_type = record->type;
+    self->m_state = record->state;
+    if (self->m_anim) *(self->m_anim) = record->anim;
+}
+
+Item *Item_createFromRecord(LevelScene *scene, const ItemRecord *record)
+{
+    assert(record);
+    Item *self = Item_create(scene, record->type, record->position);
+    Item_restore(self, record);
+    return self;
+}
@@ -11,6 +11,7 @@
 #include "utils/sprite_anim.h"
 #include "utils/gizmos.h"
 #include "game/game_common.h"
+#include "game/level/render_snapshot.h"
 
 typedef struct LevelScene LevelScene;
 typedef struct Player Player;
@@ -57,14 +58,30 @@ typedef struct Item
     SpriteAnim *m_anim;
 } Item;
 
+/// @brief Etat d'un objet sans pointeur, utilisé pour la sauvegarde
+/// de la scène.
+typedef struct ItemRecord
+{
+    Vec2 position;
+    Vec2 extent;
+    float radius;
+    int type;
+    int state;
+    SpriteAnim anim;
+} ItemRecord;
+
 Item *Item_create(LevelScene *scene, int type, Vec2 position);
 void Item_destroy(Item *self);
 
 void Item_update(Item *self);
-void Item_render(Item *self);
+void Item_render(Item *self, RenderSnapshot *snapshot);
 void Item_pickUp(Item *self, Player *player);
 void Item_drawGizmos(Item *self, Gizmos *gizmos);
 
+void Item_save(Item *self, ItemRecord *record);
+void Item_restore(Item *self, const ItemRecord *record);
+Item *Item_createFromRecord(LevelScene *scene, const ItemRecord *record);
+
 INLINE bool Item_shouldBeDestroyed(Item *self)
 {
     return self->m_state == ITEM_STATE_PICKED_UP;
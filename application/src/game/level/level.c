@@ -101,6 +101,8 @@ void Level_update(Level *self)
 {
     LevelScene *scene = self->m_scene;
 
+    self->m_scroll += LEVEL_SCROLL_SPEED * Timer_getDelta(g_time);
+
     if ((self->m_state == LEVEL_STATE_COMPLETED) ||
         (self->m_state == LEVEL_STATE_FAILED))
         return;
@@ -132,24 +134,30 @@ void Level_update(Level *self)
     }
 }
 
-void Level_renderBackground(Level *self)
+void Level_renderBackground(Level *self, RenderSnapshot *snapshot)
 {
-    assert(self);
-    LevelScene *scene = self->m_scene;
-    AssetManager *assets = LevelScene_getAssetManager(scene);
-    Camera *camera = LevelScene_getCamera(scene);
-    SpriteSheet *spriteSheet = NULL;
-    float scale = Camera_getWorldToViewScale(camera);
-
-    SDL_FRect dstFRect = { 0 };
-    dstFRect.w = 1024 * PIX_TO_WORLD * scale;
-    dstFRect.h = 1024 * PIX_TO_WORLD * scale;
+    assert(self && snapshot);
 
-    dstFRect.x = 0;
-    spriteSheet = AssetManager_getSpriteSheet(assets, self->m_backgroundID);
-    SpriteSheet_renderCopyF(spriteSheet, 0, g_renderer, &dstFRect, 0.0, NULL, 0);
+    // Le fond défilant est dessiné par la scène à partir du défilement
+    snapshot->m_backgroundScroll = self->m_scroll;
+}
 
-    dstFRect.x += dstFRect.w;
-    SpriteSheet_renderCopyF(spriteSheet, 0, g_renderer, &dstFRect, 0.0, NULL, 0);
+void Level_save(Level *self, LevelRecord *record)
+{
+    assert(self && record);
+    record->state = self->m_state;
+    record->levelID = self->m_levelID;
+    record->waveIdx = self->m_waveIdx;
+    record->backgroundID = self->m_backgroundID;
+    record->scroll = self->m_scroll;
 }
 
+void Level_restore(Level *self, const LevelRecord *record)
+{
+    assert(self && record);
+    assert(self->m_levelID == record->levelID && "The saved level must be the same");
+    self->m_state = record->state;
+    self->m_waveIdx = record->waveIdx;
+    self->m_backgroundID = record->backgroundID;
+    self->m_scroll = record->scroll;
+}
@@ -10,6 +10,10 @@
 #include "game/game_common.h"
 
 typedef struct LevelScene LevelScene;
+typedef struct RenderSnapshot RenderSnapshot;
+
+/// @brief Vitesse de défilement du fond (en unités monde par seconde).
+#define LEVEL_SCROLL_SPEED 0.5f
 
 typedef enum LevelState
 {
@@ -37,12 +41,29 @@ typedef struct Level
 
     /// @brief Identifiant de l'image de fond du niveau.
     int m_backgroundID;
+
+    /// @brief Défilement du fond (en unités monde).
+    float m_scroll;
 } Level;
 
+/// @brief Etat d'un niveau sans pointeur, utilisé pour la sauvegarde
+/// de la scène.
+typedef struct LevelRecord
+{
+    int state;
+    int levelID;
+    int waveIdx;
+    int backgroundID;
+    float scroll;
+} LevelRecord;
+
 Level *Level_create(LevelScene *scene, int levelID);
 void Level_destroy(Level *self);
 void Level_update(Level *self);
-void Level_renderBackground(Level *self);
+void Level_renderBackground(Level *self, RenderSnapshot *snapshot);
+
+void Level_save(Level *self, LevelRecord *record);
+void Level_restore(Level *self, const LevelRecord *record);
 
 INLINE int Level_getState(Level *self)
 {
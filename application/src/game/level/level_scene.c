@@ -5,11 +5,84 @@
 */
 
 #include "game/level/level_scene.h"
+#include "utils/triple_buffer.h"
+
+/// @brief Fréquence du thread de simulation (pas par seconde).
+#define LEVEL_SIMULATION_FPS 60.f
+
+/// @brief Durée d'un pas de simulation en avance rapide (en millisecondes).
+#define LEVEL_FIXED_STEP_MS 16
+
+/// @brief Nombre de pas par image en avance rapide si la configuration
+/// du jeu n'en précise pas.
+#define LEVEL_FAST_FORWARD_TICKS 8
+
+/// @brief Nombre de pas entre deux lectures des événements en mode headless.
+#define LEVEL_HEADLESS_POLL_TICKS 256
+
+/// @brief Durée maximale de l'historique de retour arrière (en secondes).
+#define LEVEL_REWIND_SECONDS 20
+
+/// @brief Nombre d'images entre deux images clés de l'historique.
+#define LEVEL_REWIND_KEYFRAME_INTERVAL 30
+
+/// @brief Mémoire réservée à l'historique (en octets).
+#define LEVEL_REWIND_CAPACITY (8 << 20)
+
+/// @brief Délai maximal entre deux rendus pendant la pause (en millisecondes).
+/// La boucle est réveillée plus tôt par tout événement.
+#define LEVEL_PAUSE_WAIT_MS 250
+
+/// @brief Structure partagée entre le thread principal et le thread
+/// de simulation lorsque la simulation est séparée du rendu.
+typedef struct LevelSimulation
+{
+    LevelScene *m_scene;
+
+    /// @brief Instantanés de rendu publiés par la simulation.
+    TripleBuffer *m_snapshots;
+
+    /// @brief Entrées lues par le thread principal.
+    Input m_pollInput;
+
+    /// @brief Entrées cumulées en attente de lecture par la simulation.
+    /// Protégées par m_inputMutex.
+    Input m_sharedInput;
+    SDL_mutex *m_inputMutex;
+
+    /// @brief Booléen indiquant si de nouvelles entrées ont été cumulées
+    /// depuis la dernière lecture par la simulation.
+    /// Protégé par m_inputMutex et signalé par m_inputCond.
+    bool m_inputPending;
+    SDL_cond *m_inputCond;
+
+    /// @brief Demande d'arrêt du thread de simulation.
+    SDL_atomic_t m_stop;
+
+    bool m_drawGizmos;
+} LevelSimulation;
 
 /// @brief Met à jour le moteur du niveau de la scène.
 /// @param self la scène.
 void LevelScene_updateEngine(LevelScene *self);
 
+static void LevelScene_mainLoopThreaded(LevelScene *self, bool drawGizmos);
+static void LevelScene_mainLoopHeadless(LevelScene *self);
+static bool LevelScene_isTickLimitReached(LevelScene *self);
+static void LevelScene_recordRewind(LevelScene *self);
+static void LevelScene_renderWorld(LevelScene *self, const RenderSnapshot *snapshot);
+static bool LevelScene_restoreBackground(LevelScene *self, const RenderSnapshot *snapshot);
+static void LevelScene_captureBackground(LevelScene *self, const RenderSnapshot *snapshot);
+static void LevelScene_invalidateRender(LevelScene *self);
+static void LevelScene_updateSpriteScale(LevelScene *self);
+static void LevelScene_updateParticles(LevelScene *self, const RenderSnapshot *snapshot);
+static bool LevelScene_capturePauseFrame(LevelScene *self, const RenderSnapshot *snapshot);
+static int LevelScene_simulationThread(void *data);
+static void LevelScene_postInput(LevelSimulation *simulation, bool wakeUp);
+static void LevelScene_printLoopStats(LevelScene *self, Uint64 startTime, Uint64 frameCount);
+static bool LevelScene_isVisible(
+    LevelScene *self, const AABB *view, Vec2 position, Vec2 extent, float angle);
+
 LevelScene *LevelScene_create(GameConfig *gameConfig)
 {
     LevelScene *self = (LevelScene *)calloc(1, sizeof(LevelScene));
@@ -22,7 +95,35 @@ LevelScene *LevelScene_create(GameConfig *gameConfig)
     self->m_input = Input_create();
     self->m_gameConfig = gameConfig;
     self->m_camera = Camera_create(Game_getWidth(), Game_getHeight());
+
+    // Le SoftBlitter lit les sprite sheets en mémoire centrale
+    bool softBlitter = gameConfig->softBlitter && gameConfig->headless == false;
+    AssetManager_setKeepImages(self->m_assets, softBlitter);
+
+    // Les sprite sheets sont agrandies avant la construction de l'atlas
+    LevelScene_updateSpriteScale(self);
+    AssetManager_buildAtlas(self->m_assets);
+    AssetManager_preload(self->m_assets);
     self->m_gizmos = Gizmos_create(self->m_camera);
+    self->m_renderGizmos = Gizmos_create(self->m_camera);
+    self->m_spriteBatch = SpriteBatch_create(g_renderer);
+    if (softBlitter)
+    {
+        self->m_blitter = SoftBlitter_create(g_renderer, Game_getWidth(), Game_getHeight());
+        if (self->m_blitter)
+        {
+            SpriteBatch_setSoftBlitter(self->m_spriteBatch, self->m_blitter);
+        }
+        else
+        {
+            printf("WARNING - Software blitter needs a streaming texture\n");
+        }
+    }
+    self->m_renderQueue = RenderQueue_create(RENDER_SNAPSHOT_SPRITE_CAPACITY);
+    self->m_particles = ParticleSystem_create(g_renderer, LEVEL_PARTICLE_CAPACITY);
+
+    self->m_snapshot = (RenderSnapshot *)calloc(1, sizeof(RenderSnapshot));
+    AssertNew(self->m_snapshot);
 
     self->m_playerCount = gameConfig->playerCount;
     for (int i = 0; i < self->m_playerCount; i++)
@@ -32,6 +133,53 @@ LevelScene *LevelScene_create(GameConfig *gameConfig)
 
     self->m_ui = LevelUI_create(self);
     self->m_level = Level_create(self, gameConfig->levelID);
+
+    // Fond défilant : nébuleuse, étoiles lointaines puis étoiles proches
+    float scale = Camera_getWorldToViewScale(self->m_camera);
+    int tileSize = (int)(1024 * PIX_TO_WORLD * scale);
+    SpriteSheet *background = AssetManager_getSpriteSheet(
+        self->m_assets, self->m_level->m_backgroundID);
+    self->m_parallax = Parallax_create(g_renderer, Game_getWidth(), Game_getHeight());
+    Parallax_addSpriteLayer(self->m_parallax, background, 0, tileSize, tileSize, 0.25f);
+    Parallax_addStarLayer(self->m_parallax, 300, 0x1234u, 0.5f);
+    Parallax_addStarLayer(self->m_parallax, 60, 0x5678u, 1.0f);
+
+    // Le SoftBlitter redessine toute l'image à la résolution de l'écran :
+    // il exclut les zones modifiées et la résolution dynamique
+    if (self->m_blitter && gameConfig->dirtyRects)
+    {
+        printf("WARNING - Dirty rectangles are disabled with the software blitter\n");
+    }
+    if (self->m_blitter && gameConfig->dynamicResMin > 0.f)
+    {
+        printf("WARNING - Dynamic resolution is disabled with the software blitter\n");
+    }
+
+    if (gameConfig->dirtyRects && gameConfig->headless == false &&
+        self->m_blitter == NULL)
+    {
+        SDL_RendererInfo info = { 0 };
+        SDL_GetRendererInfo(g_renderer, &info);
+        if ((info.flags & SDL_RENDERER_SOFTWARE) && SDL_RenderTargetSupported(g_renderer))
+        {
+            self->m_dirtyRects = DirtyRects_create(Game_getWidth(), Game_getHeight());
+        }
+        else
+        {
+            printf("WARNING - Dirty rectangles need the software renderer (%s)\n", info.name);
+        }
+    }
+    if (gameConfig->dynamicResMin > 0.f && self->m_dirtyRects == NULL &&
+        self->m_blitter == NULL && gameConfig->headless == false)
+    {
+        // Les zones modifiées supposent un rendu direct à l'écran
+        self->m_dynamicRes = DynamicResolution_create(
+            g_renderer, Game_getWidth(), Game_getHeight(),
+            gameConfig->dynamicResMin, gameConfig->dynamicResMax,
+            LEVEL_RENDER_BUDGET_MS
+        );
+    }
+
     self->m_state = SCENE_STATE_FADING_IN;
     self->m_fadingTime = 0.5f;
     self->m_isLocked = false;
@@ -39,6 +187,20 @@ LevelScene *LevelScene_create(GameConfig *gameConfig)
     self->m_gameConfig->nextScene = GAME_SCENE_TITLE;
     LevelUI_update(self->m_ui);
 
+    LevelScene_setFastForward(self, gameConfig->fastForward);
+
+    if (gameConfig->rewind)
+    {
+        self->m_rewindSave = (LevelSceneSave *)calloc(1, sizeof(LevelSceneSave));
+        AssertNew(self->m_rewindSave);
+        self->m_rewind = RewindBuffer_create(
+            sizeof(LevelSceneSave),
+            LEVEL_REWIND_SECONDS * (int)LEVEL_SIMULATION_FPS,
+            LEVEL_REWIND_KEYFRAME_INTERVAL,
+            LEVEL_REWIND_CAPACITY
+        );
+    }
+
     return self;
 }
 
@@ -65,6 +227,19 @@ void LevelScene_destroy(LevelScene *self)
     AssetManager_destroy(self->m_assets);
     Camera_destroy(self->m_camera);
     Gizmos_destroy(self->m_gizmos);
+    Gizmos_destroy(self->m_renderGizmos);
+    SpriteBatch_destroy(self->m_spriteBatch);
+    SoftBlitter_destroy(self->m_blitter);
+    RenderQueue_destroy(self->m_renderQueue);
+    ParticleSystem_destroy(self->m_particles);
+    Parallax_destroy(self->m_parallax);
+    free(self->m_snapshot);
+    if (self->m_pauseFrame) SDL_DestroyTexture(self->m_pauseFrame);
+    DirtyRects_destroy(self->m_dirtyRects);
+    if (self->m_backgroundCache) SDL_DestroyTexture(self->m_backgroundCache);
+    DynamicResolution_destroy(self->m_dynamicRes);
+    RewindBuffer_destroy(self->m_rewind);
+    free(self->m_rewindSave);
     Input_destroy(self->m_input);
     Level_destroy(self->m_level);
     LevelUI_destroy(self->m_ui);
@@ -75,37 +250,454 @@ void LevelScene_destroy(LevelScene *self)
 void LevelScene_mainLoop(LevelScene *self, bool drawGizmos)
 {
     assert(self && "The LevelScene must be created");
+    if (self->m_gameConfig->headless)
+    {
+        LevelScene_mainLoopHeadless(self);
+        return;
+    }
+    if (self->m_gameConfig->threadedSimulation)
+    {
+        LevelScene_mainLoopThreaded(self, drawGizmos);
+        return;
+    }
+
+    Uint64 startTime = SDL_GetPerformanceCounter();
+    Uint64 frameCount = 0;
+
+    FramePacer_resync(g_pacer);
     while (true)
     {
+        // Attend le moment de lire les entrées.
+        // En pause, la boucle dort jusqu'au prochain événement.
+        if (self->m_ui->m_paused)
+        {
+            SDL_WaitEventTimeout(NULL, LEVEL_PAUSE_WAIT_MS);
+            FramePacer_resync(g_pacer);
+        }
+        FramePacer_waitForInput(g_pacer);
+
         // Met à jour la scène
-        Timer_update(g_time);
-        LevelScene_update(self);
+        Input_update(self->m_input);
 
         Input *input = LevelScene_getInput(self);
         if (input->quitPressed)
         {
             self->m_gameConfig->nextScene = GAME_SCENE_QUIT;
-            return;
+            break;
+        }
+
+        // Fenêtre minimisée : pause automatique puis sommeil
+        if (input->windowMinimized)
+        {
+            LevelUI_autoPause(self->m_ui);
+            Input_waitWhileMinimized(input);
+            Timer_resync(g_time);
+            FramePacer_resync(g_pacer);
+            if (input->quitPressed)
+            {
+                self->m_gameConfig->nextScene = GAME_SCENE_QUIT;
+                break;
+            }
+            continue;
+        }
+        FramePacer_setBackground(g_pacer, input->windowFocused == false);
+        if (input->renderTargetsResetPressed || input->windowExposedPressed)
+        {
+            // La taille de la fenêtre a pu changer
+            LevelScene_updateSpriteScale(self);
+            LevelScene_invalidateRender(self);
+        }
+
+        LevelScene_advance(self);
+
+        if (LevelScene_isTickLimitReached(self))
+        {
+            self->m_gameConfig->nextScene = GAME_SCENE_QUIT;
+            break;
         }
 
         if (self->m_state == SCENE_STATE_FINISHED)
-            return;
+            break;
 
         // Rend la scène
-        LevelScene_render(self);
+        LevelScene_capture(self, self->m_snapshot, drawGizmos);
+        LevelScene_render(self, self->m_snapshot);
+
+        // Attend l'échéance de l'image puis affiche le nouveau rendu
+        FramePacer_waitForDeadline(g_pacer);
+        SDL_RenderPresent(g_renderer);
+        RenderState_endFrame(g_renderState);
+        frameCount++;
+    }
+
+    LevelScene_printLoopStats(self, startTime, frameCount);
+}
+
+static void LevelScene_mainLoopThreaded(LevelScene *self, bool drawGizmos)
+{
+    assert(self && "The LevelScene must be created");
+
+    LevelSimulation *simulation = (LevelSimulation *)calloc(1, sizeof(LevelSimulation));
+    AssertNew(simulation);
+
+    simulation->m_scene = self;
+    simulation->m_drawGizmos = drawGizmos;
+    simulation->m_pollInput = *(self->m_input);
+    simulation->m_sharedInput = *(self->m_input);
+    simulation->m_snapshots = TripleBuffer_create(sizeof(RenderSnapshot));
+    simulation->m_inputMutex = SDL_CreateMutex();
+    AssertNew(simulation->m_inputMutex);
+    simulation->m_inputCond = SDL_CreateCond();
+    AssertNew(simulation->m_inputCond);
+    SDL_AtomicSet(&simulation->m_stop, 0);
+
+    // Publie un premier instantané avant le lancement de la simulation
+    RenderSnapshot *snapshot = (RenderSnapshot *)TripleBuffer_getWriteBuffer(simulation->m_snapshots);
+    LevelScene_capture(self, snapshot, drawGizmos);
+    TripleBuffer_publish(simulation->m_snapshots);
+
+    SDL_Thread *thread = SDL_CreateThread(
+        LevelScene_simulationThread, "simulation", simulation);
+    if (thread == NULL)
+    {
+        printf("ERROR - Create simulation thread %s\n", SDL_GetError());
+        assert(false); abort();
+    }
+
+    Uint64 startTime = SDL_GetPerformanceCounter();
+    Uint64 frameCount = 0;
+
+    bool paused = false;
+
+    FramePacer_resync(g_pacer);
+    while (true)
+    {
+        // Attend le moment de lire les entrées.
+        // En pause, la boucle dort jusqu'au prochain événement.
+        bool hasEvent = true;
+        if (paused)
+        {
+            hasEvent = (SDL_WaitEventTimeout(NULL, LEVEL_PAUSE_WAIT_MS) != 0);
+            FramePacer_resync(g_pacer);
+        }
+        FramePacer_waitForInput(g_pacer);
+
+        // Lit les entrées (thread principal) et les transmet à la simulation.
+        // En pause, la simulation n'est réveillée que par un événement.
+        Input_update(&simulation->m_pollInput);
+        LevelScene_postInput(simulation, hasEvent);
+
+        if (simulation->m_pollInput.quitPressed)
+        {
+            self->m_gameConfig->nextScene = GAME_SCENE_QUIT;
+            break;
+        }
+
+        // Fenêtre minimisée : la simulation se met en pause, le rendu dort
+        if (Input_waitWhileMinimized(&simulation->m_pollInput))
+        {
+            LevelScene_postInput(simulation, true);
+
+            FramePacer_resync(g_pacer);
+            if (simulation->m_pollInput.quitPressed)
+            {
+                self->m_gameConfig->nextScene = GAME_SCENE_QUIT;
+                break;
+            }
+            continue;
+        }
+        FramePacer_setBackground(g_pacer, simulation->m_pollInput.windowFocused == false);
+        if (simulation->m_pollInput.renderTargetsResetPressed ||
+            simulation->m_pollInput.windowExposedPressed)
+        {
+            LevelScene_invalidateRender(self);
+        }
+
+        // Rend le dernier instantané publié par la simulation
+        const RenderSnapshot *front =
+            (const RenderSnapshot *)TripleBuffer_acquire(simulation->m_snapshots);
+        if (front->m_sceneState == SCENE_STATE_FINISHED)
+            break;
+
+        Uint64 maxTicks = self->m_gameConfig->maxTicks;
+        if (maxTicks > 0 && front->m_tick >= maxTicks)
+        {
+            self->m_gameConfig->nextScene = GAME_SCENE_QUIT;
+            break;
+        }
 
-        if (drawGizmos) LevelScene_drawGizmos(self);
+        LevelScene_render(self, front);
+        paused = front->m_paused;
 
-        // Affiche le nouveau rendu
+        // Attend l'échéance de l'image puis affiche le nouveau rendu
+        FramePacer_waitForDeadline(g_pacer);
         SDL_RenderPresent(g_renderer);
+        RenderState_endFrame(g_renderState);
+        frameCount++;
+    }
+
+    SDL_AtomicSet(&simulation->m_stop, 1);
+    LevelScene_postInput(simulation, true);
+    SDL_WaitThread(thread, NULL);
+
+    LevelScene_printLoopStats(self, startTime, frameCount);
+
+    TripleBuffer_destroy(simulation->m_snapshots);
+    SDL_DestroyCond(simulation->m_inputCond);
+    SDL_DestroyMutex(simulation->m_inputMutex);
+    free(simulation);
+}
+
+static void LevelScene_postInput(LevelSimulation *simulation, bool wakeUp)
+{
+    SDL_LockMutex(simulation->m_inputMutex);
+    Input_accumulate(&simulation->m_sharedInput, &simulation->m_pollInput);
+    if (wakeUp)
+    {
+        simulation->m_inputPending = true;
+        SDL_CondSignal(simulation->m_inputCond);
+    }
+    SDL_UnlockMutex(simulation->m_inputMutex);
+}
+
+static int LevelScene_simulationThread(void *data)
+{
+    LevelSimulation *simulation = (LevelSimulation *)data;
+    LevelScene *self = simulation->m_scene;
+    FramePacer *pacer = FramePacer_create(LEVEL_SIMULATION_FPS);
+
+    while (SDL_AtomicGet(&simulation->m_stop) == 0)
+    {
+        FramePacer_waitForInput(pacer);
+
+        // Récupère les entrées cumulées par le thread principal
+        SDL_LockMutex(simulation->m_inputMutex);
+        *(self->m_input) = simulation->m_sharedInput;
+        Input_resetPressed(&simulation->m_sharedInput);
+        simulation->m_inputPending = false;
+        SDL_UnlockMutex(simulation->m_inputMutex);
+
+        FramePacer_setBackground(pacer,
+            self->m_input->windowMinimized || (self->m_input->windowFocused == false));
+
+        LevelScene_advance(self);
+
+        // Publie l'instantané de rendu
+        RenderSnapshot *snapshot = (RenderSnapshot *)TripleBuffer_getWriteBuffer(simulation->m_snapshots);
+        LevelScene_capture(self, snapshot, simulation->m_drawGizmos);
+        TripleBuffer_publish(simulation->m_snapshots);
+
+        if (self->m_state == SCENE_STATE_FINISHED)
+            break;
+
+        if (self->m_ui->m_paused)
+        {
+            // En pause, l'état ne change qu'avec les entrées : la simulation
+            // dort jusqu'à ce que le thread principal lui en transmette
+            SDL_LockMutex(simulation->m_inputMutex);
+            while (simulation->m_inputPending == false &&
+                SDL_AtomicGet(&simulation->m_stop) == 0)
+            {
+                SDL_CondWaitTimeout(
+                    simulation->m_inputCond, simulation->m_inputMutex,
+                    LEVEL_PAUSE_WAIT_MS
+                );
+            }
+            SDL_UnlockMutex(simulation->m_inputMutex);
+            FramePacer_resync(pacer);
+            continue;
+        }
+
+        FramePacer_waitForDeadline(pacer);
+    }
+
+    FramePacer_destroy(pacer);
+    return 0;
+}
+
+static void LevelScene_mainLoopHeadless(LevelScene *self)
+{
+    assert(self && "The LevelScene must be created");
+
+    Uint64 startTime = SDL_GetPerformanceCounter();
+
+    // Aucun rendu, aucune attente : les pas s'enchaînent aussi vite que
+    // possible avec un pas de temps fixe.
+    Game_setSoundFXMuted(true);
+    while (true)
+    {
+        if (self->m_tickCount % LEVEL_HEADLESS_POLL_TICKS == 0)
+        {
+            Input_update(self->m_input);
+            if (self->m_input->quitPressed)
+                break;
+        }
+        else
+        {
+            Input_resetPressed(self->m_input);
+        }
+
+        Timer_step(g_time, LEVEL_FIXED_STEP_MS);
+        LevelScene_step(self);
+
+        if (self->m_state == SCENE_STATE_FINISHED)
+            break;
+        if (LevelScene_isTickLimitReached(self))
+            break;
+    }
+    Game_setSoundFXMuted(false);
+
+    // Une exécution headless ne retourne pas à l'écran titre
+    self->m_gameConfig->nextScene = GAME_SCENE_QUIT;
+
+    LevelScene_printLoopStats(self, startTime, 0);
+}
+
+static bool LevelScene_isTickLimitReached(LevelScene *self)
+{
+    Uint64 maxTicks = self->m_gameConfig->maxTicks;
+    return (maxTicks > 0) && (self->m_tickCount >= maxTicks);
+}
+
+static void LevelScene_printLoopStats(LevelScene *self, Uint64 startTime, Uint64 frameCount)
+{
+    double seconds =
+        (double)(SDL_GetPerformanceCounter() - startTime) /
+        (double)SDL_GetPerformanceFrequency();
+    if (seconds <= 0.0) return;
+
+    const char *mode = "serial";
+    if (self->m_gameConfig->headless) mode = "headless";
+    else if (self->m_gameConfig->threadedSimulation) mode = "threaded";
+
+    printf("INFO - Level loop (%s) over %.1f s, %llu ticks\n",
+        mode, seconds, (unsigned long long)self->m_tickCount);
+    printf("     - simulation %.1f ticks/s, render %.1f frames/s\n",
+        (double)self->m_tickCount / seconds, (double)frameCount / seconds);
+
+    if (self->m_captureCount > 0)
+    {
+        double captureCount = (double)self->m_captureCount;
+        printf("     - culling %.1f drawn, %.1f culled objects/frame\n",
+            (double)self->m_drawnObjectCount / captureCount,
+            (double)self->m_culledObjectCount / captureCount);
+        self->m_captureCount = 0;
+        self->m_drawnObjectCount = 0;
+        self->m_culledObjectCount = 0;
+    }
+    if (frameCount > 0)
+    {
+        SpriteBatch_printStats(self->m_spriteBatch);
+        if (self->m_dirtyRects)
+        {
+            DirtyRects_printStats(self->m_dirtyRects);
+        }
+        if (self->m_dynamicRes)
+        {
+            DynamicResolution_printStats(self->m_dynamicRes);
+        }
+    }
+    if (self->m_rewind)
+    {
+        RewindBuffer_printStats(self->m_rewind, LEVEL_SIMULATION_FPS);
     }
 }
 
-void LevelScene_update(LevelScene *self)
+static bool LevelScene_isVisible(
+    LevelScene *self, const AABB *view, Vec2 position, Vec2 extent, float angle)
+{
+    AABB bounds = AABB_fromRotatedRect(position, extent, angle);
+    if (AABB_overlap(*view, bounds))
+    {
+        self->m_drawnObjectCount++;
+        return true;
+    }
+    self->m_culledObjectCount++;
+    return false;
+}
+
+void LevelScene_advance(LevelScene *self)
 {
     assert(self && "The LevelScene must be created");
 
-    Input_update(self->m_input);
+    if (self->m_input->fastForwardPressed)
+    {
+        LevelScene_setFastForward(self, self->m_fastForwardTicks <= 1);
+    }
+
+    // Pas d'écart de temps important au retour de la fenêtre
+    if (self->m_input->windowRestoredPressed)
+    {
+        Timer_resync(g_time);
+    }
+
+    if (self->m_rewind && self->m_input->rewindDown)
+    {
+        // Retour arrière : l'état de l'image précédente est décodé à la demande
+        Timer_update(g_time);
+        if (RewindBuffer_pop(self->m_rewind, self->m_rewindSave))
+        {
+            LevelScene_restoreState(self, self->m_rewindSave);
+        }
+        return;
+    }
+
+    if (self->m_fastForwardTicks <= 1)
+    {
+        Timer_update(g_time);
+        LevelScene_step(self);
+        LevelScene_recordRewind(self);
+        return;
+    }
+
+    // Avance rapide : seul le dernier pas de l'image est audible et rendu.
+    // Les pressions de boutons ne sont traitées qu'au premier pas.
+    for (int i = 0; i < self->m_fastForwardTicks; i++)
+    {
+        bool lastTick = (i == self->m_fastForwardTicks - 1);
+        Game_setSoundFXMuted(!lastTick);
+
+        Timer_step(g_time, LEVEL_FIXED_STEP_MS);
+        LevelScene_step(self);
+        Input_resetPressed(self->m_input);
+
+        if (self->m_state == SCENE_STATE_FINISHED)
+            break;
+        if (LevelScene_isTickLimitReached(self))
+            break;
+    }
+    Game_setSoundFXMuted(false);
+    LevelScene_recordRewind(self);
+}
+
+static void LevelScene_recordRewind(LevelScene *self)
+{
+    if (self->m_rewind == NULL)
+        return;
+
+    // En pause, l'état ne change pas : l'historique reste inchangé
+    if (self->m_ui->m_paused)
+        return;
+
+    LevelScene_saveState(self, self->m_rewindSave);
+    RewindBuffer_push(self->m_rewind, self->m_rewindSave);
+}
+
+void LevelScene_setFastForward(LevelScene *self, bool enabled)
+{
+    assert(self && "The LevelScene must be created");
+
+    // Sans --fast-forward, la touche Tab utilise la valeur par défaut
+    int ticks = self->m_gameConfig->fastForwardTicks;
+    if (ticks == 0) ticks = LEVEL_FAST_FORWARD_TICKS;
+    assert(ticks >= 2 && "The fast forward tick count is not valid");
+
+    self->m_fastForwardTicks = enabled ? ticks : 1;
+}
+
+void LevelScene_step(LevelScene *self)
+{
+    assert(self && "The LevelScene must be created");
 
     if (self->m_state == SCENE_STATE_RUNNING)
     {
@@ -130,6 +722,7 @@ void LevelScene_update(LevelScene *self)
     }
 
     LevelUI_update(self->m_ui);
+    self->m_tickCount++;
 }
 
 void LevelScene_quit(LevelScene *self)
@@ -144,6 +737,137 @@ void LevelScene_quit(LevelScene *self)
     self->m_accu = 0.f;
 }
 
+void LevelScene_saveState(LevelScene *self, LevelSceneSave *save)
+{
+    assert(self && "The LevelScene must be created");
+    assert(save);
+
+    save->m_tickCount = self->m_tickCount;
+    save->m_elapsed = g_time->m_elapsed;
+    save->m_unscaledElapsed = g_time->m_unscaledElapsed;
+
+    save->m_state = self->m_state;
+    save->m_accu = self->m_accu;
+    save->m_fadingTime = self->m_fadingTime;
+
+    Level_save(self->m_level, &(save->m_level));
+
+    // Les emplacements inutilisés sont remis à zéro pour que deux états
+    // identiques donnent deux sauvegardes identiques.
+    save->m_playerCount = self->m_playerCount;
+    for (int i = 0; i < self->m_playerCount; i++)
+    {
+        Player_save(self->m_players[i], save->m_players + i);
+    }
+    memset(save->m_players + self->m_playerCount, 0,
+        (MAX_PLAYER_COUNT - self->m_playerCount) * sizeof(PlayerRecord));
+
+    save->m_enemyCount = self->m_enemyCount;
+    for (int i = 0; i < self->m_enemyCount; i++)
+    {
+        Enemy_save(self->m_enemies[i], save->m_enemies + i);
+    }
+    memset(save->m_enemies + self->m_enemyCount, 0,
+        (ENEMY_CAPACITY - self->m_enemyCount) * sizeof(EnemyRecord));
+
+    save->m_bulletCount = self->m_bulletCount;
+    for (int i = 0; i < self->m_bulletCount; i++)
+    {
+        Bullet_save(self->m_bullets[i], save->m_bullets + i);
+    }
+    memset(save->m_bullets + self->m_bulletCount, 0,
+        (BULLET_CAPACITY - self->m_bulletCount) * sizeof(BulletRecord));
+
+    save->m_itemCount = self->m_itemCount;
+    for (int i = 0; i < self->m_itemCount; i++)
+    {
+        Item_save(self->m_items[i], save->m_items + i);
+    }
+    memset(save->m_items + self->m_itemCount, 0,
+        (ITEM_CAPACITY - self->m_itemCount) * sizeof(ItemRecord));
+}
+
+void LevelScene_restoreState(LevelScene *self, const LevelSceneSave *save)
+{
+    assert(self && "The LevelScene must be created");
+    assert(save);
+    assert(save->m_playerCount == self->m_playerCount);
+
+    self->m_tickCount = save->m_tickCount;
+    g_time->m_elapsed = save->m_elapsed;
+    g_time->m_unscaledElapsed = save->m_unscaledElapsed;
+
+    self->m_state = save->m_state;
+    self->m_accu = save->m_accu;
+    self->m_fadingTime = save->m_fadingTime;
+
+    Level_restore(self->m_level, &(save->m_level));
+
+    for (int i = 0; i < self->m_playerCount; i++)
+    {
+        Player_restore(self->m_players[i], save->m_players + i);
+    }
+
+    // Les entités existantes sont réutilisées si leur type est le même,
+    // les autres sont recréées à partir de la sauvegarde.
+    for (int i = 0; i < save->m_enemyCount; i++)
+    {
+        const EnemyRecord *record = save->m_enemies + i;
+        Enemy *enemy = self->m_enemies[i];
+        if (enemy && enemy->m_type == record->type)
+        {
+            Enemy_restore(enemy, record);
+            continue;
+        }
+        Enemy_destroy(enemy);
+        self->m_enemies[i] = Enemy_createFromRecord(self, record);
+    }
+    for (int i = save->m_enemyCount; i < self->m_enemyCount; i++)
+    {
+        Enemy_destroy(self->m_enemies[i]);
+        self->m_enemies[i] = NULL;
+    }
+    self->m_enemyCount = save->m_enemyCount;
+
+    for (int i = 0; i < save->m_bulletCount; i++)
+    {
+        const BulletRecord *record = save->m_bullets + i;
+        Bullet *bullet = self->m_bullets[i];
+        if (bullet && bullet->m_type == record->type)
+        {
+            Bullet_restore(bullet, record);
+            continue;
+        }
+        Bullet_destroy(bullet);
+        self->m_bullets[i] = Bullet_createFromRecord(self, record);
+    }
+    for (int i = save->m_bulletCount; i < self->m_bulletCount; i++)
+    {
+        Bullet_destroy(self->m_bullets[i]);
+        self->m_bullets[i] = NULL;
+    }
+    self->m_bulletCount = save->m_bulletCount;
+
+    for (int i = 0; i < save->m_itemCount; i++)
+    {
+        const ItemRecord *record = save->m_items + i;
+        Item *item = self->m_items[i];
+        if (item && item->m_type == record->type)
+        {
+            Item_restore(item, record);
+            continue;
+        }
+        Item_destroy(item);
+        self->m_items[i] = Item_createFromRecord(self, record);
+    }
+    for (int i = save->m_itemCount; i < self->m_itemCount; i++)
+    {
+        Item_destroy(self->m_items[i]);
+        self->m_items[i] = NULL;
+    }
+    self->m_itemCount = save->m_itemCount;
+}
+
 void LevelScene_updateEngine(LevelScene *self)
 {
     assert(self && "The LevelScene must be created");
@@ -316,58 +1040,421 @@ void LevelScene_updateEngine(LevelScene *self)
     self->m_isLocked = false;
 }
 
-void LevelScene_render(LevelScene *self)
+void LevelScene_capture(LevelScene *self, RenderSnapshot *snapshot, bool drawGizmos)
 {
     assert(self && "The LevelScene must be created");
+    assert(snapshot);
 
-    // Efface le rendu précédent
-    SDL_SetRenderDrawColor(g_renderer, 37, 37, 37, 255);
-    SDL_RenderClear(g_renderer);
+    RenderSnapshot_clear(snapshot);
+    snapshot->m_tick = self->m_tickCount;
+    self->m_captureCount++;
 
-    SDL_SetHintWithPriority(SDL_HINT_RENDER_SCALE_QUALITY, "0", SDL_HINT_OVERRIDE);
+    // Les objets hors de la vue sont éliminés avant tout calcul de rendu.
+    // Leur boîte englobante tient compte de la rotation de leur sprite.
+    AABB view = Camera_getVisibleAABB(self->m_camera);
 
-    // Affiche le fond
-    Level_renderBackground(self->m_level);
+    // Fond
+    Level_renderBackground(self->m_level, snapshot);
 
-    // Affiche les projectiles
+    // Projectiles
+    RenderSnapshot_setLayer(snapshot, RENDER_LAYER_BULLETS);
     for (int i = 0; i < self->m_bulletCount; i++)
     {
-        assert(self->m_bullets[i]);
-        Bullet_render(self->m_bullets[i]);
+        Bullet *bullet = self->m_bullets[i];
+        assert(bullet);
+        if (LevelScene_isVisible(self, &view, bullet->m_position, bullet->m_extent, bullet->m_angle))
+            Bullet_render(bullet, snapshot);
     }
-    // Affiche les objets
+    // Objets
+    RenderSnapshot_setLayer(snapshot, RENDER_LAYER_ITEMS);
     for (int i = 0; i < self->m_itemCount; i++)
     {
-        assert(self->m_items[i]);
-        Item_render(self->m_items[i]);
+        Item *item = self->m_items[i];
+        assert(item);
+        if (LevelScene_isVisible(self, &view, item->m_position, item->m_extent, 0.f))
+            Item_render(item, snapshot);
     }
-    // Affiche les ennemis
+    // Ennemis
+    RenderSnapshot_setLayer(snapshot, RENDER_LAYER_ENEMIES);
     for (int i = 0; i < self->m_enemyCount; i++)
     {
-        assert(self->m_enemies[i]);
-        Enemy_render(self->m_enemies[i]);
+        Enemy *enemy = self->m_enemies[i];
+        assert(enemy);
+        if (LevelScene_isVisible(self, &view, enemy->m_position, enemy->m_extent, -90.f))
+            Enemy_render(enemy, snapshot);
+    }
+    // Joueurs
+    RenderSnapshot_setLayer(snapshot, RENDER_LAYER_PLAYERS);
+    const Vec2 playerExtent = Vec2_set(48 * PIX_TO_WORLD, 48 * PIX_TO_WORLD);
+    for (int i = 0; i < self->m_playerCount; i++)
+    {
+        Player *player = self->m_players[i];
+        assert(player);
+        if (LevelScene_isVisible(self, &view, player->m_position, playerExtent, 90.f))
+            Player_render(player, snapshot);
     }
-    // Affiche les joueurs
+
+    // Valeurs affichées par l'interface utilisateur
+    snapshot->m_playerCount = self->m_playerCount;
     for (int i = 0; i < self->m_playerCount; i++)
     {
-        assert(self->m_players[i]);
-        Player_render(self->m_players[i]);
+        snapshot->m_playerHP[i] = self->m_players[i]->m_hp;
+    }
+    snapshot->m_paused = self->m_ui->m_paused;
+
+    // Emissions ponctuelles de particules
+    memcpy(snapshot->m_bursts, self->m_bursts, sizeof(self->m_bursts));
+    snapshot->m_burstCount = self->m_burstCount;
+
+    // Fading
+    snapshot->m_sceneState = self->m_state;
+    snapshot->m_accu = self->m_accu;
+    snapshot->m_fadingTime = self->m_fadingTime;
+
+    // Gizmos
+    if (drawGizmos)
+    {
+        Gizmos_beginRecord(self->m_gizmos, snapshot->m_gizmos, RENDER_SNAPSHOT_GIZMO_CAPACITY);
+        LevelScene_drawGizmos(self);
+        snapshot->m_gizmoCount = Gizmos_endRecord(self->m_gizmos);
+    }
+}
+
+void LevelScene_render(LevelScene *self, const RenderSnapshot *snapshot)
+{
+    assert(self && "The LevelScene must be created");
+    assert(snapshot);
+
+    LevelScene_updateParticles(self, snapshot);
+
+    if (snapshot->m_paused == false)
+    {
+        self->m_pauseFrameValid = false;
+        LevelScene_renderWorld(self, snapshot);
+        return;
+    }
+
+    // Pause : la scène est rendue une seule fois dans une texture
+    if (self->m_dirtyRects)
+    {
+        // L'écran de pause recouvre toute l'image
+        DirtyRects_invalidate(self->m_dirtyRects);
+    }
+    if (self->m_pauseFrameValid == false)
+    {
+        self->m_pauseFrameValid = LevelScene_capturePauseFrame(self, snapshot);
+    }
+    if (self->m_pauseFrameValid)
+    {
+        RenderState_setDrawColor(g_renderState, 0, 0, 0, 255);
+        SDL_RenderClear(g_renderer);
+        SDL_RenderCopy(g_renderer, self->m_pauseFrame, NULL, NULL);
+    }
+    else
+    {
+        LevelScene_renderWorld(self, snapshot);
+    }
+    LevelUI_renderPause(self->m_ui);
+}
+
+static bool LevelScene_capturePauseFrame(LevelScene *self, const RenderSnapshot *snapshot)
+{
+    if (SDL_RenderTargetSupported(g_renderer) == SDL_FALSE)
+        return false;
+
+    if (self->m_pauseFrame == NULL)
+    {
+        self->m_pauseFrame = SDL_CreateTexture(
+            g_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+            Game_getWidth(), Game_getHeight()
+        );
+        if (self->m_pauseFrame == NULL)
+        {
+            printf("ERROR - Create pause frame %s\n", SDL_GetError());
+            return false;
+        }
+    }
+
+    SDL_Texture *target = SDL_GetRenderTarget(g_renderer);
+    if (SDL_SetRenderTarget(g_renderer, self->m_pauseFrame) < 0)
+        return false;
+
+    LevelScene_renderWorld(self, snapshot);
+    SDL_SetRenderTarget(g_renderer, target);
+
+    return true;
+}
+
+static void LevelScene_renderWorld(LevelScene *self, const RenderSnapshot *snapshot)
+{
+    RenderState_setHint(g_renderState, SDL_HINT_RENDER_SCALE_QUALITY, "0");
+
+    // Zones modifiées : le fond figé est restauré sous les éléments mobiles,
+    // sauf dans une cible de rendu (image de pause)
+    bool restored = false;
+    if (self->m_dirtyRects && SDL_GetRenderTarget(g_renderer) == NULL)
+    {
+        restored = LevelScene_restoreBackground(self, snapshot);
+    }
+
+    // Résolution dynamique : le monde est dessiné dans une cible de rendu
+    // réduite, l'interface reste à la résolution native
+    bool scaled = false;
+    if (self->m_dynamicRes && restored == false && SDL_GetRenderTarget(g_renderer) == NULL)
+    {
+        Parallax_update(self->m_parallax);
+        scaled = DynamicResolution_begin(self->m_dynamicRes);
+    }
+
+    if (self->m_blitter)
+    {
+        // Le fond est capturé dans l'image du SoftBlitter, qui dessine
+        // ensuite les sprites par-dessus
+        LevelScene_captureBackground(self, snapshot);
+    }
+    else if (restored == false)
+    {
+        // Efface le rendu précédent
+        RenderState_setDrawColor(g_renderState, 37, 37, 37, 255);
+        SDL_RenderClear(g_renderer);
+
+        // Affiche le fond défilant
+        float scale = Camera_getWorldToViewScale(self->m_camera);
+        Parallax_render(self->m_parallax, snapshot->m_backgroundScroll * scale);
     }
+
+    // Affiche les sprites triés par couche :
+    // les projectiles, les objets, les ennemis puis les joueurs
+    SpriteBatch_begin(self->m_spriteBatch);
+    RenderSnapshot_renderSprites(
+        snapshot, self->m_assets, self->m_renderQueue, self->m_spriteBatch
+    );
+    SpriteBatch_end(self->m_spriteBatch);
+
+    if (self->m_blitter)
+    {
+        SoftBlitter_upload(self->m_blitter);
+    }
+
+    // Affiche les particules par-dessus les sprites
+    ParticleSystem_render(self->m_particles, self->m_camera);
+
+    if (scaled)
+    {
+        DynamicResolution_end(self->m_dynamicRes);
+    }
+
     // Affiche l'interface utilisateur
-    LevelUI_render(self->m_ui);
+    LevelUI_render(self->m_ui, snapshot);
 
     // Fading
-    if ((self->m_state == SCENE_STATE_FADING_IN) ||
-        (self->m_state == SCENE_STATE_FADING_OUT))
+    if ((snapshot->m_sceneState == SCENE_STATE_FADING_IN) ||
+        (snapshot->m_sceneState == SCENE_STATE_FADING_OUT))
     {
-        int opacity = (int)(255.f * self->m_accu / self->m_fadingTime);
-        if (self->m_state == SCENE_STATE_FADING_IN)
+        int opacity = (int)(255.f * snapshot->m_accu / snapshot->m_fadingTime);
+        if (snapshot->m_sceneState == SCENE_STATE_FADING_IN)
         {
             opacity = 255 - opacity;
         }
-        SDL_SetRenderDrawColor(g_renderer, 0, 0, 0, opacity);
+        RenderState_setDrawColor(g_renderState, 0, 0, 0, opacity);
         SDL_RenderFillRect(g_renderer, NULL);
     }
+
+    // Gizmos
+    RenderSnapshot_renderGizmos(snapshot, self->m_renderGizmos);
+}
+
+static bool LevelScene_restoreBackground(LevelScene *self, const RenderSnapshot *snapshot)
+{
+    DirtyRects *dirtyRects = self->m_dirtyRects;
+
+    // Compose le fond une seule fois. Il reste figé tant qu'il est valide :
+    // un fond défilant modifierait tout l'écran à chaque image.
+    if (self->m_backgroundCacheValid == false)
+    {
+        if (self->m_backgroundCache == NULL)
+        {
+            self->m_backgroundCache = SDL_CreateTexture(
+                g_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                Game_getWidth(), Game_getHeight()
+            );
+            if (self->m_backgroundCache == NULL)
+            {
+                printf("ERROR - Create background cache %s\n", SDL_GetError());
+                return false;
+            }
+            SDL_SetTextureBlendMode(self->m_backgroundCache, SDL_BLENDMODE_NONE);
+        }
+        if (SDL_SetRenderTarget(g_renderer, self->m_backgroundCache) < 0)
+            return false;
+
+        RenderState_setDrawColor(g_renderState, 37, 37, 37, 255);
+        SDL_RenderClear(g_renderer);
+        float scale = Camera_getWorldToViewScale(self->m_camera);
+        Parallax_render(self->m_parallax, snapshot->m_backgroundScroll * scale);
+        SDL_SetRenderTarget(g_renderer, NULL);
+
+        self->m_backgroundCacheValid = true;
+        DirtyRects_invalidate(dirtyRects);
+    }
+
+    // Déclare tout ce qui est dessiné par-dessus le fond
+    for (int i = 0; i < snapshot->m_spriteCount; i++)
+    {
+        const SpriteCommand *command = snapshot->m_sprites + i;
+        SDL_FRect bounds = command->dst;
+        if (command->angle != 0.0)
+        {
+            // Cercle circonscrit au sprite tourné
+            float radius = 0.5f * sqrtf(bounds.w * bounds.w + bounds.h * bounds.h);
+            bounds.x += 0.5f * bounds.w - radius;
+            bounds.y += 0.5f * bounds.h - radius;
+            bounds.w = bounds.h = 2.f * radius;
+        }
+        DirtyRects_addRect(dirtyRects, &bounds);
+    }
+    for (int i = 0; i < snapshot->m_gizmoCount; i++)
+    {
+        SDL_FRect bounds = { 0 };
+        Gizmos_getBounds(self->m_renderGizmos, snapshot->m_gizmos + i, &bounds);
+        DirtyRects_addRect(dirtyRects, &bounds);
+    }
+    if (ParticleSystem_getCount(self->m_particles) > 0)
+    {
+        AABB box = ParticleSystem_getBounds(self->m_particles);
+        SDL_FRect bounds = { 0 };
+        float x1, y1;
+        Camera_worldToView(self->m_camera, box.lower, &bounds.x, &y1);
+        Camera_worldToView(self->m_camera, box.upper, &x1, &bounds.y);
+        bounds.w = x1 - bounds.x;
+        bounds.h = y1 - bounds.y;
+        DirtyRects_addRect(dirtyRects, &bounds);
+    }
+    SDL_Rect uiRect = { 0 };
+    LevelUI_getBounds(self->m_ui, &uiRect);
+    SDL_FRect uiBounds = { (float)uiRect.x, (float)uiRect.y, (float)uiRect.w, (float)uiRect.h };
+    DirtyRects_addRect(dirtyRects, &uiBounds);
+
+    if (snapshot->m_sceneState != SCENE_STATE_RUNNING)
+    {
+        // Le fondu modifie toute l'image
+        DirtyRects_invalidate(dirtyRects);
+    }
+    DirtyRects_update(dirtyRects);
+
+    if (DirtyRects_isFullRedraw(dirtyRects))
+    {
+        SDL_RenderCopy(g_renderer, self->m_backgroundCache, NULL, NULL);
+    }
+    else
+    {
+        // Les rectangles sont disjoints, une copie par rectangle suffit
+        const SDL_Rect *rects = DirtyRects_getRects(dirtyRects);
+        int rectCount = DirtyRects_getRectCount(dirtyRects);
+        for (int i = 0; i < rectCount; i++)
+        {
+            SDL_RenderCopy(g_renderer, self->m_backgroundCache, rects + i, rects + i);
+        }
+    }
+    return true;
+}
+
+static void LevelScene_captureBackground(LevelScene *self, const RenderSnapshot *snapshot)
+{
+    // Les couches du fond sont composées avant de changer de cible
+    Parallax_update(self->m_parallax);
+
+    int width = Game_getWidth();
+    int height = Game_getHeight();
+    if (SoftBlitter_beginCapture(self->m_blitter, width, height) == false)
+    {
+        SDL_Color background = { 37, 37, 37, 255 };
+        SoftBlitter_clear(self->m_blitter, background);
+        return;
+    }
+
+    RenderState_setDrawColor(g_renderState, 37, 37, 37, 255);
+    SDL_RenderClear(g_renderer);
+    float scale = Camera_getWorldToViewScale(self->m_camera);
+    Parallax_render(self->m_parallax, snapshot->m_backgroundScroll * scale);
+
+    // Le fond est opaque : il remplace l'image précédente
+    SoftBlitter_endCapture(self->m_blitter, 0, 0, true);
+}
+
+static void LevelScene_updateParticles(LevelScene *self, const RenderSnapshot *snapshot)
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+    float delta = 0.f;
+    if (self->m_particleTime > 0)
+    {
+        delta = (float)(now - self->m_particleTime) / (float)SDL_GetPerformanceFrequency();
+    }
+    self->m_particleTime = now;
+    if (self->m_fixedRenderDelta > 0.f)
+    {
+        delta = self->m_fixedRenderDelta;
+    }
+
+    // Les particules sont figées pendant la pause
+    if (snapshot->m_paused)
+        return;
+    delta = fminf(delta, 0.1f);
+
+    // Chaque émission ponctuelle n'est traitée qu'une fois, même si
+    // l'instantané est rendu plusieurs fois
+    Uint32 burstCount = snapshot->m_burstCount;
+    if (burstCount < self->m_burstsEmitted)
+    {
+        // Retour arrière ou nouvelle partie
+        self->m_burstsEmitted = burstCount;
+    }
+    Uint32 first = self->m_burstsEmitted;
+    if (burstCount - first > RENDER_SNAPSHOT_BURST_CAPACITY)
+    {
+        first = burstCount - RENDER_SNAPSHOT_BURST_CAPACITY;
+    }
+    for (Uint32 i = first; i < burstCount; i++)
+    {
+        const ParticleBurst *burst = snapshot->m_bursts + (i % RENDER_SNAPSHOT_BURST_CAPACITY);
+        ParticleSystem_emit(
+            self->m_particles, ParticleEffects_get(burst->effect),
+            burst->position, burst->velocity, burst->count);
+    }
+    self->m_burstsEmitted = burstCount;
+
+    for (int i = 0; i < snapshot->m_emitterCount; i++)
+    {
+        const ParticleEmitterCommand *emitter = snapshot->m_emitters + i;
+        ParticleSystem_emitRate(
+            self->m_particles, ParticleEffects_get(emitter->effect),
+            emitter->position, emitter->velocity, emitter->rate, delta);
+    }
+
+    ParticleSystem_update(self->m_particles, delta);
+}
+
+static void LevelScene_updateSpriteScale(LevelScene *self)
+{
+    // En mode multi-thread, la simulation accède aux sprite sheets :
+    // elles ne sont pas rechargées pendant la boucle et gardent le facteur
+    // calculé au lancement du niveau
+    float scale = Game_getSpriteScale(
+        self->m_gameConfig, Camera_getWorldToViewScale(self->m_camera));
+    AssetManager_setSpriteScale(self->m_assets, scale);
+}
+
+static void LevelScene_invalidateRender(LevelScene *self)
+{
+    self->m_pauseFrameValid = false;
+    self->m_backgroundCacheValid = false;
+    Parallax_invalidate(self->m_parallax);
+    LevelUI_invalidate(self->m_ui);
+    RenderState_invalidate(g_renderState);
+    if (self->m_dirtyRects)
+    {
+        DirtyRects_invalidate(self->m_dirtyRects);
+    }
 }
 
 void LevelScene_drawGizmos(LevelScene *self)
@@ -409,6 +1496,13 @@ void LevelScene_drawGizmos(LevelScene *self)
 
     // Interface utilisateur
     LevelUI_drawGizmos(self->m_ui, gizmos);
+
+    // Nombre d'objets de la scène, en haut à gauche de la vue
+    AABB view = Camera_getVisibleAABB(self->m_camera);
+    char text[GIZMOS_TEXT_CAPACITY] = { 0 };
+    sprintf(text, "B%d E%d I%d", self->m_bulletCount, self->m_enemyCount, self->m_itemCount);
+    Gizmos_setColor(gizmos, g_colors.white);
+    Gizmos_drawText(gizmos, Vec2_set(view.lower.x + 0.1f, view.upper.y - 0.1f), text);
 }
 
 void LevelScene_addBullet(LevelScene *self, Bullet *bullet)
@@ -455,3 +1549,24 @@ void LevelScene_addItem(LevelScene *self, Item *item)
     Item_destroy(self->m_items[0]);
     self->m_items[0] = item;
 }
+
+void LevelScene_addBurst(LevelScene *self, int effect, Vec2 position, Vec2 velocity, int count)
+{
+    assert(self && "The LevelScene must be created");
+    assert(0 <= effect && effect < PARTICLE_EFFECT_COUNT);
+
+    ParticleBurst *burst = self->m_bursts + (self->m_burstCount % RENDER_SNAPSHOT_BURST_CAPACITY);
+    burst->effect = effect;
+    burst->count = count;
+    burst->position = position;
+    burst->velocity = velocity;
+    self->m_burstCount++;
+}
+
+void LevelScene_addExplosion(LevelScene *self, Vec2 position)
+{
+    assert(self && "The LevelScene must be created");
+    LevelScene_addBurst(self, PARTICLE_EFFECT_SPARKS, position, Vec2_zero, 80);
+    LevelScene_addBurst(self, PARTICLE_EFFECT_DEBRIS, position, Vec2_zero, 30);
+    LevelScene_addBurst(self, PARTICLE_EFFECT_SMOKE, position, Vec2_zero, 20);
+}
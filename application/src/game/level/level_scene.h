@@ -19,11 +19,26 @@
 #include "game/level/item.h"
 #include "game/level/level_ui.h"
 #include "game/level/level.h"
+#include "game/level/render_snapshot.h"
+#include "utils/rewind_buffer.h"
+#include "utils/parallax.h"
+#include "utils/dirty_rects.h"
+#include "utils/particles.h"
+#include "utils/dynamic_resolution.h"
+#include "utils/soft_blitter.h"
 
 #define ENEMY_CAPACITY 32
 #define ITEM_CAPACITY 8
 #define BULLET_CAPACITY 256
 
+/// @brief Nombre maximal de particules par texture.
+#define LEVEL_PARTICLE_CAPACITY 65536
+
+/// @brief Temps de rendu de la scène visé par la résolution dynamique
+/// (en millisecondes), inférieur à la durée d'une image à 60 FPS pour
+/// laisser de la marge à l'interface et à la présentation.
+#define LEVEL_RENDER_BUDGET_MS 10.f
+
 /// @brief Structure représentant la scène d'un niveau du jeu.
 typedef struct LevelScene
 {
@@ -34,6 +49,88 @@ typedef struct LevelScene
     Gizmos *m_gizmos;
     LevelUI *m_ui;
 
+    /// @brief Gizmos utilisés par le thread de rendu pour dessiner ceux
+    /// enregistrés dans un instantané.
+    Gizmos *m_renderGizmos;
+
+    /// @brief Lot utilisé pour dessiner les sprites de la scène.
+    SpriteBatch *m_spriteBatch;
+
+    /// @brief File utilisée pour trier les sprites avant leur dessin.
+    RenderQueue *m_renderQueue;
+
+    /// @brief Fond défilant du niveau (ressource du thread de rendu).
+    Parallax *m_parallax;
+
+    /// @brief Particules du niveau (ressource du thread de rendu).
+    /// Elles sont purement décoratives et ne font pas partie de l'état
+    /// sauvegardé de la scène.
+    ParticleSystem *m_particles;
+
+    /// @brief Nombre d'émissions ponctuelles déjà transmises aux particules.
+    Uint32 m_burstsEmitted;
+
+    /// @brief Instant de la dernière mise à jour des particules.
+    Uint64 m_particleTime;
+
+    /// @brief Durée fixe entre deux rendus utilisée pour les particules
+    /// (en secondes), ou 0 pour utiliser l'horloge réelle.
+    /// Une durée fixe rend les images reproductibles.
+    float m_fixedRenderDelta;
+
+    /// @brief Emissions ponctuelles de la simulation, dans un tampon
+    /// circulaire recopié dans chaque instantané.
+    ParticleBurst m_bursts[RENDER_SNAPSHOT_BURST_CAPACITY];
+    Uint32 m_burstCount;
+
+    /// @brief Instantané de rendu utilisé par la boucle mono-thread.
+    RenderSnapshot *m_snapshot;
+
+    /// @brief Nombre de pas de simulation effectués.
+    Uint64 m_tickCount;
+
+    /// @brief Statistiques d'élimination des objets hors de la vue :
+    /// nombre d'instantanés capturés, d'objets dessinés et d'objets éliminés.
+    Uint64 m_captureCount;
+    Uint64 m_drawnObjectCount;
+    Uint64 m_culledObjectCount;
+
+    /// @brief Nombre de pas de simulation effectués par image
+    /// (1 en vitesse normale).
+    int m_fastForwardTicks;
+
+    /// @brief Historique des états de la scène, une entrée par image.
+    /// Vaut NULL si le retour arrière n'est pas activé.
+    RewindBuffer *m_rewind;
+
+    /// @brief Sauvegarde temporaire utilisée par l'historique.
+    struct LevelSceneSave *m_rewindSave;
+
+    /// @brief Dernière image rendue avant la pause (cible de rendu).
+    /// Pendant la pause, seule cette texture et l'écran de pause sont dessinés.
+    SDL_Texture *m_pauseFrame;
+
+    /// @brief Booléen indiquant si m_pauseFrame contient l'image courante.
+    bool m_pauseFrameValid;
+
+    /// @brief Zones de l'écran à redessiner.
+    /// Vaut NULL si toute l'image est redessinée à chaque fois.
+    DirtyRects *m_dirtyRects;
+
+    /// @brief Fond figé restauré sous les zones modifiées (cible de rendu).
+    SDL_Texture *m_backgroundCache;
+
+    /// @brief Booléen indiquant si m_backgroundCache contient le fond.
+    bool m_backgroundCacheValid;
+
+    /// @brief Résolution dynamique du rendu de la scène, ou NULL si la
+    /// scène est dessinée directement à la résolution du rendu.
+    DynamicResolution *m_dynamicRes;
+
+    /// @brief Moteur de rendu logiciel des sprites, ou NULL si les sprites
+    /// sont dessinés par la SDL. Le fond y est recopié avant les sprites.
+    SoftBlitter *m_blitter;
+
     Level *m_level;
 
     Player *m_players[MAX_PLAYER_COUNT];
@@ -54,6 +151,40 @@ typedef struct LevelScene
     float m_fadingTime;
 } LevelScene;
 
+/// @brief Structure représentant une sauvegarde complète de l'état de la
+/// simulation d'une scène de niveau.
+/// Elle a une taille fixe et ne contient aucun pointeur : elle peut être
+/// copiée, comparée ou compressée octet par octet. Les emplacements
+/// inutilisés des tableaux sont remis à zéro.
+typedef struct LevelSceneSave
+{
+    /// @brief Nombre de pas de simulation effectués.
+    Uint64 m_tickCount;
+
+    /// @brief Temps écoulés du temps global du jeu (en millisecondes).
+    Uint64 m_elapsed;
+    Uint64 m_unscaledElapsed;
+
+    /// @brief Etat de la scène et avancement du fondu.
+    int m_state;
+    float m_accu;
+    float m_fadingTime;
+
+    LevelRecord m_level;
+
+    PlayerRecord m_players[MAX_PLAYER_COUNT];
+    int m_playerCount;
+
+    EnemyRecord m_enemies[ENEMY_CAPACITY];
+    int m_enemyCount;
+
+    BulletRecord m_bullets[BULLET_CAPACITY];
+    int m_bulletCount;
+
+    ItemRecord m_items[ITEM_CAPACITY];
+    int m_itemCount;
+} LevelSceneSave;
+
 /// @brief Crée la scène représentant un niveau du jeu.
 /// @param gameConfig la configuration globale du jeu.
 /// @return La scène créée.
@@ -68,21 +199,64 @@ void LevelScene_destroy(LevelScene *self);
 /// @param drawGizmos booléen indiquant s'il faut dessiner les gizmos.
 void LevelScene_mainLoop(LevelScene *self, bool drawGizmos);
 
-/// @brief Met à jour la scène.
-/// Cette fonction est appelée à chaque tour de la boucle de rendu.
+/// @brief Effectue un pas de simulation de la scène, sans lire les entrées
+/// utilisateur ni appeler le moteur de rendu.
+/// @param self la scène.
+void LevelScene_step(LevelScene *self);
+
+/// @brief Effectue les pas de simulation correspondant à une image.
+/// En vitesse normale, un unique pas utilise le temps réellement écoulé.
+/// En avance rapide, plusieurs pas de durée fixe sont enchaînés et les
+/// effets sonores des pas intermédiaires sont coupés.
+/// Si le retour arrière est maintenu, l'état de l'image précédente est
+/// restauré à la place.
+/// Les entrées utilisateur doivent avoir été lues auparavant.
+/// @param self la scène.
+void LevelScene_advance(LevelScene *self);
+
+/// @brief Active ou désactive l'avance rapide de la scène.
+/// @param self la scène.
+/// @param enabled booléen indiquant si l'avance rapide est active.
+void LevelScene_setFastForward(LevelScene *self, bool enabled);
+
+/// @brief Produit l'instantané de rendu de l'état courant de la scène.
+/// Cette fonction n'appelle pas le moteur de rendu et peut être exécutée
+/// par le thread de simulation.
+/// @param self la scène.
+/// @param snapshot l'instantané à remplir.
+/// @param drawGizmos booléen indiquant s'il faut enregistrer les gizmos.
+void LevelScene_capture(LevelScene *self, RenderSnapshot *snapshot, bool drawGizmos);
+
+/// @brief Sauvegarde l'état de la simulation de la scène.
+/// Cela comprend les joueurs, les ennemis, les projectiles, les objets,
+/// la vague du niveau, le fondu et le temps global du jeu.
+/// La pause et l'échelle du temps, qui dépendent de l'interface,
+/// ne sont pas sauvegardées.
 /// @param self la scène.
-void LevelScene_update(LevelScene *self);
+/// @param save la sauvegarde à remplir.
+void LevelScene_saveState(LevelScene *self, LevelSceneSave *save);
+
+/// @brief Restaure l'état de la simulation de la scène.
+/// Les entités existantes sont réutilisées, seules les entités manquantes
+/// sont allouées. Cette fonction peut être appelée à chaque image.
+/// @param self la scène.
+/// @param save la sauvegarde produite par LevelScene_saveState().
+void LevelScene_restoreState(LevelScene *self, const LevelSceneSave *save);
 
 /// @brief Active l'animation de fin de scène.
 /// La boucle principale s'arrête une fois l'animation terminée.
 /// @param self la scène.
 void LevelScene_quit(LevelScene *self);
 
-/// @brief Dessine la scène dans le moteur de rendu.
+/// @brief Dessine un instantané de la scène dans le moteur de rendu.
+/// Si le niveau est en pause, l'image est rendue une seule fois dans une
+/// texture puis réutilisée jusqu'à la fin de la pause.
 /// @param self la scène.
-void LevelScene_render(LevelScene *self);
+/// @param snapshot l'instantané produit par LevelScene_capture().
+void LevelScene_render(LevelScene *self, const RenderSnapshot *snapshot);
 
-/// @brief Dessine les gizmos de la scène dans le moteur de rendu.
+/// @brief Dessine les gizmos de la scène.
+/// Lors d'une capture, les gizmos sont enregistrés dans l'instantané.
 /// @param self 
 void LevelScene_drawGizmos(LevelScene *self);
 
@@ -101,6 +275,19 @@ void LevelScene_addEnemy(LevelScene *self, Enemy *enemy);
 /// @param item l'objet à ajouter.
 void LevelScene_addItem(LevelScene *self, Item *item);
 
+/// @brief Emet ponctuellement des particules.
+/// @param self la scène.
+/// @param effect l'effet (ParticleEffectID).
+/// @param position la position d'émission dans le référentiel monde.
+/// @param velocity la vitesse transmise aux particules.
+/// @param count le nombre de particules.
+void LevelScene_addBurst(LevelScene *self, int effect, Vec2 position, Vec2 velocity, int count);
+
+/// @brief Déclenche une explosion (étincelles, débris et fumée).
+/// @param self la scène.
+/// @param position la position de l'explosion dans le référentiel monde.
+void LevelScene_addExplosion(LevelScene *self, Vec2 position);
+
 /// @brief Renvoie la configuration globale du jeu.
 /// @param self la scène.
 /// @return La configuration globale du jeu.
@@ -32,6 +32,10 @@ LevelUI *LevelUI_create(LevelScene *scene)
     self->m_hHealth = h;
     self->m_wHealth = w;
 
+    SDL_Rect bounds = { 0 };
+    LevelUI_getBounds(self, &bounds);
+    self->m_panel = UIPanel_create(g_renderer, bounds.w, bounds.h, false);
+
     return self;
 }
 
@@ -44,66 +48,92 @@ void LevelUI_destroy(LevelUI *self)
         Text_destroy(self->m_healths[i]);
     }
     Text_destroy(self->m_textPause);
+    UIPanel_destroy(self->m_panel);
 
     free(self);
 }
 
-void LevelUI_render(LevelUI *self)
+void LevelUI_render(LevelUI *self, const RenderSnapshot *snapshot)
 {
-    LevelScene *scene = self->m_scene;
-    AssetManager *assets = LevelScene_getAssetManager(scene);
-    const int playerCount = LevelScene_getPlayerCount(scene);
+    const int playerCount = snapshot->m_playerCount;
 
-    int w, h;
-    SDL_Rect dst = { 0 };
-    SDL_Texture *texture = NULL;
-    const int xMargin = 20;
-    const int yMargin = 20;
-    const int xPadding = 20;
-    const int yPadding = 10;
-    const int wUI = self->m_wHealth + 2 * xPadding;
-    const int hUI = 2 * self->m_hHealth + 2 * yPadding;
-
-    int x = xMargin;
-    int y = yMargin;
-
-    Game_setRenderDrawColor(g_colors.magenta, 127);
-    dst.x = x;
-    dst.y = y;
-    dst.w = wUI;
-    dst.h = hUI;
-    SDL_RenderFillRect(g_renderer, &dst);
-
-    x += xPadding;
-    y += yPadding;
+    // Les textes sont mis à jour sur le thread de rendu à partir de
+    // l'instantané (la création de textures est réservée à ce thread)
+    for (int i = 0; i < playerCount; i++)
+    {
+        char buffer[128] = { 0 };
+        sprintf(buffer, u8"%d%%", snapshot->m_playerHP[i]);
+        Text_setString(self->m_healths[i], buffer);
+    }
 
+    // Le panneau n'est recomposé que si un texte a changé
+    Uint64 key = UIPanel_hash(0, playerCount);
+    key = UIPanel_hashColor(key, g_colors.magenta);
     for (int i = 0; i < playerCount; i++)
     {
-        // Health (value)
-        texture = Text_getTexture(self->m_healths[i]);
-        SDL_QueryTexture(texture, NULL, NULL, &w, &h);
-        dst.x = x;
-        dst.y = y;
-        dst.w = w;
-        dst.h = h;
-        SDL_RenderCopy(g_renderer, texture, NULL, &dst);
-
-        y += self->m_hHealth;
+        key = UIPanel_hash(key, Text_getVersion(self->m_healths[i]));
     }
 
-    if (self->m_paused)
+    SDL_Rect bounds = { 0 };
+    LevelUI_getBounds(self, &bounds);
+    if (UIPanel_beginCompose(self->m_panel, key, bounds.x, bounds.y))
     {
-        Game_setRenderDrawColor(g_colors.blue, 127);
-        SDL_RenderFillRect(g_renderer, NULL);
-
-        texture = Text_getTexture(self->m_textPause);
-        SDL_QueryTexture(texture, NULL, NULL, &w, &h);
-        dst.x = Game_getWidth() / 2 - w / 2;
-        dst.y = Game_getHeight() / 2 - h / 2;
-        dst.w = w;
-        dst.h = h;
-        SDL_RenderCopy(g_renderer, texture, NULL, &dst);
+        SDL_Rect dst = { 0, 0, bounds.w, bounds.h };
+        Game_setRenderDrawColor(g_colors.magenta, 127);
+        SDL_RenderFillRect(g_renderer, &dst);
+
+        int x = LEVEL_UI_PADDING_X;
+        int y = LEVEL_UI_PADDING_Y;
+
+        for (int i = 0; i < playerCount; i++)
+        {
+            // Health (value)
+            Text *text = self->m_healths[i];
+            dst.x = x;
+            dst.y = y;
+            dst.w = Text_getWidth(text);
+            dst.h = Text_getHeight(text);
+            SDL_RenderCopy(g_renderer, Text_getTexture(text), NULL, &dst);
+
+            y += self->m_hHealth;
+        }
+        UIPanel_endCompose(self->m_panel);
     }
+    UIPanel_render(self->m_panel);
+}
+
+void LevelUI_invalidate(LevelUI *self)
+{
+    assert(self && "The LevelUI must be created");
+    UIPanel_invalidate(self->m_panel);
+}
+
+void LevelUI_getBounds(LevelUI *self, SDL_Rect *bounds)
+{
+    assert(self && "The LevelUI must be created");
+    assert(bounds);
+    bounds->x = LEVEL_UI_MARGIN;
+    bounds->y = LEVEL_UI_MARGIN;
+    bounds->w = self->m_wHealth + 2 * LEVEL_UI_PADDING_X;
+    bounds->h = 2 * self->m_hHealth + 2 * LEVEL_UI_PADDING_Y;
+}
+
+void LevelUI_renderPause(LevelUI *self)
+{
+    int w, h;
+    SDL_Rect dst = { 0 };
+    SDL_Texture *texture = NULL;
+
+    Game_setRenderDrawColor(g_colors.blue, 127);
+    SDL_RenderFillRect(g_renderer, NULL);
+
+    texture = Text_getTexture(self->m_textPause);
+    SDL_QueryTexture(texture, NULL, NULL, &w, &h);
+    dst.x = Game_getWidth() / 2 - w / 2;
+    dst.y = Game_getHeight() / 2 - h / 2;
+    dst.w = w;
+    dst.h = h;
+    SDL_RenderCopy(g_renderer, texture, NULL, &dst);
 }
 
 void LevelUI_update(LevelUI *self)
@@ -112,16 +142,6 @@ void LevelUI_update(LevelUI *self)
     AssetManager *assets = LevelScene_getAssetManager(scene);
     Input *input = LevelScene_getInput(scene);
 
-    int playerCount = LevelScene_getPlayerCount(scene);
-    for (int i = 0; i < playerCount; i++)
-    {
-        Player *player = LevelScene_getPlayer(scene, i);
-        char buffer[128] = { 0 };
-        sprintf(buffer, u8"%d%%", player->m_hp);
-        Text_setString(self->m_healths[i], buffer);
-    }
-
-
     if ((scene->m_level->m_state == LEVEL_STATE_COMPLETED) ||
         (scene->m_level->m_state == LEVEL_STATE_FAILED))
     {
@@ -131,11 +151,33 @@ void LevelUI_update(LevelUI *self)
     {
         if (input->pausePressed)
         {
-            self->m_paused = !self->m_paused;
-            float scale = self->m_paused ? 0.f : 1.f;
-            Timer_setTimeScale(g_time, scale);
+            LevelUI_setPaused(self, !self->m_paused);
             Game_playSoundFX(assets, SOUND_UI_PAUSE);
         }
+        else if (input->windowMinimized)
+        {
+            LevelUI_autoPause(self);
+        }
+    }
+}
+
+void LevelUI_setPaused(LevelUI *self, bool paused)
+{
+    self->m_paused = paused;
+    float scale = self->m_paused ? 0.f : 1.f;
+    Timer_setTimeScale(g_time, scale);
+}
+
+void LevelUI_autoPause(LevelUI *self)
+{
+    LevelScene *scene = self->m_scene;
+    if (scene->m_gameConfig->headless)
+        return;
+    if (scene->m_level->m_state != LEVEL_STATE_PLAYING)
+        return;
+    if (self->m_paused == false)
+    {
+        LevelUI_setPaused(self, true);
     }
 }
 
@@ -9,10 +9,17 @@
 #include "settings.h"
 #include "utils/text.h"
 #include "utils/gizmos.h"
+#include "utils/ui_panel.h"
 #include "game/game_common.h"
+#include "game/level/render_snapshot.h"
 
 typedef struct LevelScene LevelScene;
 
+/// @brief Marge et espacements du panneau de santé (en pixels).
+#define LEVEL_UI_MARGIN 20
+#define LEVEL_UI_PADDING_X 20
+#define LEVEL_UI_PADDING_Y 10
+
 typedef struct LevelUI
 {
     /// @brief Pointeur vers la scène du niveau.
@@ -32,11 +39,35 @@ typedef struct LevelUI
 
     /// @brief Booléen indiquant si le niveau est en pause.
     bool m_paused;
+
+    /// @brief Panneau de santé mis en cache.
+    UIPanel *m_panel;
 } LevelUI;
 
 LevelUI *LevelUI_create(LevelScene *scene);
 void LevelUI_destroy(LevelUI *self);
 
-void LevelUI_render(LevelUI *self);
+void LevelUI_render(LevelUI *self, const RenderSnapshot *snapshot);
+void LevelUI_renderPause(LevelUI *self);
+
+/// @brief Renvoie le rectangle occupé par l'interface pendant la partie.
+/// @param self l'interface du niveau.
+/// @param bounds le rectangle occupé (en pixels).
+void LevelUI_getBounds(LevelUI *self, SDL_Rect *bounds);
 void LevelUI_update(LevelUI *self);
+
+/// @brief Force la recomposition des panneaux de l'interface,
+/// par exemple après un événement SDL_RENDER_TARGETS_RESET.
+/// @param self l'interface du niveau.
+void LevelUI_invalidate(LevelUI *self);
+
+/// @brief Met le niveau en pause ou le relance.
+/// @param self l'interface du niveau.
+/// @param paused booléen indiquant si le niveau est en pause.
+void LevelUI_setPaused(LevelUI *self, bool paused);
+
+/// @brief Met le niveau en pause s'il est en cours de partie.
+/// Utilisée lorsque la fenêtre est minimisée.
+/// @param self l'interface du niveau.
+void LevelUI_autoPause(LevelUI *self);
 void LevelUI_drawGizmos(LevelUI *self, Gizmos *gizmos);
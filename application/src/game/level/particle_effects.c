@@ -0,0 +1,57 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "game/level/particle_effects.h"
+
+// Tailles et vitesses dans le référentiel monde (16 unités de large)
+static const ParticleParams g_particleEffects[PARTICLE_EFFECT_COUNT] = {
+    [PARTICLE_EFFECT_PLAYER_ENGINE] = {
+        .texture = PARTICLE_TEXTURE_SPARK,
+        .angle = 180.f, .spread = 8.f,
+        .speedMin = 1.5f, .speedMax = 2.5f, .drag = 1.f,
+        .lifeMin = 0.2f, .lifeMax = 0.4f,
+        .sizeStart = 0.15f, .sizeEnd = 0.05f,
+        .colorStart = { 255, 200, 80, 255 }, .colorEnd = { 255, 60, 20, 0 },
+    },
+    [PARTICLE_EFFECT_FIGHTER_ENGINE] = {
+        .texture = PARTICLE_TEXTURE_SPARK,
+        .angle = 0.f, .spread = 8.f,
+        .speedMin = 1.f, .speedMax = 2.f, .drag = 1.f,
+        .lifeMin = 0.15f, .lifeMax = 0.3f,
+        .sizeStart = 0.12f, .sizeEnd = 0.04f,
+        .colorStart = { 120, 200, 255, 255 }, .colorEnd = { 40, 60, 255, 0 },
+    },
+    [PARTICLE_EFFECT_SPARKS] = {
+        .texture = PARTICLE_TEXTURE_SPARK,
+        .angle = 0.f, .spread = 180.f,
+        .speedMin = 2.f, .speedMax = 6.f, .drag = 2.f,
+        .lifeMin = 0.3f, .lifeMax = 0.7f,
+        .sizeStart = 0.12f, .sizeEnd = 0.02f,
+        .colorStart = { 255, 240, 180, 255 }, .colorEnd = { 255, 80, 0, 0 },
+    },
+    [PARTICLE_EFFECT_DEBRIS] = {
+        .texture = PARTICLE_TEXTURE_SMOKE,
+        .angle = 0.f, .spread = 180.f,
+        .speedMin = 1.f, .speedMax = 3.f, .drag = 0.5f,
+        .lifeMin = 0.6f, .lifeMax = 1.2f,
+        .sizeStart = 0.08f, .sizeEnd = 0.08f,
+        .colorStart = { 150, 140, 130, 255 }, .colorEnd = { 80, 70, 60, 0 },
+    },
+    [PARTICLE_EFFECT_SMOKE] = {
+        .texture = PARTICLE_TEXTURE_SMOKE,
+        .angle = 0.f, .spread = 180.f,
+        .speedMin = 0.2f, .speedMax = 0.8f, .drag = 1.5f,
+        .lifeMin = 0.8f, .lifeMax = 1.6f,
+        .sizeStart = 0.4f, .sizeEnd = 1.2f,
+        .colorStart = { 90, 90, 90, 160 }, .colorEnd = { 40, 40, 40, 0 },
+    },
+};
+
+const ParticleParams *ParticleEffects_get(int effect)
+{
+    assert(0 <= effect && effect < PARTICLE_EFFECT_COUNT);
+    return g_particleEffects + effect;
+}
@@ -0,0 +1,26 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+#include "utils/particles.h"
+
+/// @brief Effets de particules du jeu.
+typedef enum ParticleEffectID
+{
+    PARTICLE_EFFECT_PLAYER_ENGINE,
+    PARTICLE_EFFECT_FIGHTER_ENGINE,
+    PARTICLE_EFFECT_SPARKS,
+    PARTICLE_EFFECT_DEBRIS,
+    PARTICLE_EFFECT_SMOKE,
+    PARTICLE_EFFECT_COUNT
+} ParticleEffectID;
+
+/// @brief Renvoie les paramètres d'un effet de particules.
+/// @param effect l'identifiant de l'effet (ParticleEffectID).
+/// @return Les paramètres de l'effet.
+const ParticleParams *ParticleEffects_get(int effect);
@@ -21,6 +21,10 @@ Player *Player_create(LevelScene *levelScene, int playerID)
     self->m_state = PLAYER_STATE_FLYING;
     self->m_hp = PLAYER_MAX_HP;
 
+    self->m_engineEmitter.effect = PARTICLE_EFFECT_PLAYER_ENGINE;
+    self->m_engineEmitter.offset = Vec2_set(-0.45f, 0.f);
+    self->m_engineEmitter.rate = 120.f;
+
     /* TODO : Affichage du joueur
     SpriteSheet *spriteSheet = NULL;
     spriteSheet = AssetManager_getSpriteSheet(assets, SPRITE_PLAYER_POWERING);
@@ -97,14 +101,13 @@ void Player_update(Player *self)
     //*/
 }
 
-void Player_render(Player *self)
+void Player_render(Player *self, RenderSnapshot *snapshot)
 {
     // On récupère des infos essentielles
     LevelScene *scene = self->m_scene;
     AssetManager *assets = LevelScene_getAssetManager(scene);
     Camera *camera = LevelScene_getCamera(scene);
     double angle = 90.0;
-    SpriteSheet *spriteSheet = NULL;
     int index = 0;
 
     // On calcule la position en pixels en fonction de la position 
@@ -118,21 +121,28 @@ void Player_render(Player *self)
     dst.x -= 0.50f * dst.w;
     dst.y -= 0.50f * dst.h;
 
+    if (self->m_state == PLAYER_STATE_FLYING)
+    {
+        RenderSnapshot_addEmitter(snapshot, &(self->m_engineEmitter), self->m_position, self->m_velocity);
+    }
+
+    // Les trois sprites se superposent : la profondeur garde leur ordre
+    // quelle que soit la texture utilisée
     /* TODO : Affichage du joueur
     // Vaisseau
-    spriteSheet = AssetManager_getSpriteSheet(assets, SPRITE_PLAYER);
+    RenderSnapshot_setDepth(snapshot, 2);
     index = 0;
-    SpriteSheet_renderCopyF(spriteSheet, index, g_renderer, &dst, angle, NULL, 0);
+    RenderSnapshot_addSprite(snapshot, SPRITE_PLAYER, index, &dst, angle, 0);
 
     // Propulsion - flammes
-    spriteSheet = AssetManager_getSpriteSheet(assets, SPRITE_PLAYER_POWERING);
+    RenderSnapshot_setDepth(snapshot, 1);
     index = 0;
-    SpriteSheet_renderCopyF(spriteSheet, index, g_renderer, &dst, angle, NULL, 0);
+    RenderSnapshot_addSprite(snapshot, SPRITE_PLAYER_POWERING, index, &dst, angle, 0);
 
     // Réacteurs
-    spriteSheet = AssetManager_getSpriteSheet(assets, SPRITE_PLAYER_ENGINE);
+    RenderSnapshot_setDepth(snapshot, 0);
     index = 0;
-    SpriteSheet_renderCopyF(spriteSheet, index, g_renderer, &dst, angle, NULL, 0);
+    RenderSnapshot_addSprite(snapshot, SPRITE_PLAYER_ENGINE, index, &dst, angle, 0);
     //*/
 }
 
@@ -152,3 +162,37 @@ PlayerInput Player_getInput(Player *self)
     Input *input = LevelScene_getInput(self->m_scene);
     return input->players[self->m_playerID];
 }
+
+void Player_save(Player *self, PlayerRecord *record)
+{
+    assert(self && record);
+    record->position = self->m_position;
+    record->velocity = self->m_velocity;
+    record->radius = self->m_radius;
+    record->accuBullet = self->m_accuBullet;
+    record->state = self->m_state;
+    record->hp = self->m_hp;
+    record->playerID = self->m_playerID;
+    record->score = self->m_score;
+
+    /* TODO : Affichage du joueur
+    record->animEngine = *(self->m_animEngine);
+    //*/
+}
+
+void Player_restore(Player *self, const PlayerRecord *record)
+{
+    assert(self && record);
+    self->m_position = record->position;
+    self->m_velocity = record->velocity;
+    self->m_radius = record->radius;
+    self->m_accuBullet = record->accuBullet;
+    self->m_state = record->state;
+    self->m_hp = record->hp;
+    self->m_playerID = record->playerID;
+    self->m_score = record->score;
+
+    /* TODO : Affichage du joueur
+    *(self->m_animEngine) = record->animEngine;
+    //*/
+}
@@ -11,6 +11,7 @@
 #include "utils/sprite_anim.h"
 #include "utils/gizmos.h"
 #include "game/game_common.h"
+#include "game/level/render_snapshot.h"
 #include "game/input.h"
 
 #define PLAYER_MAX_HP 100
@@ -56,17 +57,38 @@ typedef struct Player
 
     /// @brief Accumulateur pour les tirs par défaut.
     float m_accuBullet;
+
+    /// @brief Traînée de particules des réacteurs.
+    ParticleEmitter m_engineEmitter;
 } Player;
 
+/// @brief Etat d'un joueur sans pointeur, utilisé pour la sauvegarde
+/// de la scène.
+typedef struct PlayerRecord
+{
+    Vec2 position;
+    Vec2 velocity;
+    float radius;
+    float accuBullet;
+    int state;
+    int hp;
+    int playerID;
+    int score;
+    SpriteAnim animEngine;
+} PlayerRecord;
+
 Player *Player_create(LevelScene *levelScene, int playerID);
 void Player_destroy(Player *self);
 
 void Player_update(Player *self);
-void Player_render(Player *self);
+void Player_render(Player *self, RenderSnapshot *snapshot);
 void Player_drawGizmos(Player *self, Gizmos *gizmos);
 
 void Player_damage(Player *self, int damage);
 
+void Player_save(Player *self, PlayerRecord *record);
+void Player_restore(Player *self, const PlayerRecord *record);
+
 INLINE void Player_addPoints(Player *self, int points)
 {
     self->m_score += points;
@@ -0,0 +1,116 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "game/level/render_snapshot.h"
+#include "utils/common.h"
+
+void RenderSnapshot_clear(RenderSnapshot *self)
+{
+    assert(self && "The RenderSnapshot must be created");
+    self->m_spriteCount = 0;
+    self->m_gizmoCount = 0;
+    self->m_emitterCount = 0;
+    self->m_layer = RENDER_LAYER_BACKGROUND;
+    self->m_depth = 0;
+}
+
+void RenderSnapshot_setLayer(RenderSnapshot *self, int layer)
+{
+    assert(self && "The RenderSnapshot must be created");
+    assert(0 <= layer && layer < RENDER_LAYER_COUNT);
+    self->m_layer = layer;
+    self->m_depth = 0;
+}
+
+void RenderSnapshot_setDepth(RenderSnapshot *self, int depth)
+{
+    assert(self && "The RenderSnapshot must be created");
+    assert(0 <= depth && depth <= 0xFFFF);
+    self->m_depth = depth;
+}
+
+void RenderSnapshot_addSprite(
+    RenderSnapshot *self, int sheetID, int index,
+    const SDL_FRect *dstRect, double angle, SDL_RendererFlip flip)
+{
+    assert(self && "The RenderSnapshot must be created");
+    assert(sheetID >= 0 && dstRect);
+    if (self->m_spriteCount >= RENDER_SNAPSHOT_SPRITE_CAPACITY)
+    {
+        assert(false && "RENDER_SNAPSHOT_SPRITE_CAPACITY exceeded");
+        return;
+    }
+
+    SpriteCommand *command = self->m_sprites + self->m_spriteCount++;
+    command->sheetID = sheetID;
+    command->index = index;
+    command->dst = *dstRect;
+    command->angle = angle;
+    command->flip = flip;
+    command->layer = (Uint8)self->m_layer;
+    command->depth = (Uint16)self->m_depth;
+}
+
+void RenderSnapshot_addEmitter(
+    RenderSnapshot *self, const ParticleEmitter *emitter, Vec2 position, Vec2 velocity)
+{
+    assert(self && "The RenderSnapshot must be created");
+    assert(emitter);
+    if (emitter->rate <= 0.f)
+        return;
+    if (self->m_emitterCount >= RENDER_SNAPSHOT_EMITTER_CAPACITY)
+    {
+        assert(false && "RENDER_SNAPSHOT_EMITTER_CAPACITY exceeded");
+        return;
+    }
+
+    ParticleEmitterCommand *command = self->m_emitters + self->m_emitterCount++;
+    command->effect = emitter->effect;
+    command->position = Vec2_add(position, emitter->offset);
+    command->velocity = velocity;
+    command->rate = emitter->rate;
+}
+
+void RenderSnapshot_renderSprites(
+    const RenderSnapshot *self, AssetManager *assets,
+    RenderQueue *queue, SpriteBatch *batch)
+{
+    assert(self && "The RenderSnapshot must be created");
+    assert(assets && "The AssetManager must be created");
+    assert(queue && "The RenderQueue must be created");
+    assert(batch && "The SpriteBatch must be created");
+
+    RenderQueue_clear(queue);
+    for (int i = 0; i < self->m_spriteCount; i++)
+    {
+        const SpriteCommand *command = self->m_sprites + i;
+        SpriteSheet *spriteSheet = AssetManager_getSpriteSheet(assets, command->sheetID);
+        SDL_Texture *texture = spriteSheet->texture;
+        SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+        SDL_GetTextureBlendMode(texture, &blendMode);
+        RenderQueue_push(queue, command->layer, command->depth, texture, blendMode, i);
+    }
+    RenderQueue_sort(queue);
+
+    int count = RenderQueue_getCount(queue);
+    for (int i = 0; i < count; i++)
+    {
+        const SpriteCommand *command = self->m_sprites + RenderQueue_getCommand(queue, i);
+        SpriteSheet *spriteSheet = AssetManager_getSpriteSheet(assets, command->sheetID);
+        SpriteBatch_drawSprite(
+            batch, spriteSheet, command->index,
+            &(command->dst), command->angle, command->flip
+        );
+    }
+    SpriteBatch_flush(batch);
+}
+
+void RenderSnapshot_renderGizmos(const RenderSnapshot *self, Gizmos *gizmos)
+{
+    assert(self && "The RenderSnapshot must be created");
+    assert(gizmos && "The Gizmos must be created");
+    Gizmos_render(gizmos, self->m_gizmos, self->m_gizmoCount);
+}
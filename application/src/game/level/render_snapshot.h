@@ -0,0 +1,182 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+#include "utils/asset_manager.h"
+#include "utils/gizmos.h"
+#include "utils/sprite_batch.h"
+#include "utils/render_queue.h"
+#include "game/game_common.h"
+#include "game/level/particle_effects.h"
+
+#define RENDER_SNAPSHOT_SPRITE_CAPACITY 512
+#define RENDER_SNAPSHOT_GIZMO_CAPACITY 512
+#define RENDER_SNAPSHOT_EMITTER_CAPACITY 64
+#define RENDER_SNAPSHOT_BURST_CAPACITY 64
+
+/// @brief Couches de rendu d'un niveau, dessinées dans l'ordre croissant.
+typedef enum RenderLayer
+{
+    RENDER_LAYER_BACKGROUND = 0,
+    RENDER_LAYER_BULLETS,
+    RENDER_LAYER_ITEMS,
+    RENDER_LAYER_ENEMIES,
+    RENDER_LAYER_PLAYERS,
+    RENDER_LAYER_EFFECTS,
+    RENDER_LAYER_COUNT
+} RenderLayer;
+
+/// @brief Structure représentant la copie d'un sprite vers le rendu.
+/// Les paramètres sont ceux de SpriteSheet_renderCopyF(), la sprite sheet
+/// étant désignée par son identifiant et résolue par le thread de rendu.
+typedef struct SpriteCommand
+{
+    int sheetID;
+    int index;
+    SDL_FRect dst;
+    double angle;
+    SDL_RendererFlip flip;
+
+    /// @brief Couche (RenderLayer) et profondeur dans la couche.
+    Uint8 layer;
+    Uint16 depth;
+} SpriteCommand;
+
+/// @brief Structure représentant un émetteur de particules continu
+/// attaché à un objet de la simulation (joueur, ennemi).
+typedef struct ParticleEmitter
+{
+    /// @brief Effet émis (ParticleEffectID).
+    int effect;
+
+    /// @brief Position de l'émetteur relativement à l'objet.
+    Vec2 offset;
+
+    /// @brief Débit (en particules par seconde), 0 pour un émetteur inactif.
+    float rate;
+} ParticleEmitter;
+
+/// @brief Structure représentant un émetteur actif dans un instantané.
+typedef struct ParticleEmitterCommand
+{
+    int effect;
+    Vec2 position;
+    Vec2 velocity;
+    float rate;
+} ParticleEmitterCommand;
+
+/// @brief Structure représentant une émission ponctuelle de particules
+/// (explosion).
+typedef struct ParticleBurst
+{
+    int effect;
+    int count;
+    Vec2 position;
+    Vec2 velocity;
+} ParticleBurst;
+
+/// @brief Structure représentant un instantané immuable de tout ce qui est
+/// nécessaire pour dessiner une image du niveau.
+/// Il est produit par la simulation et consommé par le thread de rendu,
+/// sans aucun pointeur vers les objets de la simulation.
+typedef struct RenderSnapshot
+{
+    /// @brief Numéro du pas de simulation ayant produit l'instantané.
+    Uint64 m_tick;
+
+    /// @brief Sprites à dessiner, dans l'ordre.
+    SpriteCommand m_sprites[RENDER_SNAPSHOT_SPRITE_CAPACITY];
+    int m_spriteCount;
+
+    /// @brief Couche et profondeur attribuées aux prochains sprites ajoutés.
+    int m_layer;
+    int m_depth;
+
+    /// @brief Défilement du fond (dans le référentiel monde).
+    float m_backgroundScroll;
+
+    /// @brief Commandes enregistrées par les gizmos.
+    GizmoCommand m_gizmos[RENDER_SNAPSHOT_GIZMO_CAPACITY];
+    int m_gizmoCount;
+
+    /// @brief Emetteurs de particules continus.
+    ParticleEmitterCommand m_emitters[RENDER_SNAPSHOT_EMITTER_CAPACITY];
+    int m_emitterCount;
+
+    /// @brief Dernières émissions ponctuelles, dans un tampon circulaire.
+    /// L'émission numéro n se trouve à l'indice n % RENDER_SNAPSHOT_BURST_CAPACITY.
+    /// Le rendu peut ainsi traiter chaque émission une seule fois, même si
+    /// certains instantanés ne sont jamais rendus.
+    ParticleBurst m_bursts[RENDER_SNAPSHOT_BURST_CAPACITY];
+    Uint32 m_burstCount;
+
+    /// @brief Points de vie de chaque joueur.
+    int m_playerHP[MAX_PLAYER_COUNT];
+    int m_playerCount;
+
+    /// @brief Booléen indiquant si le niveau est en pause.
+    bool m_paused;
+
+    /// @brief Etat de la scène (SceneState) et avancement du fondu.
+    int m_sceneState;
+    float m_accu;
+    float m_fadingTime;
+} RenderSnapshot;
+
+/// @brief Vide la liste des sprites et des gizmos d'un instantané.
+/// @param self l'instantané.
+void RenderSnapshot_clear(RenderSnapshot *self);
+
+/// @brief Définit la couche des prochains sprites ajoutés à un instantané.
+/// La profondeur est remise à zéro.
+/// @param self l'instantané.
+/// @param layer la couche (RenderLayer).
+void RenderSnapshot_setLayer(RenderSnapshot *self, int layer);
+
+/// @brief Définit la profondeur des prochains sprites ajoutés à un
+/// instantané. Dans une couche, les sprites les plus profonds sont
+/// dessinés en premier.
+/// @param self l'instantané.
+/// @param depth la profondeur (entre 0 et 65535).
+void RenderSnapshot_setDepth(RenderSnapshot *self, int depth);
+
+/// @brief Ajoute un sprite à dessiner à un instantané.
+/// Le sprite est placé dans la couche et à la profondeur courantes.
+/// @param self l'instantané.
+/// @param sheetID l'identifiant de la sprite sheet.
+/// @param index indice du sprite à copier.
+/// @param dstRect le rectangle de destination sur le rendu.
+/// @param angle l'angle de rotation, en degrés.
+/// @param flip flag indiquant quels retournements sont appliqués à la copie.
+void RenderSnapshot_addSprite(
+    RenderSnapshot *self, int sheetID, int index,
+    const SDL_FRect *dstRect, double angle, SDL_RendererFlip flip);
+
+/// @brief Ajoute un émetteur de particules actif à un instantané.
+/// @param self l'instantané.
+/// @param emitter l'émetteur.
+/// @param position la position de l'objet portant l'émetteur.
+/// @param velocity la vitesse de l'objet portant l'émetteur.
+void RenderSnapshot_addEmitter(
+    RenderSnapshot *self, const ParticleEmitter *emitter, Vec2 position, Vec2 velocity);
+
+/// @brief Dessine les sprites d'un instantané dans le moteur de rendu.
+/// Les sprites sont triés par couche, profondeur puis texture ; les sprites
+/// consécutifs partageant une texture sont regroupés en un seul appel de dessin.
+/// @param self l'instantané.
+/// @param assets le gestionnaire d'assets résolvant les sprite sheets.
+/// @param queue la file utilisée pour trier les sprites.
+/// @param batch le lot de sprites utilisé pour le dessin.
+void RenderSnapshot_renderSprites(
+    const RenderSnapshot *self, AssetManager *assets,
+    RenderQueue *queue, SpriteBatch *batch);
+
+/// @brief Dessine les gizmos d'un instantané dans le moteur de rendu.
+/// @param self l'instantané.
+/// @param gizmos les gizmos utilisés pour le dessin.
+void RenderSnapshot_renderGizmos(const RenderSnapshot *self, Gizmos *gizmos);
@@ -0,0 +1,152 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "game/render_test.h"
+#include "game/level/level_scene.h"
+#include "utils/frame_capture.h"
+
+/// @brief Nombre d'images rendues si aucune limite n'est donnée (--ticks).
+#define RENDER_TEST_DEFAULT_FRAMES 120
+
+/// @brief Nombre d'images entre deux comparaisons avec les références.
+#define RENDER_TEST_CAPTURE_INTERVAL 30
+
+/// @brief Ecart toléré par composante entre une image et sa référence.
+/// Il absorbe les différences d'arrondi entre plateformes.
+#define RENDER_TEST_CHANNEL_TOLERANCE 8
+
+/// @brief Proportion maximale de pixels différents pour qu'une image
+/// corresponde à sa référence.
+#define RENDER_TEST_PIXEL_TOLERANCE 0.001f
+
+static bool RenderTest_checkFrame(
+    FrameCapture *capture, GameConfig *gameConfig, int frame, int pixelCount)
+{
+    char path[1024] = { 0 };
+    snprintf(path, sizeof(path), "%s/level%d_frame%04d.png",
+        gameConfig->goldenDir, gameConfig->levelID + 1, frame);
+
+    if (gameConfig->goldenUpdate)
+    {
+        return FrameCapture_savePNG(capture, path);
+    }
+
+    FrameCompareResult result = FrameCapture_compare(
+        capture, path, RENDER_TEST_CHANNEL_TOLERANCE);
+    if (result.loaded == false)
+    {
+        printf("ERROR - Missing or invalid golden image %s\n", path);
+        return false;
+    }
+
+    int maxDiffCount = (int)(RENDER_TEST_PIXEL_TOLERANCE * (float)pixelCount);
+    if (result.diffCount <= maxDiffCount)
+        return true;
+
+    printf("ERROR - Frame %d differs from %s\n", frame, path);
+    printf("     - %d pixels over tolerance (max %d), max channel diff %d\n",
+        result.diffCount, maxDiffCount, result.maxDiff);
+
+    // Conserve l'image obtenue pour pouvoir la comparer à la référence
+    snprintf(path, sizeof(path), "%s/level%d_frame%04d_actual.png",
+        gameConfig->goldenDir, gameConfig->levelID + 1, frame);
+    FrameCapture_savePNG(capture, path);
+    return false;
+}
+
+bool RenderTest_run(GameConfig *gameConfig)
+{
+    assert(gameConfig && gameConfig->goldenDir);
+
+    // Le rendu des zones modifiées suppose un rendu direct à l'écran
+    GameConfig config = *gameConfig;
+    config.dirtyRects = false;
+    config.dynamicResMin = 0.f;
+
+    const int width = Game_getWidth();
+    const int height = Game_getHeight();
+    FrameCapture *capture = FrameCapture_create(g_renderer, width, height);
+    if (capture == NULL)
+        return false;
+
+    char path[1024] = { 0 };
+    snprintf(path, sizeof(path), "%s/timings.csv", config.goldenDir);
+    FILE *timings = fopen(path, "w");
+    if (timings == NULL)
+    {
+        printf("ERROR - Open %s\n", path);
+        FrameCapture_destroy(capture);
+        return false;
+    }
+    fprintf(timings, "frame,tick,render_us,readback_us\n");
+
+    LevelScene *scene = LevelScene_create(&config);
+    RenderSnapshot *snapshot = (RenderSnapshot *)calloc(1, sizeof(RenderSnapshot));
+    AssertNew(snapshot);
+
+    // Les particules avancent d'une durée fixe pour des images reproductibles
+    scene->m_fixedRenderDelta = 1.f / 60.f;
+
+    int frameCount = config.maxTicks > 0 ? (int)config.maxTicks : RENDER_TEST_DEFAULT_FRAMES;
+    int checkCount = 0;
+    int failCount = 0;
+    double renderSum = 0.0;
+    double renderMax = 0.0;
+
+    for (int frame = 1; frame <= frameCount; frame++)
+    {
+        Timer_step(g_time, 16);
+        LevelScene_step(scene);
+        LevelScene_capture(scene, snapshot, false);
+
+        bool check = (frame % RENDER_TEST_CAPTURE_INTERVAL == 0) || (frame == frameCount);
+        if (FrameCapture_begin(capture) == false)
+        {
+            failCount++;
+            break;
+        }
+        RenderState_setDrawColor(g_renderState, 0, 0, 0, 255);
+        SDL_RenderClear(g_renderer);
+        LevelScene_render(scene, snapshot);
+        FrameCapture_end(capture, check);
+
+        double renderUS = FrameCapture_getRenderTime(capture);
+        renderSum += renderUS;
+        renderMax = fmax(renderMax, renderUS);
+        fprintf(timings, "%d,%llu,%.1f,%.1f\n",
+            frame, (unsigned long long)snapshot->m_tick,
+            renderUS, FrameCapture_getReadTime(capture));
+
+        if (check)
+        {
+            checkCount++;
+            if (RenderTest_checkFrame(capture, &config, frame, width * height) == false)
+            {
+                failCount++;
+            }
+        }
+    }
+
+    printf("INFO - Render test of level %d over %d frames (%dx%d)\n",
+        config.levelID + 1, frameCount, width, height);
+    printf("     - mean render %.1f us, max render %.1f us\n",
+        renderSum / (double)SDL_max(frameCount, 1), renderMax);
+    if (config.goldenUpdate)
+    {
+        printf("     - %d golden images written to %s\n", checkCount - failCount, config.goldenDir);
+    }
+    else
+    {
+        printf("     - %d/%d frames match the golden images\n", checkCount - failCount, checkCount);
+    }
+
+    fclose(timings);
+    free(snapshot);
+    LevelScene_destroy(scene);
+    FrameCapture_destroy(capture);
+
+    return failCount == 0;
+}
@@ -0,0 +1,20 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+#include "game/game_common.h"
+
+/// @brief Exécute le test de non-régression du rendu d'un niveau.
+/// Le niveau est simulé sans entrée avec un pas fixe, chaque image est
+/// rendue hors écran et certaines images sont comparées aux images de
+/// référence du dossier goldenDir (ou les remplacent si goldenUpdate est
+/// vrai). La durée de rendu de chaque image est écrite dans timings.csv.
+/// Le moteur de rendu doit avoir été créé.
+/// @param gameConfig la configuration globale du jeu.
+/// @return true si toutes les images correspondent aux références.
+bool RenderTest_run(GameConfig *gameConfig);
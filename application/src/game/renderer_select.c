@@ -0,0 +1,258 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "game/renderer_select.h"
+#include "game/game_common.h"
+#include "utils/common.h"
+#include "utils/sprite_batch.h"
+
+/// @brief Dossier des préférences (voir SDL_GetPrefPath()).
+#define RENDERER_SELECT_ORG "SpacePixels"
+#define RENDERER_SELECT_APP "SpacePixels"
+
+/// @brief Nombre d'images non mesurées puis mesurées pour chaque pilote.
+#define RENDERER_SELECT_WARMUP_FRAMES 10
+#define RENDERER_SELECT_FRAMES 120
+
+/// @brief Nombre de vaisseaux et de tirs de la charge de travail.
+#define RENDERER_SELECT_SHIP_COUNT 64
+#define RENDERER_SELECT_BULLET_COUNT 256
+
+/// @brief Structure représentant la mesure d'un pilote de rendu.
+typedef struct RendererScore
+{
+    char name[32];
+    double frameMS;
+} RendererScore;
+
+static char *RendererSelect_getConfigPath(void);
+static bool RendererSelect_isAvailable(const char *name);
+static double RendererSelect_measure(void);
+static void RendererSelect_save(
+    const char *driver, const RendererScore *scores, int scoreCount);
+
+bool RendererSelect_applySaved(void)
+{
+    char *path = RendererSelect_getConfigPath();
+    if (path == NULL)
+        return false;
+
+    FILE *file = fopen(path, "r");
+    SDL_free(path);
+    if (file == NULL)
+        return false;
+
+    char line[128] = { 0 };
+    char driver[32] = { 0 };
+    while (fgets(line, sizeof(line), file))
+    {
+        if (strncmp(line, "driver=", 7) == 0)
+        {
+            size_t length = strcspn(line + 7, "\r\n");
+            length = SDL_min(length, sizeof(driver) - 1);
+            memcpy(driver, line + 7, length);
+            driver[length] = '\0';
+        }
+    }
+    fclose(file);
+
+    if (driver[0] == '\0')
+        return false;
+    if (RendererSelect_isAvailable(driver) == false)
+    {
+        printf("WARNING - Saved renderer %s is no longer available\n", driver);
+        return false;
+    }
+
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, driver);
+    printf("INFO - Using saved renderer %s\n", driver);
+    return true;
+}
+
+bool RendererSelect_runBenchmark(int width, int height)
+{
+    assert(g_window && "The window must be created");
+    assert(g_renderer == NULL && "The renderer is already created");
+
+    // La synchronisation verticale limiterait tous les pilotes à la
+    // fréquence de l'écran
+    const char *vsyncHint = SDL_GetHint(SDL_HINT_RENDER_VSYNC);
+    char *prevVSync = SDL_strdup(vsyncHint ? vsyncHint : "");
+    SDL_SetHint(SDL_HINT_RENDER_VSYNC, "0");
+
+    RendererScore scores[RENDERER_SELECT_MAX_DRIVERS] = { 0 };
+    int scoreCount = 0;
+    int bestIndex = -1;
+
+    printf("INFO - Renderer self-benchmark (%d frames, %d sprites)\n",
+        RENDERER_SELECT_FRAMES, RENDERER_SELECT_SHIP_COUNT + RENDERER_SELECT_BULLET_COUNT + 1);
+
+    int driverCount = SDL_min(SDL_GetNumRenderDrivers(), RENDERER_SELECT_MAX_DRIVERS);
+    for (int i = 0; i < driverCount; i++)
+    {
+        SDL_RendererInfo info = { 0 };
+        if (SDL_GetRenderDriverInfo(i, &info) < 0)
+            continue;
+
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, info.name);
+        Game_createRenderer(width, height);
+
+        // La chaîne de repli a pu choisir un autre pilote
+        SDL_RendererInfo created = { 0 };
+        SDL_GetRendererInfo(g_renderer, &created);
+        if (strcmp(created.name, info.name) == 0)
+        {
+            RendererScore *score = scores + scoreCount++;
+            SDL_strlcpy(score->name, info.name, sizeof(score->name));
+            score->frameMS = RendererSelect_measure();
+            printf("     - %-10s %.3f ms/frame\n", score->name, score->frameMS);
+
+            if (bestIndex < 0 || score->frameMS < scores[bestIndex].frameMS)
+            {
+                bestIndex = scoreCount - 1;
+            }
+        }
+        else
+        {
+            printf("     - %-10s unavailable\n", info.name);
+        }
+        Game_destroyRenderer();
+    }
+
+    SDL_SetHint(SDL_HINT_RENDER_VSYNC, prevVSync);
+    SDL_free(prevVSync);
+
+    if (bestIndex < 0)
+    {
+        printf("WARNING - No renderer could be measured\n");
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "");
+        return false;
+    }
+
+    const char *best = scores[bestIndex].name;
+    printf("     - selected %s\n", best);
+    RendererSelect_save(best, scores, scoreCount);
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, best);
+    return true;
+}
+
+static char *RendererSelect_getConfigPath(void)
+{
+    char *prefPath = SDL_GetPrefPath(RENDERER_SELECT_ORG, RENDERER_SELECT_APP);
+    if (prefPath == NULL)
+    {
+        printf("WARNING - Preference path %s\n", SDL_GetError());
+        return NULL;
+    }
+
+    size_t size = strlen(prefPath) + strlen(RENDERER_SELECT_FILE_NAME) + 1;
+    char *path = (char *)SDL_malloc(size);
+    AssertNew(path);
+    SDL_snprintf(path, size, "%s%s", prefPath, RENDERER_SELECT_FILE_NAME);
+    SDL_free(prefPath);
+
+    return path;
+}
+
+static bool RendererSelect_isAvailable(const char *name)
+{
+    int driverCount = SDL_GetNumRenderDrivers();
+    for (int i = 0; i < driverCount; i++)
+    {
+        SDL_RendererInfo info = { 0 };
+        if (SDL_GetRenderDriverInfo(i, &info) == 0 && strcmp(info.name, name) == 0)
+            return true;
+    }
+    return false;
+}
+
+static double RendererSelect_measure(void)
+{
+    // Charge de travail représentative d'un niveau : un fond, des
+    // vaisseaux et des tirs regroupés dans l'atlas
+    AssetManager *assets = AssetManager_create(
+        SPRITE_COUNT, FONT_COUNT, SOUND_COUNT, MUSIC_COUNT);
+    Game_addAssets(assets);
+    AssetManager_buildAtlas(assets);
+
+    SpriteSheet *background = AssetManager_getSpriteSheet(assets, SPRITE_BACKGROUND_BLUE_NEBULA);
+    SpriteSheet *ship = AssetManager_getSpriteSheet(assets, SPRITE_FIGHTER_FIRING);
+    SpriteSheet *bullet = AssetManager_getSpriteSheet(assets, SPRITE_BULLET_FIGHTER);
+    SpriteBatch *batch = SpriteBatch_create(g_renderer);
+
+    const float w = (float)Game_getWidth();
+    const float h = (float)Game_getHeight();
+    const int frameCount = RENDERER_SELECT_WARMUP_FRAMES + RENDERER_SELECT_FRAMES;
+    Uint64 start = 0;
+
+    for (int frame = 0; frame < frameCount; frame++)
+    {
+        if (frame == RENDERER_SELECT_WARMUP_FRAMES)
+        {
+            start = SDL_GetPerformanceCounter();
+        }
+        SDL_PumpEvents();
+
+        RenderState_setDrawColor(g_renderState, 37, 37, 37, 255);
+        SDL_RenderClear(g_renderer);
+
+        SpriteBatch_begin(batch);
+        SDL_FRect dst = { 0.f, 0.f, w, h };
+        SpriteBatch_drawSprite(batch, background, 0, &dst, 0.0, SDL_FLIP_NONE);
+        for (int i = 0; i < RENDERER_SELECT_SHIP_COUNT; i++)
+        {
+            dst.w = dst.h = 64.f;
+            dst.x = fmodf(37.f * i + 3.f * frame, w - dst.w);
+            dst.y = fmodf(53.f * i + 1.f * frame, h - dst.h);
+            SpriteBatch_drawSprite(batch, ship, i + frame, &dst, 270.0, SDL_FLIP_NONE);
+        }
+        for (int i = 0; i < RENDERER_SELECT_BULLET_COUNT; i++)
+        {
+            dst.w = dst.h = 16.f;
+            dst.x = fmodf(29.f * i + 7.f * frame, w - dst.w);
+            dst.y = fmodf(17.f * i, h - dst.h);
+            SpriteBatch_drawSprite(batch, bullet, 0, &dst, 90.0 * (i % 4), SDL_FLIP_NONE);
+        }
+        SpriteBatch_end(batch);
+
+        SDL_RenderPresent(g_renderer);
+        RenderState_endFrame(g_renderState);
+    }
+
+    double frameMS = 1000.0 * (double)(SDL_GetPerformanceCounter() - start)
+        / (double)SDL_GetPerformanceFrequency() / RENDERER_SELECT_FRAMES;
+
+    SpriteBatch_destroy(batch);
+    AssetManager_destroy(assets);
+    return frameMS;
+}
+
+static void RendererSelect_save(
+    const char *driver, const RendererScore *scores, int scoreCount)
+{
+    char *path = RendererSelect_getConfigPath();
+    if (path == NULL)
+        return;
+
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+    {
+        printf("WARNING - Cannot write %s\n", path);
+        SDL_free(path);
+        return;
+    }
+
+    fprintf(file, "# Renderer self-benchmark (ms per frame)\n");
+    fprintf(file, "driver=%s\n", driver);
+    for (int i = 0; i < scoreCount; i++)
+    {
+        fprintf(file, "%s=%.3f\n", scores[i].name, scores[i].frameMS);
+    }
+    fclose(file);
+
+    printf("INFO - Renderer choice saved in %s\n", path);
+    SDL_free(path);
+}
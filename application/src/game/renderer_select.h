@@ -0,0 +1,31 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+
+/// @brief Nom du fichier de configuration du moteur de rendu, placé dans le
+/// dossier des préférences de l'utilisateur (SDL_GetPrefPath()).
+#define RENDERER_SELECT_FILE_NAME "renderer.cfg"
+
+/// @brief Nombre maximal de pilotes de rendu mesurés.
+#define RENDERER_SELECT_MAX_DRIVERS 16
+
+/// @brief Applique le pilote de rendu enregistré dans le fichier de
+/// configuration (SDL_HINT_RENDER_DRIVER), s'il est toujours disponible.
+/// @return true si un pilote enregistré a été appliqué.
+bool RendererSelect_applySaved(void);
+
+/// @brief Mesure chaque pilote de rendu disponible en dessinant des sprites
+/// dans la fenêtre du jeu, sans synchronisation verticale.
+/// Le plus rapide est enregistré dans le fichier de configuration puis
+/// appliqué (SDL_HINT_RENDER_DRIVER).
+/// La fenêtre doit être créée, mais pas le moteur de rendu.
+/// @param width largeur logique du rendu.
+/// @param height hauteur logique du rendu.
+/// @return true si au moins un pilote a pu être mesuré.
+bool RendererSelect_runBenchmark(int width, int height);
@@ -6,6 +6,10 @@
 
 #include "game/title/title_scene.h"
 
+/// @brief Durée maximale d'attente d'un événement lorsque le menu est
+/// immobile (en millisecondes).
+#define TITLE_IDLE_WAIT_MS 1000
+
 TitleScene *TitleScene_create(GameConfig *gameConfig)
 {
     TitleScene *self = (TitleScene *)calloc(1, sizeof(TitleScene));
@@ -18,11 +22,14 @@ TitleScene *TitleScene_create(GameConfig *gameConfig)
     self->m_input = Input_create();
 
     self->m_camera = Camera_create(Game_getWidth(), Game_getHeight());
+    AssetManager_setSpriteScale(self->m_assets, Game_getSpriteScale(
+        gameConfig, Camera_getWorldToViewScale(self->m_camera)));
     self->m_gizmos = Gizmos_create(self->m_camera);
     self->m_state = SCENE_STATE_FADING_IN;
     self->m_fadingTime = 0.5f;
     self->m_ui = TitleUI_create(self);
     self->m_gameConfig = gameConfig;
+    self->m_invalid = true;
 
     self->m_gameConfig->nextScene = GAME_SCENE_LEVEL;
 
@@ -48,8 +55,21 @@ void TitleScene_destroy(TitleScene *self)
 void TitleScene_mainLoop(TitleScene *self, bool drawGizmos)
 {
     assert(self && "The TitleScene must be created");
+    FramePacer_resync(g_pacer);
     while (true)
     {
+        if (TitleScene_needsRedraw(self))
+        {
+            // Attend le moment de lire les entrées
+            FramePacer_waitForInput(g_pacer);
+        }
+        else
+        {
+            // Rien ne bouge : on dort jusqu'au prochain événement
+            SDL_WaitEventTimeout(NULL, TITLE_IDLE_WAIT_MS);
+            FramePacer_resync(g_pacer);
+        }
+
         // Met à jour la scène
         Timer_update(g_time);
         TitleScene_update(self);
@@ -61,19 +81,66 @@ void TitleScene_mainLoop(TitleScene *self, bool drawGizmos)
             return;
         }
 
+        // Fenêtre minimisée : sommeil jusqu'à sa restauration
+        if (Input_waitWhileMinimized(input))
+        {
+            Timer_resync(g_time);
+            FramePacer_resync(g_pacer);
+            if (input->quitPressed)
+            {
+                self->m_gameConfig->nextScene = GAME_SCENE_QUIT;
+                return;
+            }
+            continue;
+        }
+        FramePacer_setBackground(g_pacer, input->windowFocused == false);
+
         if (self->m_state == SCENE_STATE_FINISHED)
             return;
 
+        if (input->windowRestoredPressed || input->windowExposedPressed ||
+            input->renderTargetsResetPressed)
+        {
+            TitleScene_invalidate(self);
+        }
+        if (input->windowExposedPressed)
+        {
+            // La taille de la fenêtre a pu changer
+            float scale = Game_getSpriteScale(
+                self->m_gameConfig, Camera_getWorldToViewScale(self->m_camera));
+            if (AssetManager_setSpriteScale(self->m_assets, scale))
+            {
+                TitleUI_invalidate(self->m_ui);
+            }
+        }
+        if (input->renderTargetsResetPressed)
+        {
+            TitleUI_invalidate(self->m_ui);
+            RenderState_invalidate(g_renderState);
+        }
+        if (TitleScene_needsRedraw(self) == false)
+            continue;
+
         // Rend la scène
         TitleScene_render(self);
 
         if (drawGizmos) TitleScene_drawGizmos(self);
 
-        // Affiche le nouveau rendu
+        // Attend l'échéance de l'image puis affiche le nouveau rendu
+        FramePacer_waitForDeadline(g_pacer);
         SDL_RenderPresent(g_renderer);
+        RenderState_endFrame(g_renderState);
     }
 }
 
+bool TitleScene_needsRedraw(TitleScene *self)
+{
+    assert(self && "The TitleScene must be created");
+    return self->m_invalid
+        || (self->m_state == SCENE_STATE_FADING_IN)
+        || (self->m_state == SCENE_STATE_FADING_OUT);
+}
+
 void TitleScene_update(TitleScene *self)
 {
     assert(self && "The TitleScene must be created");
@@ -84,7 +151,9 @@ void TitleScene_update(TitleScene *self)
         self->m_accu += Timer_getUnscaledDelta(g_time);
         if (self->m_accu >= self->m_fadingTime)
         {
+            // Dessine une dernière fois la scène sans le fondu
             self->m_state = SCENE_STATE_RUNNING;
+            TitleScene_invalidate(self);
         }
     }
     if (self->m_state == SCENE_STATE_FADING_OUT)
@@ -108,18 +177,20 @@ void TitleScene_quit(TitleScene *self)
 
     self->m_state = SCENE_STATE_FADING_OUT;
     self->m_accu = 0.f;
+    TitleScene_invalidate(self);
 }
 
 void TitleScene_render(TitleScene *self)
 {
     assert(self && "The TitleScene must be created");
     AssetManager *assets = TitleScene_getAssetManager(self);
+    self->m_invalid = false;
 
     // Efface le rendu précédent
-    SDL_SetRenderDrawColor(g_renderer, 37, 37, 37, 255);
+    RenderState_setDrawColor(g_renderState, 37, 37, 37, 255);
     SDL_RenderClear(g_renderer);
 
-    SDL_SetHintWithPriority(SDL_HINT_RENDER_SCALE_QUALITY, "0", SDL_HINT_OVERRIDE);
+    RenderState_setHint(g_renderState, SDL_HINT_RENDER_SCALE_QUALITY, "0");
 
     // Affiche l'interface utilisateur
     TitleUI_render(self->m_ui);
@@ -133,7 +204,7 @@ void TitleScene_render(TitleScene *self)
         {
             opacity = 255 - opacity;
         }
-        SDL_SetRenderDrawColor(g_renderer, 0, 0, 0, opacity);
+        RenderState_setDrawColor(g_renderState, 0, 0, 0, opacity);
         SDL_RenderFillRect(g_renderer, NULL);
     }
 }
@@ -143,4 +214,5 @@ void TitleScene_drawGizmos(TitleScene *self)
     assert(self && "The TitleScene must be created");
     Gizmos *gizmos = self->m_gizmos;
     TitleUI_drawGizmos(self->m_ui, gizmos);
+    Gizmos_flush(gizmos);
 }
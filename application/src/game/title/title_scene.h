@@ -27,6 +27,9 @@ typedef struct TitleScene
     int m_state;
     float m_accu;
     float m_fadingTime;
+
+    /// @brief Booléen indiquant si le dernier rendu affiché n'est plus à jour.
+    bool m_invalid;
 } TitleScene;
 
 /// @brief Crée la scène représentant le menu principal du jeu.
@@ -53,6 +56,20 @@ void TitleScene_update(TitleScene *self);
 /// @param self la scène.
 void TitleScene_quit(TitleScene *self);
 
+/// @brief Indique que le rendu de la scène doit être refait.
+/// @param self la scène.
+INLINE void TitleScene_invalidate(TitleScene *self)
+{
+    assert(self && "The TitleScene must be created");
+    self->m_invalid = true;
+}
+
+/// @brief Indique si la scène doit être redessinée à la prochaine image.
+/// C'est le cas après une invalidation ou pendant un fondu.
+/// @param self la scène.
+/// @return true si la scène doit être redessinée, false sinon.
+bool TitleScene_needsRedraw(TitleScene *self);
+
 /// @brief Dessine la scène dans le moteur de rendu.
 /// @param self la scène.
 void TitleScene_render(TitleScene *self);
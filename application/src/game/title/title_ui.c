@@ -47,6 +47,9 @@ TitleUI *TitleUI_create(TitleScene *scene)
     TTF_SizeText(font, "Text", &w, &h);
     self->m_hTexts = h;
 
+    // Le fond et la page affichée forment un seul panneau opaque
+    self->m_panel = UIPanel_create(g_renderer, Game_getWidth(), Game_getHeight(), true);
+
     return self;
 }
 
@@ -62,6 +65,7 @@ void TitleUI_destroy(TitleUI *self)
     {
         Text_destroy(self->m_textLevels[i]);
     }
+    UIPanel_destroy(self->m_panel);
 
     free(self);
 }
@@ -70,16 +74,40 @@ void TitleUI_render(TitleUI *self)
 {
     assert(self);
 
-    TitleUI_renderBackground(self);
-
-    if (self->m_pageID == 0)
+    // L'écran n'est recomposé que si la page ou l'un des textes a changé
+    Uint64 key = UIPanel_hash(0, self->m_pageID);
+    key = UIPanel_hash(key, Text_getVersion(self->m_textTitleMain));
+    key = UIPanel_hash(key, Text_getVersion(self->m_textSelectLevel));
+    key = UIPanel_hash(key, Text_getVersion(self->m_textQuit));
+    for (int i = 0; i < LEVEL_COUNT; i++)
     {
-        TitleUI_renderMainPage(self);
+        key = UIPanel_hash(key, Text_getVersion(self->m_textLevels[i]));
     }
-    else
+
+    if (UIPanel_beginCompose(self->m_panel, key, 0, 0))
     {
-        TitleUI_renderLevelPage(self);
+        RenderState_setDrawColor(g_renderState, 37, 37, 37, 255);
+        SDL_RenderClear(g_renderer);
+
+        TitleUI_renderBackground(self);
+
+        if (self->m_pageID == 0)
+        {
+            TitleUI_renderMainPage(self);
+        }
+        else
+        {
+            TitleUI_renderLevelPage(self);
+        }
+        UIPanel_endCompose(self->m_panel);
     }
+    UIPanel_render(self->m_panel);
+}
+
+void TitleUI_invalidate(TitleUI *self)
+{
+    assert(self);
+    UIPanel_invalidate(self->m_panel);
 }
 
 void TitleUI_update(TitleUI *self)
@@ -92,6 +120,47 @@ void TitleUI_update(TitleUI *self)
     {
         TitleUI_updateLevelPage(self);
     }
+
+    // Les couleurs sont celles de la page affichée après la mise à jour
+    TitleUI_updateTextColors(self);
+}
+
+void TitleUI_updateTextColors(TitleUI *self)
+{
+    if (self->m_pageID == 0)
+    {
+        // Couleurs des textes s�lectionnables
+        Text *texts[2] = {
+            self->m_textSelectLevel,
+            self->m_textQuit
+        };
+        for (int i = 0; i < 2; i++)
+        {
+            if (i == self->m_selection)
+            {
+                Text_setColor(texts[i], g_colors.white);
+            }
+            else
+            {
+                Text_setColor(texts[i], g_colors.whiteSemi);
+            }
+        }
+    }
+    else
+    {
+        // Couleurs des textes s�lectionnables
+        for (int i = 0; i < LEVEL_COUNT; i++)
+        {
+            if (i == self->m_selection)
+            {
+                Text_setColor(self->m_textLevels[i], g_colors.green);
+            }
+            else
+            {
+                Text_setColor(self->m_textLevels[i], g_colors.red);
+            }
+        }
+    }
 }
 
 void TitleUI_drawGizmos(TitleUI *self, Gizmos *gizmos)
@@ -120,23 +189,7 @@ void TitleUI_updateMainPage(TitleUI *self)
     if (prevSelection != self->m_selection)
     {
         Game_playSoundFX(assets, SOUND_UI_SELECT);
-    }
-
-    // Couleurs des textes s�lectionnables
-    Text *texts[2] = {
-        self->m_textSelectLevel,
-        self->m_textQuit
-    };
-    for (int i = 0; i < 2; i++)
-    {
-        if (i == self->m_selection)
-        {
-            Text_setColor(texts[i], g_colors.white);
-        }
-        else
-        {
-            Text_setColor(texts[i], g_colors.whiteSemi);
-        }
+        TitleScene_invalidate(scene);
     }
 
     // Action du joueur sur la s�lection
@@ -147,6 +200,7 @@ void TitleUI_updateMainPage(TitleUI *self)
             // On va vers la page de s�lection du niveau
             self->m_pageID = 1;
             self->m_selection = 0;
+            TitleScene_invalidate(scene);
         }
         else if (self->m_selection == 1)
         {
@@ -180,19 +234,7 @@ void TitleUI_updateLevelPage(TitleUI *self)
     if (prevSelection != self->m_selection)
     {
         Game_playSoundFX(assets, SOUND_UI_SELECT);
-    }
-
-    // Couleurs des textes s�lectionnables
-    for (int i = 0; i < LEVEL_COUNT; i++)
-    {
-        if (i == self->m_selection)
-        {
-            Text_setColor(self->m_textLevels[i], g_colors.green);
-        }
-        else
-        {
-            Text_setColor(self->m_textLevels[i], g_colors.red);
-        }
+        TitleScene_invalidate(scene);
     }
 
     // Action du joueur sur la s�lection
@@ -209,6 +251,7 @@ void TitleUI_updateLevelPage(TitleUI *self)
         // On retroune vers la page principale
         self->m_pageID = 0;
         self->m_selection = 0;
+        TitleScene_invalidate(scene);
         Game_playSoundFX(assets, SOUND_UI_CANCEL);
     }
 }
@@ -255,13 +298,11 @@ void TitleUI_renderMainPage(TitleUI *self)
 
     y += yPadding;
 
-    int w = 0, h = 0;
     texture = Text_getTexture(self->m_textTitleMain);
-    SDL_QueryTexture(texture, NULL, NULL, &w, &h);
-    dstRect.x = x - w / 2;
+    dstRect.w = Text_getWidth(self->m_textTitleMain);
+    dstRect.h = Text_getHeight(self->m_textTitleMain);
+    dstRect.x = x - dstRect.w / 2;
     dstRect.y = y;
-    dstRect.w = w;
-    dstRect.h = h;
     SDL_RenderCopy(g_renderer, texture, NULL, &dstRect);
 
     y += self->m_hTitleMain;
@@ -273,11 +314,10 @@ void TitleUI_renderMainPage(TitleUI *self)
     for (int i = 0; i < 2; i++)
     {
         texture = Text_getTexture(texts[i]);
-        SDL_QueryTexture(texture, NULL, NULL, &w, &h);
-        dstRect.x = x - w / 2;
+        dstRect.w = Text_getWidth(texts[i]);
+        dstRect.h = Text_getHeight(texts[i]);
+        dstRect.x = x - dstRect.w / 2;
         dstRect.y = y;
-        dstRect.w = w;
-        dstRect.h = h;
         SDL_RenderCopy(g_renderer, texture, NULL, &dstRect);
 
         y += self->m_hTexts;
@@ -288,18 +328,16 @@ void TitleUI_renderLevelPage(TitleUI *self)
 {
     int x = 0;
     int y = 0;
-    int w = 0, h = 0;
     SDL_Rect dstRect = { 0 };
     SDL_Texture *texture = NULL;
 
     for (int i = 0; i < LEVEL_COUNT; i++)
     {
         texture = Text_getTexture(self->m_textLevels[i]);
-        SDL_QueryTexture(texture, NULL, NULL, &w, &h);
         dstRect.x = x;
         dstRect.y = y;
-        dstRect.w = w;
-        dstRect.h = h;
+        dstRect.w = Text_getWidth(self->m_textLevels[i]);
+        dstRect.h = Text_getHeight(self->m_textLevels[i]);
         SDL_RenderCopy(g_renderer, texture, NULL, &dstRect);
 
         y += self->m_hTexts;
@@ -9,6 +9,7 @@
 #include "settings.h"
 #include "utils/text.h"
 #include "utils/gizmos.h"
+#include "utils/ui_panel.h"
 #include "game/game_common.h"
 
 typedef struct TitleScene TitleScene;
@@ -27,17 +28,26 @@ typedef struct TitleUI
     int m_hTitleMain;
     int m_hTitle;
     int m_hTexts;
+
+    /// @brief Fond et page courante mis en cache.
+    UIPanel *m_panel;
 } TitleUI;
 
 TitleUI *TitleUI_create(TitleScene *scene);
 void TitleUI_destroy(TitleUI *self);
 
 void TitleUI_render(TitleUI *self);
+
+/// @brief Force la recomposition de l'écran titre,
+/// par exemple après un événement SDL_RENDER_TARGETS_RESET.
+/// @param self l'interface de l'écran titre.
+void TitleUI_invalidate(TitleUI *self);
 void TitleUI_update(TitleUI *self);
 void TitleUI_drawGizmos(TitleUI *self, Gizmos *gizmos);
 
 void TitleUI_updateMainPage(TitleUI *self);
 void TitleUI_updateLevelPage(TitleUI *self);
+void TitleUI_updateTextColors(TitleUI *self);
 
 void TitleUI_renderBackground(TitleUI *self);
 void TitleUI_renderMainPage(TitleUI *self);
@@ -12,9 +12,17 @@
 #include "game/input.h"
 #include "game/level/level_scene.h"
 #include "game/title/title_scene.h"
+#include "game/benchmark.h"
+#include "game/render_test.h"
+#include "game/renderer_select.h"
 
 //#define FULLSCREEN
 //#define WINDOW_FHD
+//#define LOW_LATENCY_INPUT
+//#define RENDERER_SELF_BENCHMARK
+//#define THREADED_SIMULATION
+
+#define TARGET_FPS 60.f
 
 #ifdef WINDOW_FHD
 #define WINDOW_WIDTH   FHD_WIDTH
@@ -26,6 +34,197 @@
 #define LOGICAL_WIDTH  HD_WIDTH
 #define LOGICAL_HEIGHT HD_HEIGHT
 
+/// @brief Lit les options de la ligne de commande.
+/// --fast-forward N : lance les niveaux en avance rapide (N >= 2 pas par image).
+/// --headless       : simule le niveau sans rendu ni attente puis quitte.
+/// --ticks N        : arrête le jeu après N pas de simulation d'un niveau.
+/// --level N        : lance directement le niveau N (à partir de 1).
+/// --players N      : nombre de joueurs.
+/// --threaded       : simule les niveaux dans un thread séparé.
+/// --rewind         : permet de revenir en arrière dans un niveau (touche R).
+/// --dirty-rects    : rendu logiciel ne redessinant que les zones modifiées.
+/// --soft-blitter   : dessine les sprites des niveaux avec le SoftBlitter.
+/// --bench NOM      : exécute une mesure de performances puis quitte
+///                    (state : sauvegarde et restauration d'un niveau,
+///                     dirty : rendu complet et rendu des zones modifiées,
+///                     particles : 5 000 à 50 000 particules avec le
+///                                 moteur logiciel,
+///                     blitter : SoftBlitter et moteur logiciel de la SDL).
+/// --golden DIR     : rend le niveau hors écran avec le moteur logiciel,
+///                    compare certaines images à celles de DIR puis quitte
+///                    (fonctionne avec SDL_VIDEODRIVER=dummy).
+/// --golden-update  : remplace les images de référence de DIR.
+/// --prescale MODE  : agrandit les sprites au chargement pour la taille de
+///                    la fenêtre (integer : facteur entier,
+///                     exact : copies pixel à pixel).
+/// --renderer NOM   : impose un pilote de rendu de la SDL (opengl, software...).
+/// --renderer-bench : mesure les pilotes de rendu disponibles, enregistre
+///                    le plus rapide dans le dossier des préférences et
+///                    l'utilise pour les lancements suivants.
+/// --dynamic-res MIN,MAX : adapte la résolution du rendu des niveaux entre
+///                    MIN et MAX (facteurs de la taille logique) selon le
+///                    temps de rendu, l'interface reste à la résolution native.
+/// @param argc le nombre d'arguments.
+/// @param argv les arguments.
+/// @param gameConfig la configuration du jeu à modifier.
+static void Game_parseArguments(int argc, char *argv[], GameConfig *gameConfig)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "--fast-forward") == 0 && value)
+        {
+            // Au moins deux pas par image, sinon l'avance rapide est sans effet
+            char *end = NULL;
+            long ticks = strtol(value, &end, 10);
+            if (end != value && *end == '\0' && ticks >= 2 && ticks <= SDL_MAX_SINT32)
+            {
+                gameConfig->fastForward = true;
+                gameConfig->fastForwardTicks = (int)ticks;
+            }
+            else
+            {
+                printf("WARNING - Invalid fast forward tick count %s\n", value);
+            }
+            i++;
+        }
+        else if (strcmp(arg, "--headless") == 0)
+        {
+            gameConfig->headless = true;
+        }
+        else if (strcmp(arg, "--ticks") == 0 && value)
+        {
+            char *end = NULL;
+            long long ticks = strtoll(value, &end, 10);
+            if (end != value && *end == '\0' && ticks >= 1)
+            {
+                gameConfig->maxTicks = (Uint64)ticks;
+            }
+            else
+            {
+                printf("WARNING - Invalid tick count %s\n", value);
+            }
+            i++;
+        }
+        else if (strcmp(arg, "--level") == 0 && value)
+        {
+            char *end = NULL;
+            long level = strtol(value, &end, 10);
+            if (end != value && *end == '\0' && level >= 1 && level <= LEVEL_COUNT)
+            {
+                gameConfig->levelID = (int)level - 1;
+                gameConfig->nextScene = GAME_SCENE_LEVEL;
+            }
+            else
+            {
+                printf("WARNING - Invalid level %s\n", value);
+                printf("     - Levels range from 1 to %d\n", LEVEL_COUNT);
+            }
+            i++;
+        }
+        else if (strcmp(arg, "--players") == 0 && value)
+        {
+            char *end = NULL;
+            long playerCount = strtol(value, &end, 10);
+            if (end != value && *end == '\0' && playerCount >= 1 && playerCount <= MAX_PLAYER_COUNT)
+            {
+                gameConfig->playerCount = (int)playerCount;
+            }
+            else
+            {
+                printf("WARNING - Invalid player count %s\n", value);
+                printf("     - The player count ranges from 1 to %d\n", MAX_PLAYER_COUNT);
+            }
+            i++;
+        }
+        else if (strcmp(arg, "--threaded") == 0)
+        {
+            gameConfig->threadedSimulation = true;
+        }
+        else if (strcmp(arg, "--rewind") == 0)
+        {
+            gameConfig->rewind = true;
+        }
+        else if (strcmp(arg, "--dirty-rects") == 0)
+        {
+            gameConfig->dirtyRects = true;
+        }
+        else if (strcmp(arg, "--soft-blitter") == 0)
+        {
+            gameConfig->softBlitter = true;
+        }
+        else if (strcmp(arg, "--bench") == 0 && value)
+        {
+            if (strcmp(value, "state") == 0)
+                gameConfig->benchmark = BENCHMARK_LEVEL_STATE;
+            else if (strcmp(value, "dirty") == 0)
+                gameConfig->benchmark = BENCHMARK_DIRTY_RECTS;
+            else if (strcmp(value, "particles") == 0)
+                gameConfig->benchmark = BENCHMARK_PARTICLES;
+            else if (strcmp(value, "blitter") == 0)
+                gameConfig->benchmark = BENCHMARK_BLITTER;
+            else
+                printf("WARNING - Unknown benchmark %s\n", value);
+            i++;
+        }
+        else if (strcmp(arg, "--golden") == 0 && value)
+        {
+            gameConfig->goldenDir = value;
+            i++;
+        }
+        else if (strcmp(arg, "--golden-update") == 0)
+        {
+            gameConfig->goldenUpdate = true;
+        }
+        else if (strcmp(arg, "--prescale") == 0 && value)
+        {
+            if (strcmp(value, "integer") == 0)
+                gameConfig->spriteScaleMode = SPRITE_SCALE_INTEGER;
+            else if (strcmp(value, "exact") == 0)
+                gameConfig->spriteScaleMode = SPRITE_SCALE_EXACT;
+            else
+                printf("WARNING - Unknown prescale mode %s\n", value);
+            i++;
+        }
+        else if (strcmp(arg, "--renderer") == 0 && value)
+        {
+            gameConfig->renderer = value;
+            i++;
+        }
+        else if (strcmp(arg, "--renderer-bench") == 0)
+        {
+            gameConfig->rendererBenchmark = true;
+        }
+        else if (strcmp(arg, "--dynamic-res") == 0 && value)
+        {
+            float minScale = 0.f, maxScale = 1.f;
+            int count = sscanf(value, "%f,%f", &minScale, &maxScale);
+            if (count >= 1 && minScale > 0.f && minScale <= maxScale && maxScale <= 2.f)
+            {
+                gameConfig->dynamicResMin = minScale;
+                gameConfig->dynamicResMax = maxScale;
+            }
+            else
+            {
+                printf("WARNING - Invalid dynamic resolution %s\n", value);
+            }
+            i++;
+        }
+        else
+        {
+            printf("WARNING - Unknown argument %s\n", arg);
+        }
+    }
+
+    if (gameConfig->headless)
+    {
+        gameConfig->nextScene = GAME_SCENE_LEVEL;
+        gameConfig->threadedSimulation = false;
+    }
+}
+
 int main(int argc, char *argv[])
 {
     //--------------------------------------------------------------------------
@@ -35,31 +234,100 @@ int main(int argc, char *argv[])
     const Uint32 sdlFlags = SDL_INIT_VIDEO | SDL_INIT_JOYSTICK | SDL_INIT_GAMECONTROLLER;
     const Uint32 imgFlags = IMG_INIT_PNG;
     const Uint32 mixFlags = MIX_INIT_MP3;
-    Game_init(sdlFlags, imgFlags, mixFlags);
+    Game_init(sdlFlags, imgFlags, mixFlags, TARGET_FPS);
 
     Game_setMusicVolume(0.5f);
     Game_setFXChannelsVolume(0.5f);
 
+    GameConfig gameConfig = { 0 };
+    LevelScene *levelScene = NULL;
+    TitleScene *titleScene = NULL;
+
+    // Paramètres
+    gameConfig.nextScene = GAME_SCENE_LEVEL;
+    gameConfig.levelID = LEVEL_1;
+    gameConfig.playerCount = 2;
+#ifdef THREADED_SIMULATION
+    gameConfig.threadedSimulation = true;
+#endif
+    bool drawGizmos = true;
+
+    Game_parseArguments(argc, argv, &gameConfig);
+
     // Crée la fenêtre et le moteur de rendu
     Uint32 windowFlags = 0;
 #ifdef FULLSCREEN
     windowFlags |= SDL_WINDOW_FULLSCREEN_DESKTOP;
 #endif
+    bool renderTest = (gameConfig.goldenDir != NULL);
+    if (gameConfig.headless || gameConfig.benchmark != BENCHMARK_NONE || renderTest)
+    {
+        // Le moteur de rendu reste nécessaire au chargement des textures
+        windowFlags = SDL_WINDOW_HIDDEN;
+        Game_setMusicVolume(0.f);
+    }
     Game_createWindow(WINDOW_WIDTH, WINDOW_HEIGHT, windowFlags);
+    if (gameConfig.dirtyRects || gameConfig.benchmark == BENCHMARK_DIRTY_RECTS)
+    {
+        // Seul le moteur logiciel conserve l'image précédente après
+        // SDL_RenderPresent()
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    }
+    if (gameConfig.benchmark == BENCHMARK_PARTICLES ||
+        gameConfig.benchmark == BENCHMARK_BLITTER)
+    {
+        // Les particules doivent tenir la cadence même sans accélération
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    }
+    if (renderTest)
+    {
+        // Les images de référence ne dépendent pas de la carte graphique
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    }
+    if (gameConfig.renderer)
+    {
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, gameConfig.renderer);
+    }
+    else if (SDL_GetHint(SDL_HINT_RENDER_DRIVER) == NULL)
+    {
+        // Aucun pilote imposé : mesure des pilotes ou choix enregistré
+        if (gameConfig.rendererBenchmark)
+        {
+            RendererSelect_runBenchmark(LOGICAL_WIDTH, LOGICAL_HEIGHT);
+        }
+        else if (RendererSelect_applySaved() == false)
+        {
+#ifdef RENDERER_SELF_BENCHMARK
+            // Premier lancement
+            RendererSelect_runBenchmark(LOGICAL_WIDTH, LOGICAL_HEIGHT);
+#endif
+        }
+    }
     Game_createRenderer(LOGICAL_WIDTH, LOGICAL_HEIGHT);
 
+#ifdef LOW_LATENCY_INPUT
+    // Retarde la lecture des entrées pour réduire la latence
+    FramePacer_setInputDelay(g_pacer, true);
+#endif
+
     //--------------------------------------------------------------------------
     // Boucle de jeu
 
-    GameConfig gameConfig = { 0 };
-    LevelScene *levelScene = NULL;
-    TitleScene *titleScene = NULL;
+    if (gameConfig.benchmark != BENCHMARK_NONE)
+    {
+        Benchmark_run(&gameConfig);
+        gameConfig.nextScene = GAME_SCENE_QUIT;
+    }
 
-    // Paramètres
-    gameConfig.nextScene = GAME_SCENE_LEVEL;
-    gameConfig.levelID = LEVEL_1;
-    gameConfig.playerCount = 2;
-    bool drawGizmos = true;
+    int exitStatus = EXIT_SUCCESS;
+    if (renderTest)
+    {
+        if (RenderTest_run(&gameConfig) == false)
+        {
+            exitStatus = EXIT_FAILURE;
+        }
+        gameConfig.nextScene = GAME_SCENE_QUIT;
+    }
 
     bool quitGame = false;
     while (quitGame == false)
@@ -70,6 +338,8 @@ int main(int argc, char *argv[])
         case GAME_SCENE_TITLE:
             titleScene = TitleScene_create(&gameConfig);
             TitleScene_mainLoop(titleScene, drawGizmos);
+            FramePacer_printStats(g_pacer);
+            RenderState_printStats(g_renderState);
 
             TitleScene_destroy(titleScene);
             titleScene = NULL;
@@ -78,6 +348,8 @@ int main(int argc, char *argv[])
         case GAME_SCENE_LEVEL:
             levelScene = LevelScene_create(&gameConfig);
             LevelScene_mainLoop(levelScene, drawGizmos);
+            FramePacer_printStats(g_pacer);
+            RenderState_printStats(g_renderState);
 
             LevelScene_destroy(levelScene);
             levelScene = NULL;
@@ -102,5 +374,5 @@ int main(int argc, char *argv[])
     Game_destroyWindow();
     Game_quit();
 
-    return EXIT_SUCCESS;
+    return exitStatus;
 }
@@ -6,13 +6,22 @@
 
 #include "utils/asset_manager.h"
 #include "utils/common.h"
+#include "utils/skyline_packer.h"
+#include "utils/soft_blitter.h"
 
 static void AssetManager_createRWops(const char *fileName, SDL_RWops **rwops, void **buffer);
 static void AssetManager_destroyRWops(SDL_RWops *rwops, void *buffer);
 
-static void SpriteSheetData_load(SpriteSheetData *self);
+static void SpriteSheetData_load(SpriteSheetData *self, float scale, bool keepImage);
+static SDL_Surface *SpriteSheetData_loadSurface(SpriteSheetData *self);
+static SDL_Surface *SpriteSheetData_rotateSurface(SpriteSheetData *self, SDL_Surface *surface);
+static void SpriteSheetData_initRects(SpriteSheetData *self, int w);
+static void SpriteSheetData_unload(SpriteSheetData *self);
 static void SpriteSheetData_clear(SpriteSheetData *self);
 
+static SDL_Surface *AssetManager_scaleSurface(SDL_Surface *surface, float scale);
+static float AssetManager_clampScale(float scale, int w, int h);
+
 static void FontData_load(FontData *self);
 static void FontData_clear(FontData *self);
 
@@ -30,19 +39,87 @@ void SpriteSheet_renderCopyF(
     SDL_Renderer *renderer, const SDL_FRect *dstRect,
     const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip)
 {
-        assert(self && renderer);
-        assert(index >= 0);
-        index = index % self->rectCount;
-        SDL_RenderCopyExF(renderer, self->texture, self->rects + index, dstRect, angle, center, flip);
+    assert(self && renderer);
+    assert(index >= 0);
+    index = index % self->rectCount;
+
+    SDL_FRect rect = *dstRect;
+    double bakedAngle = angle;
+    SDL_RendererFlip bakedFlip = flip;
+    if (self->orientation != SPRITE_ORIENTATION_0)
+    {
+        SpriteSheet_getBakedCopy(self, dstRect, angle, center, flip, &rect, &bakedAngle, &bakedFlip);
+        center = NULL;
+    }
+
+    // La texture peut être partagée par plusieurs sprite sheets (atlas) :
+    // l'opacité est rétablie à chaque copie
+    RenderState_setTextureAlphaMod(g_renderState, self->texture, self->opacity);
+
+    if (bakedAngle == 0.0 && bakedFlip == SDL_FLIP_NONE)
+    {
+        // Copie sans rotation, bien plus rapide avec le moteur logiciel
+        SDL_RenderCopyF(renderer, self->texture, self->rects + index, &rect);
+    }
+    else
+    {
+        SDL_RenderCopyExF(renderer, self->texture, self->rects + index, &rect, bakedAngle, center, bakedFlip);
+    }
+}
+
+void SpriteSheet_getBakedCopy(
+    SpriteSheet *self, const SDL_FRect *dstRect,
+    double angle, const SDL_FPoint *center, SDL_RendererFlip flip,
+    SDL_FRect *bakedRect, double *bakedAngle, SDL_RendererFlip *bakedFlip)
+{
+    assert(self && dstRect && bakedRect && bakedAngle && bakedFlip);
+
+    // Centre du rectangle après la rotation demandée : une rotation autour
+    // d'un point quelconque est une rotation autour du centre du rectangle
+    // suivie d'une translation
+    float cx = dstRect->x + 0.5f * dstRect->w;
+    float cy = dstRect->y + 0.5f * dstRect->h;
+    if (center && angle != 0.0)
+    {
+        float px = dstRect->x + center->x;
+        float py = dstRect->y + center->y;
+        double radians = angle * M_PI / 180.0;
+        float c = (float)cos(radians);
+        float s = (float)sin(radians);
+        float dx = cx - px, dy = cy - py;
+        cx = px + dx * c - dy * s;
+        cy = py + dx * s + dy * c;
+    }
+
+    // Un quart de tour échange la largeur et la hauteur, ainsi que les
+    // axes des retournements
+    bool quarter = (self->orientation == SPRITE_ORIENTATION_90 ||
+                    self->orientation == SPRITE_ORIENTATION_270);
+    float w = quarter ? dstRect->h : dstRect->w;
+    float h = quarter ? dstRect->w : dstRect->h;
+    bakedRect->x = cx - 0.5f * w;
+    bakedRect->y = cy - 0.5f * h;
+    bakedRect->w = w;
+    bakedRect->h = h;
+
+    *bakedFlip = flip;
+    if (quarter && (flip == SDL_FLIP_HORIZONTAL || flip == SDL_FLIP_VERTICAL))
+    {
+        *bakedFlip = (flip == SDL_FLIP_HORIZONTAL) ? SDL_FLIP_VERTICAL : SDL_FLIP_HORIZONTAL;
+    }
+
+    // Angle restant, ramené dans ]-180, 180]
+    double residual = fmod(angle - (double)self->orientation, 360.0);
+    if (residual > 180.0) residual -= 360.0;
+    if (residual <= -180.0) residual += 360.0;
+    *bakedAngle = (fabs(residual) < 1e-6) ? 0.0 : residual;
 }
 
 void SpriteSheet_setOpacity(SpriteSheet *self, Uint8 alpha)
 {
-    int exitStatus;
-    exitStatus = SDL_SetTextureBlendMode(self->texture, SDL_BLENDMODE_BLEND);
-    assert(exitStatus == 0);
-    exitStatus = SDL_SetTextureAlphaMod(self->texture, alpha);
-    assert(exitStatus == 0);
+    assert(self && self->texture);
+    RenderState_setTextureBlendMode(g_renderState, self->texture, SDL_BLENDMODE_BLEND);
+    self->opacity = alpha;
 }
 
 AssetManager *AssetManager_create(
@@ -56,6 +133,7 @@ AssetManager *AssetManager_create(
     self->m_spriteCapacity = spriteCapacity;
     self->m_soundCapacity = soundCapacity;
     self->m_musicCapacity = musicCapacity;
+    self->m_spriteScale = 1.f;
 
     self->m_spriteData = (SpriteSheetData *)calloc(spriteCapacity, sizeof(SpriteSheetData));
     AssertNew(self->m_spriteData);
@@ -86,6 +164,13 @@ void AssetManager_destroy(AssetManager *self)
         free(self->m_spriteData);
     }
 
+    // Libère les atlas
+    for (int i = 0; i < self->m_atlasCount; i++)
+    {
+        SDL_DestroyTexture(self->m_atlases[i]);
+        SoftImage_destroy(self->m_atlasImages[i]);
+    }
+
     if (self->m_musicData)
     {
         // Libère les musiques
@@ -137,10 +222,13 @@ static char *AssetManager_makePath(const char *assetsPath, const char *fileName)
 void AssetManager_addSpriteSheet(
     AssetManager *self, int sheetID,
     const char *assetsPath, const char *fileName,
-    int rectCount, int rectWidth, int rectHeight)
+    int rectCount, int rectWidth, int rectHeight, int orientation)
 {
     assert(self && "The AssetManager must be created");
     assert(0 <= sheetID && sheetID < self->m_spriteCapacity && "The sheetID is not valid");
+    assert((orientation == SPRITE_ORIENTATION_0 || orientation == SPRITE_ORIENTATION_90 ||
+            orientation == SPRITE_ORIENTATION_180 || orientation == SPRITE_ORIENTATION_270) &&
+           "The orientation is not valid");
 
     SpriteSheetData *spriteData = &(self->m_spriteData[sheetID]);
     if (spriteData->m_fileName)
@@ -154,6 +242,7 @@ void AssetManager_addSpriteSheet(
     spriteData->m_rectCount = rectCount;
     spriteData->m_rectWidth = rectWidth;
     spriteData->m_rectHeight = rectHeight;
+    spriteData->m_orientation = orientation;
 }
 
 void AssetManager_addFont(
@@ -217,7 +306,8 @@ SpriteSheet *AssetManager_getSpriteSheet(AssetManager *self, int sheetID)
     assert(0 <= sheetID && sheetID < self->m_spriteCapacity && "The sheetID is not valid");
 
     SpriteSheetData *spriteData = &(self->m_spriteData[sheetID]);
-    if (spriteData->m_spriteSheet) return spriteData->m_spriteSheet;
+    if (spriteData->m_spriteSheet && spriteData->m_spriteSheet->texture)
+        return spriteData->m_spriteSheet;
 
     if (spriteData->m_fileName == NULL)
     {
@@ -226,7 +316,7 @@ SpriteSheet *AssetManager_getSpriteSheet(AssetManager *self, int sheetID)
         return NULL;
     }
 
-    SpriteSheetData_load(spriteData);
+    SpriteSheetData_load(spriteData, self->m_spriteScale, self->m_keepImages);
     return spriteData->m_spriteSheet;
 }
 
@@ -311,12 +401,350 @@ void AssetManager_loadMusic(AssetManager *self, int musicID)
     assert(music);
 }
 
-static void SpriteSheetData_load(SpriteSheetData *self)
+void AssetManager_preload(AssetManager *self)
+{
+    assert(self && "The AssetManager must be created");
+    for (int i = 0; i < self->m_spriteCapacity; i++)
+    {
+        if (self->m_spriteData[i].m_fileName)
+            AssetManager_loadSpriteSheet(self, i);
+    }
+    for (int i = 0; i < self->m_soundCapacity; i++)
+    {
+        if (self->m_soundData[i].m_fileName)
+            AssetManager_loadSound(self, i);
+    }
+}
+
+/// @brief Sprite sheet à placer dans un atlas.
+typedef struct AtlasEntry
+{
+    int sheetID;
+    SDL_Surface *surface;
+    int page;
+    SDL_Point position;
+
+    /// @brief Dimensions de l'image d'origine et facteur d'agrandissement
+    /// appliqué à la surface.
+    SDL_Point size;
+    float scale;
+} AtlasEntry;
+
+static int AtlasEntry_compare(const void *a, const void *b)
+{
+    const AtlasEntry *entryA = (const AtlasEntry *)a;
+    const AtlasEntry *entryB = (const AtlasEntry *)b;
+
+    // Hauteurs décroissantes puis largeurs décroissantes
+    if (entryA->surface->h != entryB->surface->h)
+        return entryB->surface->h - entryA->surface->h;
+    return entryB->surface->w - entryA->surface->w;
+}
+
+void AssetManager_buildAtlas(AssetManager *self)
+{
+    assert(self && "The AssetManager must be created");
+    if (self->m_atlasCount > 0)
+    {
+        printf("WARNING - The sprite atlas is already built\n");
+        return;
+    }
+
+    int atlasW = ASSET_ATLAS_MAX_SIZE;
+    int atlasH = ASSET_ATLAS_MAX_SIZE;
+    SDL_RendererInfo info = { 0 };
+    if (SDL_GetRendererInfo(g_renderer, &info) == 0)
+    {
+        if (info.max_texture_width > 0 && info.max_texture_width < atlasW)
+            atlasW = info.max_texture_width;
+        if (info.max_texture_height > 0 && info.max_texture_height < atlasH)
+            atlasH = info.max_texture_height;
+    }
+
+    AtlasEntry *entries = (AtlasEntry *)calloc(self->m_spriteCapacity, sizeof(AtlasEntry));
+    AssertNew(entries);
+
+    // Charge les images des sprite sheets candidates
+    int entryCount = 0;
+    for (int i = 0; i < self->m_spriteCapacity; i++)
+    {
+        SpriteSheetData *spriteData = self->m_spriteData + i;
+        if (spriteData->m_fileName == NULL ||
+            (spriteData->m_spriteSheet && spriteData->m_spriteSheet->texture))
+            continue;
+
+        // La taille limite porte sur l'image agrandie, placée dans l'atlas
+        SDL_Surface *surface = SpriteSheetData_loadSurface(spriteData);
+        SDL_Point size = { surface->w, surface->h };
+        float scale = AssetManager_clampScale(self->m_spriteScale, size.x, size.y);
+        if ((float)size.x * scale > (float)ASSET_ATLAS_MAX_SHEET_SIZE ||
+            (float)size.y * scale > (float)ASSET_ATLAS_MAX_SHEET_SIZE)
+        {
+            SDL_FreeSurface(surface);
+            continue;
+        }
+        if (scale != 1.f)
+        {
+            SDL_Surface *scaled = AssetManager_scaleSurface(surface, scale);
+            SDL_FreeSurface(surface);
+            surface = scaled;
+        }
+
+        entries[entryCount].sheetID = i;
+        entries[entryCount].surface = surface;
+        entries[entryCount].page = -1;
+        entries[entryCount].size = size;
+        entries[entryCount].scale = scale;
+        entryCount++;
+    }
+
+    // Place les sprite sheets, les plus hautes d'abord
+    qsort(entries, entryCount, sizeof(AtlasEntry), AtlasEntry_compare);
+
+    SkylinePacker *packers[ASSET_ATLAS_MAX_PAGES] = { 0 };
+    int pageCount = 0;
+    for (int i = 0; i < entryCount; i++)
+    {
+        AtlasEntry *entry = entries + i;
+        int w = entry->surface->w + 2 * ASSET_ATLAS_PADDING;
+        int h = entry->surface->h + 2 * ASSET_ATLAS_PADDING;
+
+        for (int page = 0; page < ASSET_ATLAS_MAX_PAGES; page++)
+        {
+            if (page == pageCount)
+            {
+                packers[page] = SkylinePacker_create(atlasW, atlasH);
+                pageCount++;
+            }
+            if (SkylinePacker_insert(packers[page], w, h, &(entry->position)))
+            {
+                entry->page = page;
+                entry->position.x += ASSET_ATLAS_PADDING;
+                entry->position.y += ASSET_ATLAS_PADDING;
+                break;
+            }
+        }
+        if (entry->page < 0)
+        {
+            printf("WARNING - Sprite sheet %s does not fit in the atlas\n",
+                self->m_spriteData[entry->sheetID].m_fileName);
+        }
+    }
+
+    // Crée les atlas en copiant les images à leur place
+    for (int page = 0; page < pageCount; page++)
+    {
+        int usedW = 0, usedH = 0;
+        for (int i = 0; i < entryCount; i++)
+        {
+            if (entries[i].page != page) continue;
+            usedW = SDL_max(usedW, entries[i].position.x + entries[i].surface->w + ASSET_ATLAS_PADDING);
+            usedH = SDL_max(usedH, entries[i].position.y + entries[i].surface->h + ASSET_ATLAS_PADDING);
+        }
+
+        SDL_Surface *atlasSurface = SDL_CreateRGBSurfaceWithFormat(
+            0, usedW, usedH, 32, SDL_PIXELFORMAT_RGBA32);
+        AssertNew(atlasSurface);
+
+        for (int i = 0; i < entryCount; i++)
+        {
+            if (entries[i].page != page) continue;
+
+            SDL_Rect dstRect = {
+                entries[i].position.x, entries[i].position.y,
+                entries[i].surface->w, entries[i].surface->h
+            };
+            SDL_SetSurfaceBlendMode(entries[i].surface, SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(entries[i].surface, NULL, atlasSurface, &dstRect);
+        }
+
+        SDL_Texture *texture = SDL_CreateTextureFromSurface(g_renderer, atlasSurface);
+        if (texture == NULL)
+        {
+            printf("ERROR - Create sprite atlas %s\n", SDL_GetError());
+            assert(false);
+            abort();
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        if (self->m_keepImages)
+        {
+            self->m_atlasImages[self->m_atlasCount] = SoftImage_createFromSurface(atlasSurface);
+        }
+        SDL_FreeSurface(atlasSurface);
+
+        self->m_atlases[self->m_atlasCount++] = texture;
+
+        printf("INFO - Sprite atlas %d: %dx%d, occupancy %.1f%%\n",
+            page, usedW, usedH,
+            100.f * SkylinePacker_getOccupancy(packers[page]) *
+            (float)(atlasW * atlasH) / (float)(usedW * usedH));
+    }
+
+    // Les sprite sheets placées utilisent l'atlas
+    for (int i = 0; i < entryCount; i++)
+    {
+        AtlasEntry *entry = entries + i;
+        if (entry->page >= 0)
+        {
+            SpriteSheetData *spriteData = self->m_spriteData + entry->sheetID;
+            SpriteSheet *spriteSheet = spriteData->m_spriteSheet;
+            if (spriteSheet == NULL)
+            {
+                spriteSheet = (SpriteSheet *)calloc(1, sizeof(SpriteSheet));
+                AssertNew(spriteSheet);
+                spriteSheet->opacity = 255;
+                spriteData->m_spriteSheet = spriteSheet;
+            }
+
+            spriteData->m_inAtlas = true;
+            spriteData->m_scale = entry->scale;
+            spriteSheet->texture = self->m_atlases[entry->page];
+            spriteSheet->image = self->m_atlasImages[entry->page];
+            SpriteSheetData_initRects(spriteData, entry->size.x);
+
+            for (int j = 0; j < spriteSheet->rectCount; j++)
+            {
+                spriteSheet->rects[j].x += entry->position.x;
+                spriteSheet->rects[j].y += entry->position.y;
+            }
+        }
+        SDL_FreeSurface(entry->surface);
+    }
+
+    for (int page = 0; page < pageCount; page++)
+    {
+        SkylinePacker_destroy(packers[page]);
+    }
+    free(entries);
+}
+
+void AssetManager_setKeepImages(AssetManager *self, bool keepImages)
 {
-    SpriteSheet *spriteSheet = (SpriteSheet *)calloc(1, sizeof(SpriteSheet));
-    AssertNew(spriteSheet);
+    assert(self && "The AssetManager must be created");
+    self->m_keepImages = keepImages;
+}
+
+bool AssetManager_setSpriteScale(AssetManager *self, float scale)
+{
+    assert(self && "The AssetManager must be created");
+    assert(scale > 0.f);
+    if (fabsf(scale - self->m_spriteScale) < 1e-3f)
+        return false;
+
+    self->m_spriteScale = scale;
+
+    // Décharge les sprite sheets en conservant leurs structures,
+    // déjà référencées par les objets de la scène
+    bool *loaded = (bool *)calloc(self->m_spriteCapacity, sizeof(bool));
+    AssertNew(loaded);
+    for (int i = 0; i < self->m_spriteCapacity; i++)
+    {
+        SpriteSheetData *spriteData = self->m_spriteData + i;
+        loaded[i] = (spriteData->m_spriteSheet && spriteData->m_spriteSheet->texture);
+        SpriteSheetData_unload(spriteData);
+    }
+
+    bool rebuildAtlas = (self->m_atlasCount > 0);
+    for (int i = 0; i < self->m_atlasCount; i++)
+    {
+        SDL_DestroyTexture(self->m_atlases[i]);
+        SoftImage_destroy(self->m_atlasImages[i]);
+        self->m_atlases[i] = NULL;
+        self->m_atlasImages[i] = NULL;
+    }
+    self->m_atlasCount = 0;
+
+    // Recharge les sprite sheets au nouveau facteur
+    if (rebuildAtlas)
+    {
+        AssetManager_buildAtlas(self);
+    }
+    for (int i = 0; i < self->m_spriteCapacity; i++)
+    {
+        if (loaded[i]) AssetManager_loadSpriteSheet(self, i);
+    }
+    free(loaded);
 
-    self->m_spriteSheet = spriteSheet;
+    printf("INFO - Sprite sheets scaled by %.2f\n", scale);
+    return true;
+}
+
+static SDL_Surface *AssetManager_scaleSurface(SDL_Surface *surface, float scale)
+{
+    int w = (int)((float)surface->w * scale + 0.5f);
+    int h = (int)((float)surface->h * scale + 0.5f);
+    SDL_Surface *scaled = SDL_CreateRGBSurfaceWithFormat(
+        0, SDL_max(w, 1), SDL_max(h, 1), 32, surface->format->format);
+    AssertNew(scaled);
+
+    // Agrandissement au plus proche voisin, sans mélange
+    SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+    if (SDL_BlitScaled(surface, NULL, scaled, NULL) < 0)
+    {
+        printf("ERROR - Scale surface %s\n", SDL_GetError());
+    }
+    return scaled;
+}
+
+static float AssetManager_clampScale(float scale, int w, int h)
+{
+    SDL_RendererInfo info = { 0 };
+    if (scale == 1.f || SDL_GetRendererInfo(g_renderer, &info) < 0)
+        return scale;
+
+    if ((info.max_texture_width > 0 && (float)w * scale > (float)info.max_texture_width) ||
+        (info.max_texture_height > 0 && (float)h * scale > (float)info.max_texture_height))
+    {
+        // L'image agrandie ne tient pas dans une texture
+        return 1.f;
+    }
+    return scale;
+}
+
+static void SpriteSheetData_load(SpriteSheetData *self, float scale, bool keepImage)
+{
+    SpriteSheet *spriteSheet = self->m_spriteSheet;
+    if (spriteSheet == NULL)
+    {
+        spriteSheet = (SpriteSheet *)calloc(1, sizeof(SpriteSheet));
+        AssertNew(spriteSheet);
+        spriteSheet->opacity = 255;
+        self->m_spriteSheet = spriteSheet;
+    }
+
+    if (scale != 1.f || self->m_orientation != SPRITE_ORIENTATION_0 || keepImage)
+    {
+        // L'image est tournée et agrandie sur le processeur avant de créer
+        // la texture
+        SDL_Surface *surface = SpriteSheetData_loadSurface(self);
+        int w = surface->w, h = surface->h;
+        scale = AssetManager_clampScale(scale, w, h);
+        if (scale != 1.f)
+        {
+            SDL_Surface *scaled = AssetManager_scaleSurface(surface, scale);
+            SDL_FreeSurface(surface);
+            surface = scaled;
+        }
+        spriteSheet->texture = SDL_CreateTextureFromSurface(g_renderer, surface);
+        if (keepImage)
+        {
+            spriteSheet->image = SoftImage_createFromSurface(surface);
+        }
+        SDL_FreeSurface(surface);
+        if (spriteSheet->texture == NULL)
+        {
+            printf("ERROR - Loading m_spriteSheet %s\n", self->m_fileName);
+            printf("      - %s\n", SDL_GetError());
+            assert(false);
+            abort();
+        }
+        SDL_SetTextureBlendMode(spriteSheet->texture, SDL_BLENDMODE_BLEND);
+
+        self->m_scale = scale;
+        SpriteSheetData_initRects(self, w);
+        return;
+    }
+    self->m_scale = 1.f;
 
     void *buffer = NULL;
     SDL_RWops *rwops = NULL;
@@ -334,39 +762,171 @@ static void SpriteSheetData_load(SpriteSheetData *self)
     AssetManager_destroyRWops(rwops, buffer);
     rwops = NULL; buffer = NULL;
 
+    int w = 0;
+    SDL_QueryTexture(spriteSheet->texture, NULL, NULL, &w, NULL);
+    SpriteSheetData_initRects(self, w);
+}
+
+static SDL_Surface *SpriteSheetData_loadSurface(SpriteSheetData *self)
+{
+    void *buffer = NULL;
+    SDL_RWops *rwops = NULL;
+    AssetManager_createRWops(self->m_fileName, &rwops, &buffer);
+
+    SDL_Surface *surface = IMG_Load_RW(rwops, 0);
+    if (surface == NULL)
+    {
+        printf("ERROR - Loading m_spriteSheet %s\n", self->m_fileName);
+        printf("      - %s\n", IMG_GetError());
+        assert(false);
+        abort();
+    }
+
+    AssetManager_destroyRWops(rwops, buffer);
+    rwops = NULL; buffer = NULL;
+
+    SDL_Surface *converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(surface);
+    AssertNew(converted);
+
+    if (self->m_orientation != SPRITE_ORIENTATION_0)
+    {
+        SDL_Surface *rotated = SpriteSheetData_rotateSurface(self, converted);
+        SDL_FreeSurface(converted);
+        converted = rotated;
+    }
+
+    return converted;
+}
+
+static SDL_Surface *SpriteSheetData_rotateSurface(SpriteSheetData *self, SDL_Surface *surface)
+{
+    // Chaque sprite est tourné sur place : la grille garde le même nombre
+    // de lignes et de colonnes, seules les dimensions des sprites changent
+    const int rw = self->m_rectWidth;
+    const int rh = self->m_rectHeight;
+    const int cols = SDL_max(surface->w / rw, 1);
+    const int rows = SDL_max(surface->h / rh, 1);
+    const bool quarter = (self->m_orientation == SPRITE_ORIENTATION_90 ||
+                          self->m_orientation == SPRITE_ORIENTATION_270);
+    const int bw = quarter ? rh : rw;
+    const int bh = quarter ? rw : rh;
+
+    SDL_Surface *rotated = SDL_CreateRGBSurfaceWithFormat(
+        0, cols * bw, rows * bh, 32, SDL_PIXELFORMAT_RGBA32);
+    AssertNew(rotated);
+
+    SDL_LockSurface(surface);
+    SDL_LockSurface(rotated);
+    const int srcPitch = surface->pitch / 4;
+    const int dstPitch = rotated->pitch / 4;
+    const Uint32 *srcPixels = (const Uint32 *)surface->pixels;
+    Uint32 *dstPixels = (Uint32 *)rotated->pixels;
+
+    for (int row = 0; row < rows; row++)
+    {
+        for (int col = 0; col < cols; col++)
+        {
+            const Uint32 *src = srcPixels + (row * rh) * srcPitch + col * rw;
+            Uint32 *dst = dstPixels + (row * bh) * dstPitch + col * bw;
+            for (int y = 0; y < rh && row * rh + y < surface->h; y++)
+            {
+                for (int x = 0; x < rw && col * rw + x < surface->w; x++)
+                {
+                    // Rotation dans le sens horaire (l'axe y est orienté vers le bas)
+                    int nx = x, ny = y;
+                    switch (self->m_orientation)
+                    {
+                    case SPRITE_ORIENTATION_90:  nx = rh - 1 - y; ny = x; break;
+                    case SPRITE_ORIENTATION_180: nx = rw - 1 - x; ny = rh - 1 - y; break;
+                    case SPRITE_ORIENTATION_270: nx = y; ny = rw - 1 - x; break;
+                    default: break;
+                    }
+                    dst[ny * dstPitch + nx] = src[y * srcPitch + x];
+                }
+            }
+        }
+    }
+
+    SDL_UnlockSurface(rotated);
+    SDL_UnlockSurface(surface);
+    return rotated;
+}
+
+static void SpriteSheetData_initRects(SpriteSheetData *self, int w)
+{
+    SpriteSheet *spriteSheet = self->m_spriteSheet;
     int rectCount = self->m_rectCount;
     spriteSheet->rectCount = rectCount;
+    spriteSheet->orientation = self->m_orientation;
     spriteSheet->rects = (SDL_Rect *)calloc(rectCount, sizeof(SDL_Rect));
     AssertNew(spriteSheet->rects);
 
-    int w, h;
-    SDL_QueryTexture(spriteSheet->texture, NULL, NULL, &w, &h);
+    // Dimensions des sprites dans l'image tournée
+    bool quarter = (self->m_orientation == SPRITE_ORIENTATION_90 ||
+                    self->m_orientation == SPRITE_ORIENTATION_270);
+    int rectWidth = quarter ? self->m_rectHeight : self->m_rectWidth;
+    int rectHeight = quarter ? self->m_rectWidth : self->m_rectHeight;
 
     int x = 0, y = 0;
     for (int i = 0; i < rectCount; i++)
     {
-        spriteSheet->rects[i].w = self->m_rectWidth;
-        spriteSheet->rects[i].h = self->m_rectHeight;
+        spriteSheet->rects[i].w = rectWidth;
+        spriteSheet->rects[i].h = rectHeight;
         spriteSheet->rects[i].x = x;
         spriteSheet->rects[i].y = y;
 
-        x += self->m_rectWidth;
-        if (x > w - self->m_rectWidth)
+        x += rectWidth;
+        if (x > w - rectWidth)
         {
             x = 0;
-            y += self->m_rectHeight;
+            y += rectHeight;
+        }
+    }
+
+    if (self->m_scale != 1.f)
+    {
+        // Les bords sont arrondis séparément pour que les sprites voisins
+        // restent jointifs dans l'image agrandie
+        const float scale = self->m_scale;
+        for (int i = 0; i < rectCount; i++)
+        {
+            SDL_Rect *rect = spriteSheet->rects + i;
+            int x0 = (int)((float)rect->x * scale + 0.5f);
+            int y0 = (int)((float)rect->y * scale + 0.5f);
+            int x1 = (int)((float)(rect->x + rect->w) * scale + 0.5f);
+            int y1 = (int)((float)(rect->y + rect->h) * scale + 0.5f);
+            rect->x = x0;
+            rect->y = y0;
+            rect->w = x1 - x0;
+            rect->h = y1 - y0;
         }
     }
 }
 
-static void SpriteSheetData_clear(SpriteSheetData *self)
+static void SpriteSheetData_unload(SpriteSheetData *self)
 {
-    if (self->m_spriteSheet)
+    SpriteSheet *spriteSheet = self->m_spriteSheet;
+    if (spriteSheet)
     {
-        free(self->m_spriteSheet->rects);
-        if (self->m_spriteSheet->texture)
-            SDL_DestroyTexture(self->m_spriteSheet->texture);
+        free(spriteSheet->rects);
+        if (spriteSheet->texture && self->m_inAtlas == false)
+            SDL_DestroyTexture(spriteSheet->texture);
+        if (self->m_inAtlas == false)
+            SoftImage_destroy(spriteSheet->image);
+        spriteSheet->rects = NULL;
+        spriteSheet->rectCount = 0;
+        spriteSheet->texture = NULL;
+        spriteSheet->image = NULL;
     }
+    self->m_inAtlas = false;
+    self->m_scale = 1.f;
+}
+
+static void SpriteSheetData_clear(SpriteSheetData *self)
+{
+    SpriteSheetData_unload(self);
+    free(self->m_spriteSheet);
     free(self->m_fileName);
     memset(self, 0, sizeof(SpriteSheetData));
 }
@@ -9,12 +9,38 @@
 #include "settings.h"
 #include "utils/text.h"
 
+/// @brief Rotations pouvant être appliquées aux images d'une sprite sheet
+/// lors de son chargement, en degrés dans le sens horaire.
+typedef enum SpriteOrientation
+{
+    SPRITE_ORIENTATION_0 = 0,
+    SPRITE_ORIENTATION_90 = 90,
+    SPRITE_ORIENTATION_180 = 180,
+    SPRITE_ORIENTATION_270 = 270,
+} SpriteOrientation;
+
+typedef struct SoftImage SoftImage;
+
 /// @brief Structure représentant un atlas de textures.
 typedef struct SpriteSheet
 {
     SDL_Texture *texture;
     SDL_Rect *rects;
     int rectCount;
+
+    /// @brief Rotation intégrée à chaque sprite de la texture
+    /// (SpriteOrientation). Les copies sont exprimées par rapport aux images
+    /// d'origine : la rotation intégrée est retranchée de leur angle.
+    int orientation;
+
+    /// @brief Copie de la texture en mémoire centrale utilisée par le
+    /// SoftBlitter, ou NULL si elle n'est pas conservée.
+    /// Les rectangles des sprites y sont les mêmes que dans la texture.
+    SoftImage *image;
+
+    /// @brief Opacité appliquée à chaque copie d'un sprite de la sprite
+    /// sheet (voir SpriteSheet_setOpacity()).
+    Uint8 opacity;
 } SpriteSheet;
 
 /// @brief Copie un sprite d'une sprite sheet vers la cible du moteur de rendu.
@@ -25,18 +51,52 @@ typedef struct SpriteSheet
 /// @param angle l'angle de rotation, en degrés.
 /// @param center le centre de rotation, ou NULL pour le centre de l'image.
 /// @param flip flag indiquant quels retrounements (horizontal, vertical) sont appliqués à la copie.
+/// Si l'angle correspond à la rotation intégrée à la sprite sheet et qu'aucun
+/// retournement n'est demandé, la copie utilise SDL_RenderCopyF(), plus
+/// rapide que SDL_RenderCopyExF().
 void SpriteSheet_renderCopyF(
     SpriteSheet *self, int index,
     SDL_Renderer *renderer, const SDL_FRect *dstRect,
     const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip);
 
+/// @brief Convertit les paramètres d'une copie d'un sprite, exprimés pour
+/// l'image d'origine, en paramètres de copie de l'image tournée stockée
+/// dans la texture. La copie obtenue tourne autour du centre du rectangle.
+/// @param[in] self la sprite sheet.
+/// @param[in] dstRect le rectangle de destination de l'image d'origine.
+/// @param[in] angle l'angle de rotation de l'image d'origine, en degrés.
+/// @param[in] center le centre de rotation, ou NULL pour le centre de dstRect.
+/// @param[in] flip les retournements de l'image d'origine.
+/// @param[out] bakedRect le rectangle de destination de l'image tournée.
+/// @param[out] bakedAngle l'angle de rotation restant à appliquer.
+/// @param[out] bakedFlip les retournements à appliquer à l'image tournée.
+void SpriteSheet_getBakedCopy(
+    SpriteSheet *self, const SDL_FRect *dstRect,
+    double angle, const SDL_FPoint *center, SDL_RendererFlip flip,
+    SDL_FRect *bakedRect, double *bakedAngle, SDL_RendererFlip *bakedFlip);
+
 /// @brief Modifie l'opacité d'une sprite sheet.
 /// Cette fonction doit être appliquée avant une opération de copie sur le rendu
-/// pour être prise en compte.
+/// pour être prise en compte. L'opacité est propre à la sprite sheet, même
+/// si sa texture est partagée dans un atlas.
 /// @param self la sprite sheet.
 /// @param alpha l'opacité (0 pour transparant, 255 pour opaque).
 void SpriteSheet_setOpacity(SpriteSheet *self, Uint8 alpha);
 
+/// @brief Nombre maximal de textures atlas créées par AssetManager_buildAtlas().
+#define ASSET_ATLAS_MAX_PAGES 4
+
+/// @brief Dimension maximale d'une texture atlas (en pixels).
+#define ASSET_ATLAS_MAX_SIZE 2048
+
+/// @brief Dimension maximale d'une sprite sheet placée dans un atlas.
+/// Les images plus grandes (fonds d'écran) gardent leur propre texture.
+#define ASSET_ATLAS_MAX_SHEET_SIZE 512
+
+/// @brief Marge transparente autour de chaque sprite sheet d'un atlas
+/// (en pixels), évite que le filtrage ne mélange deux sprite sheets.
+#define ASSET_ATLAS_PADDING 1
+
 typedef struct SpriteSheetData SpriteSheetData;
 typedef struct FontData FontData;
 typedef struct SoundData SoundData;
@@ -57,6 +117,21 @@ typedef struct AssetManager
 
     int m_soundCapacity;
     SoundData *m_soundData;
+
+    /// @brief Textures atlas partagées par plusieurs sprite sheets.
+    SDL_Texture *m_atlases[ASSET_ATLAS_MAX_PAGES];
+    int m_atlasCount;
+
+    /// @brief Copies des atlas en mémoire centrale (voir m_keepImages).
+    SoftImage *m_atlasImages[ASSET_ATLAS_MAX_PAGES];
+
+    /// @brief Booléen indiquant si une copie en mémoire centrale de chaque
+    /// sprite sheet est conservée pour le SoftBlitter.
+    bool m_keepImages;
+
+    /// @brief Facteur d'agrandissement appliqué aux images des sprite sheets
+    /// lors de leur chargement (1 pour les images d'origine).
+    float m_spriteScale;
 } AssetManager;
 
 /// @brief Crée le gestionnaire des assets du jeu.
@@ -81,10 +156,13 @@ void AssetManager_destroy(AssetManager *self);
 /// @param rectCount le nombre de sprites de la sprite sheet.
 /// @param rectWidth la largeur d'un sprite.
 /// @param rectHeight la hauteur d'un sprite.
+/// @param orientation la rotation (SpriteOrientation) appliquée à chaque
+/// sprite lors du chargement. Elle doit correspondre à l'angle habituel des
+/// copies pour qu'elles n'aient plus besoin de rotation.
 void AssetManager_addSpriteSheet(
     AssetManager *self, int sheetID,
     const char *assetsPath, const char *fileName,
-    int rectCount, int rectWidth, int rectHeight);
+    int rectCount, int rectWidth, int rectHeight, int orientation);
 
 /// @brief Ajoute une police au gestionnaire des assets.
 /// @param self le gestionnaire d'assets.
@@ -158,6 +236,53 @@ void AssetManager_loadSound(AssetManager *self, int soundID);
 /// @param musicID l'identifiant de la musique.
 void AssetManager_loadMusic(AssetManager *self, int musicID);
 
+/// @brief Charge toutes les sprite sheets et tous les sons répertoriés
+/// dans le gestionnaire d'assets.
+/// Après cet appel, les accesseurs AssetManager_getSpriteSheet() et
+/// AssetManager_getSound() ne créent plus de ressources et peuvent être
+/// utilisés hors du thread de rendu.
+/// @param self le gestionnaire d'assets.
+void AssetManager_preload(AssetManager *self);
+
+/// @brief Charge les sprite sheets répertoriées et non encore chargées en
+/// les regroupant dans une ou quelques textures atlas.
+/// Les rectangles de chaque sprite sheet sont exprimés dans l'atlas, les
+/// copies avec SpriteSheet_renderCopyF() sont donc inchangées.
+/// Les sprite sheets trop grandes ou qui ne tiennent dans aucun atlas sont
+/// chargées normalement lors de leur premier accès.
+/// @param self le gestionnaire d'assets.
+void AssetManager_buildAtlas(AssetManager *self);
+
+/// @brief Définit le facteur d'agrandissement des sprite sheets.
+/// Les images sont agrandies au plus proche voisin lors de leur chargement
+/// et les rectangles des sprites sont mis à l'échelle : si le facteur
+/// correspond à l'agrandissement du rendu, chaque copie devient une copie
+/// pixel à pixel, sans filtrage ni mise à l'échelle lors du dessin.
+/// Les sprite sheets déjà chargées (et l'atlas) sont rechargées au nouveau
+/// facteur ; les pointeurs SpriteSheet restent valides mais leurs textures
+/// changent. Une sprite sheet dont l'image agrandie dépasserait la taille
+/// maximale d'une texture garde sa taille d'origine.
+/// @param self le gestionnaire d'assets.
+/// @param scale le facteur d'agrandissement (1 pour les images d'origine).
+/// @return true si le facteur a changé.
+bool AssetManager_setSpriteScale(AssetManager *self, float scale);
+
+/// @brief Indique si une copie en mémoire centrale des sprite sheets doit
+/// être conservée pour le SoftBlitter (membre image de SpriteSheet).
+/// Seules les sprite sheets chargées après l'appel sont concernées.
+/// @param self le gestionnaire d'assets.
+/// @param keepImages true pour conserver les copies.
+void AssetManager_setKeepImages(AssetManager *self, bool keepImages);
+
+/// @brief Renvoie le facteur d'agrandissement des sprite sheets.
+/// @param self le gestionnaire d'assets.
+/// @return Le facteur d'agrandissement.
+INLINE float AssetManager_getSpriteScale(AssetManager *self)
+{
+    assert(self && "The AssetManager must be created");
+    return self->m_spriteScale;
+}
+
 struct SpriteSheetData
 {
     SpriteSheet *m_spriteSheet;
@@ -165,6 +290,17 @@ struct SpriteSheetData
     int m_rectCount;
     int m_rectWidth;
     int m_rectHeight;
+
+    /// @brief Booléen indiquant si la texture de la sprite sheet est un
+    /// atlas appartenant au gestionnaire d'assets.
+    bool m_inAtlas;
+
+    /// @brief Facteur d'agrandissement de l'image chargée.
+    float m_scale;
+
+    /// @brief Rotation appliquée aux sprites lors du chargement
+    /// (SpriteOrientation).
+    int m_orientation;
 };
 
 struct FontData
@@ -35,6 +35,14 @@ void AxisData_resetPressed(AxisData *self)
     self->m_flags &= ~AXIS_BUTTON_PRESSED;
 }
 
+void AxisData_accumulate(AxisData *self, const AxisData *src)
+{
+    assert(self && src);
+    int pressed = self->m_flags & AXIS_BUTTON_PRESSED;
+    *self = *src;
+    self->m_flags |= pressed;
+}
+
 Vec2 AxisData_getAxis(AxisData *self)
 {
     assert(self && "The AxisData must be created");
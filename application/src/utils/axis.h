@@ -18,6 +18,7 @@ typedef struct AxisData
 
 void AxisData_init(AxisData *self, float deadZone);
 void AxisData_resetPressed(AxisData *self);
+void AxisData_accumulate(AxisData *self, const AxisData *src);
 Vec2 AxisData_getAxis(AxisData *self);
 void AxisData_setValueX(AxisData *self, Sint16 value);
 void AxisData_setValueY(AxisData *self, Sint16 value);
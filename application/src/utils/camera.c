@@ -6,6 +6,8 @@
 
 #include "utils/camera.h"
 
+static void Camera_updateTransform(Camera *self);
+
 Camera *Camera_create(int width, int height)
 {
     Camera *self = (Camera *)calloc(1, sizeof(Camera));
@@ -16,7 +18,13 @@ Camera *Camera_create(int width, int height)
 
     self->m_rasterWidth = width;
     self->m_rasterHeight = height;
-    self->m_worldView = AABB_set(0.0f, 0.0f, worldW, worldH);
+    // La vue est construite sans Vec2_set() : la caméra fonctionne avant
+    // que les fonctions de math.c soient codées
+    self->m_worldView.lower.x = 0.0f;
+    self->m_worldView.lower.y = 0.0f;
+    self->m_worldView.upper.x = worldW;
+    self->m_worldView.upper.y = worldH;
+    Camera_updateTransform(self);
 
     return self;
 }
@@ -27,35 +35,66 @@ void Camera_destroy(Camera *self)
     free(self);
 }
 
-void Camera_worldToView(Camera *self, Vec2 position, float *x, float *y)
+void Camera_worldToViewBatch(
+    Camera *self, const float *x, const float *y,
+    float *viewX, float *viewY, int count)
 {
     assert(self && "The Camera must be created");
-    assert(x && y);
-    float w = self->m_worldView.upper.x - self->m_worldView.lower.x;
-    float h = self->m_worldView.upper.y - self->m_worldView.lower.y;
-    float xScale = (float)self->m_rasterWidth  / w;
-    float yScale = (float)self->m_rasterHeight / h;
-    *x = (position.x - self->m_worldView.lower.x) * xScale;
-    *y = (position.y - self->m_worldView.lower.y) * yScale;
-    *y = (float)self->m_rasterHeight - *y;
+    assert((x && y && viewX && viewY) || count == 0);
+
+    const float xScale = self->m_xScale, xOffset = self->m_xOffset;
+    const float yScale = self->m_yScale, yOffset = self->m_yOffset;
+    int i = 0;
+
+#if defined(__SSE__)
+    const __m128 xs = _mm_set1_ps(xScale), xo = _mm_set1_ps(xOffset);
+    const __m128 ys = _mm_set1_ps(yScale), yo = _mm_set1_ps(yOffset);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x4 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x + i), xs), xo);
+        __m128 y4 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(y + i), ys), yo);
+        _mm_storeu_ps(viewX + i, x4);
+        _mm_storeu_ps(viewY + i, y4);
+    }
+#elif defined(__ARM_NEON)
+    const float32x4_t xo = vdupq_n_f32(xOffset);
+    const float32x4_t yo = vdupq_n_f32(yOffset);
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t x4 = vaddq_f32(vmulq_n_f32(vld1q_f32(x + i), xScale), xo);
+        float32x4_t y4 = vaddq_f32(vmulq_n_f32(vld1q_f32(y + i), yScale), yo);
+        vst1q_f32(viewX + i, x4);
+        vst1q_f32(viewY + i, y4);
+    }
+#endif
+
+    // Derniers points, ou tous les points sans instructions vectorielles
+    for (; i < count; i++)
+    {
+        viewX[i] = xScale * x[i] + xOffset;
+        viewY[i] = yScale * y[i] + yOffset;
+    }
 }
 
 void Camera_viewToWorld(Camera *self, float x, float y, Vec2 *position)
 {
     assert(self && "The Camera must be created");
-    y = self->m_rasterHeight - y;
-    float ratioX = (float)x / (float)self->m_rasterWidth;
-    float ratioY = (float)y / (float)self->m_rasterHeight;
-    float w = self->m_worldView.upper.x - self->m_worldView.lower.x;
-    float h = self->m_worldView.upper.y - self->m_worldView.lower.y;
-    position->x = self->m_worldView.lower.x + ratioX * w;
-    position->y = self->m_worldView.lower.y + ratioY * h;
+    position->x = (x - self->m_xOffset) / self->m_xScale;
+    position->y = (y - self->m_yOffset) / self->m_yScale;
+}
+
+void Camera_setWorldView(Camera *self, AABB worldView)
+{
+    assert(self && "The Camera must be created");
+    self->m_worldView = worldView;
+    Camera_updateTransform(self);
 }
 
 void Camera_translateWorldView(Camera *self, Vec2 displacement)
 {
     assert(self && "The Camera must be created");
     AABB_translate(&self->m_worldView, displacement);
+    Camera_updateTransform(self);
 }
 
 int Camera_getWidth(Camera *self)
@@ -70,9 +109,12 @@ int Camera_getHeight(Camera *self)
     return self->m_rasterHeight;
 }
 
-float Camera_getWorldToViewScale(Camera *self)
+static void Camera_updateTransform(Camera *self)
 {
-    assert(self && "The Camera must be created");
     float w = self->m_worldView.upper.x - self->m_worldView.lower.x;
-    return (float)self->m_rasterWidth / w;
+    float h = self->m_worldView.upper.y - self->m_worldView.lower.y;
+    self->m_xScale = (float)self->m_rasterWidth / w;
+    self->m_yScale = -(float)self->m_rasterHeight / h;
+    self->m_xOffset = -self->m_worldView.lower.x * self->m_xScale;
+    self->m_yOffset = (float)self->m_rasterHeight - self->m_worldView.lower.y * self->m_yScale;
 }
\ No newline at end of file
@@ -21,6 +21,15 @@ typedef struct Camera
 
     /// @brief Hauteur (en pixels) du référentiel vue de la caméra.
     int m_rasterHeight;
+
+    /// @brief Transformation affine du référentiel monde vers le référentiel
+    /// vue, recalculée à chaque modification de la vue :
+    /// xVue = m_xScale * x + m_xOffset et yVue = m_yScale * y + m_yOffset.
+    /// L'échelle verticale est négative car l'axe y de la vue est inversé.
+    float m_xScale;
+    float m_yScale;
+    float m_xOffset;
+    float m_yOffset;
 } Camera;
 
 /// @brief Crée une nouvelle caméra.
@@ -43,16 +52,23 @@ INLINE AABB Camera_getWorldView(Camera *self)
     return self->m_worldView;
 }
 
-/// @brief Définit le rectangle vu par la caméra.
+/// @brief Renvoie la boîte visible par la caméra, utilisée pour éliminer
+/// les objets hors de la vue avant leur rendu.
 /// Les coordonnées sont exprimées dans le référentiel monde.
 /// @param self la caméra.
-/// @param worldView le rectangle.
-INLINE void Camera_setWorldView(Camera *self, AABB worldView)
+/// @return La boîte visible par la caméra.
+INLINE AABB Camera_getVisibleAABB(Camera *self)
 {
     assert(self && "The Camera must be created");
-    self->m_worldView = worldView;
+    return self->m_worldView;
 }
 
+/// @brief Définit le rectangle vu par la caméra.
+/// Les coordonnées sont exprimées dans le référentiel monde.
+/// @param self la caméra.
+/// @param worldView le rectangle.
+void Camera_setWorldView(Camera *self, AABB worldView);
+
 /// @brief Déplace le rectangle vu par la caméra.
 /// Les coordonnées sont exprimées dans le référentiel monde.
 /// @param self la caméra.
@@ -74,7 +90,11 @@ int Camera_getHeight(Camera *self);
 /// exprimées dans le référentiel vue (en pixels).
 /// @param self la caméra.
 /// @return Le facteur d'échelle monde vers vue (en pixels).
-float Camera_getWorldToViewScale(Camera *self);
+INLINE float Camera_getWorldToViewScale(Camera *self)
+{
+    assert(self && "The Camera must be created");
+    return self->m_xScale;
+}
 
 /// @brief Transforme des coordonnées exprimées dans le référentiel monde vers
 /// le référentiel vue (en pixels).
@@ -82,7 +102,28 @@ float Camera_getWorldToViewScale(Camera *self);
 /// @param[in] position la position d'un point dans le référentiel monde.
 /// @param[out] x l'abscisse du point dans la vue (en pixels).
 /// @param[out] y l'ordonnée du point dans la vue (en pixels).
-void Camera_worldToView(Camera *self, Vec2 position, float *x, float *y);
+INLINE void Camera_worldToView(Camera *self, Vec2 position, float *x, float *y)
+{
+    assert(self && "The Camera must be created");
+    assert(x && y);
+    *x = self->m_xScale * position.x + self->m_xOffset;
+    *y = self->m_yScale * position.y + self->m_yOffset;
+}
+
+/// @brief Transforme un tableau de points exprimés dans le référentiel monde
+/// vers le référentiel vue (en pixels).
+/// Les coordonnées sont données dans des tableaux séparés et les points
+/// sont transformés quatre par quatre avec les instructions vectorielles.
+/// Les tableaux de sortie peuvent être ceux d'entrée.
+/// @param[in] self la caméra.
+/// @param[in] x les abscisses des points dans le référentiel monde.
+/// @param[in] y les ordonnées des points dans le référentiel monde.
+/// @param[out] viewX les abscisses des points dans la vue (en pixels).
+/// @param[out] viewY les ordonnées des points dans la vue (en pixels).
+/// @param[in] count le nombre de points.
+void Camera_worldToViewBatch(
+    Camera *self, const float *x, const float *y,
+    float *viewX, float *viewY, int count);
 
 /// @brief Transforme des coordonnées exprimée dans le référentiel de la vue
 /// (en pixels) vers le référentiel monde.
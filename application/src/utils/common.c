@@ -8,13 +8,16 @@
 #include "utils/asset_manager.h"
 
 Timer *g_time = NULL;
+FramePacer *g_pacer = NULL;
 SDL_Renderer *g_renderer = NULL;
+RenderState *g_renderState = NULL;
 SDL_Window *g_window = NULL;
 
 static int g_rendererW = 0;
 static int g_rendererH = 0;
+static bool g_soundFXMuted = false;
 
-void Game_init(int sdlFlags, int imgFlags, int mixFlags)
+void Game_init(int sdlFlags, int imgFlags, int mixFlags, float targetFPS)
 {
     // Initialise la SDL2
     if (SDL_Init(sdlFlags) < 0)
@@ -58,6 +61,10 @@ void Game_init(int sdlFlags, int imgFlags, int mixFlags)
     // Crée le temps global du jeu
     g_time = Timer_create();
     AssertNew(g_time);
+
+    // Crée le régulateur de la cadence d'affichage
+    g_pacer = FramePacer_create(targetFPS);
+    AssertNew(g_pacer);
 }
 
 void Game_createWindow(int width, int height, Uint32 flags)
@@ -78,25 +85,75 @@ void Game_createRenderer(int width, int height)
 {
     assert(g_renderer == NULL && "The renderer is already created");
     assert(g_window);
+
+    // La synchronisation verticale n'est utilisée que si le régulateur
+    // de cadence est désactivé
+    Uint32 vsyncFlag = FramePacer_isEnabled(g_pacer) ? 0 : SDL_RENDERER_PRESENTVSYNC;
+
+    // Pilote demandé (SDL_HINT_RENDER_DRIVER) ou choisi par la SDL
     g_renderer = SDL_CreateRenderer(
-        g_window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC
+        g_window, -1, SDL_RENDERER_ACCELERATED | vsyncFlag
     );
+    if (!g_renderer)
+    {
+        printf("WARNING - Create renderer %s\n", SDL_GetError());
+    }
+
+    // Chaîne de repli : chaque pilote accéléré avec puis sans
+    // synchronisation verticale, puis les pilotes logiciels
+    const Uint32 fallbackFlags[] = {
+        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC,
+        SDL_RENDERER_ACCELERATED,
+        SDL_RENDERER_SOFTWARE
+    };
+    const int passCount = sizeof(fallbackFlags) / sizeof(fallbackFlags[0]);
+    int driverCount = SDL_GetNumRenderDrivers();
+    for (int pass = 0; pass < passCount && !g_renderer; pass++)
+    {
+        Uint32 flags = fallbackFlags[pass];
+        if ((flags & SDL_RENDERER_PRESENTVSYNC) && !vsyncFlag)
+            continue;
+
+        for (int i = 0; i < driverCount && !g_renderer; i++)
+        {
+            SDL_RendererInfo info = { 0 };
+            if (SDL_GetRenderDriverInfo(i, &info) < 0)
+                continue;
+            if ((info.flags & flags & ~SDL_RENDERER_PRESENTVSYNC) == 0)
+                continue;
+
+            g_renderer = SDL_CreateRenderer(g_window, i, flags);
+            if (!g_renderer)
+            {
+                printf("WARNING - Create renderer %s %s\n", info.name, SDL_GetError());
+            }
+        }
+    }
 
     if (!g_renderer)
     {
         printf("ERROR - Create renderer %s\n", SDL_GetError());
         assert(false); abort();
     }
+
+    SDL_RendererInfo info = { 0 };
+    SDL_GetRendererInfo(g_renderer, &info);
+    printf("INFO - Renderer %s%s\n", info.name,
+        (info.flags & SDL_RENDERER_PRESENTVSYNC) ? " (vsync)" : "");
     g_rendererW = width;
     g_rendererH = height;
     SDL_RenderSetLogicalSize(g_renderer, g_rendererW, g_rendererH);
-    SDL_SetRenderDrawBlendMode(g_renderer, SDL_BLENDMODE_BLEND);
+
+    g_renderState = RenderState_create(g_renderer);
+    RenderState_setDrawBlendMode(g_renderState, SDL_BLENDMODE_BLEND);
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
 }
 
 void Game_destroyRenderer()
 {
     if (!g_renderer) return;
+    RenderState_destroy(g_renderState);
+    g_renderState = NULL;
     SDL_DestroyRenderer(g_renderer);
     g_renderer = NULL;
 }
@@ -112,6 +169,8 @@ void Game_quit()
 {
     Timer_destroy(g_time);
     g_time = NULL;
+    FramePacer_destroy(g_pacer);
+    g_pacer = NULL;
 
     Mix_Quit();
     TTF_Quit();
@@ -150,6 +209,8 @@ void Game_setFXChannelsVolume(float volume)
 void Game_playSoundFX(AssetManager *assets, int soundID)
 {
     assert(assets && "The asset manager must be created");
+    if (g_soundFXMuted) return;
+
     Mix_Chunk *chunk = AssetManager_getSound(assets, soundID);
     if (chunk == NULL)
     {
@@ -160,6 +221,11 @@ void Game_playSoundFX(AssetManager *assets, int soundID)
     int exitStatus = Mix_PlayChannel(-1, chunk, loops);
 }
 
+void Game_setSoundFXMuted(bool muted)
+{
+    g_soundFXMuted = muted;
+}
+
 void Game_playMusic(AssetManager *assets, int musicID)
 {
     assert(assets && "The asset manager must be created");
@@ -176,7 +242,7 @@ void Game_playMusic(AssetManager *assets, int musicID)
 void Game_setRenderDrawColor(SDL_Color color, Uint8 alpha)
 {
     assert(g_renderer && "The renderer must be created");
-    SDL_SetRenderDrawColor(g_renderer, color.r, color.g, color.b, alpha);
+    RenderState_setDrawColor(g_renderState, color.r, color.g, color.b, alpha);
 }
 
 void Memcpy(void *const dst, size_t dstSize, const void *src, size_t srcSize)
@@ -8,6 +8,8 @@
 
 #include "settings.h"
 #include "utils/timer.h"
+#include "utils/frame_pacer.h"
+#include "utils/render_state.h"
 
 #define MIX_CHANNEL_COUNT 16
 typedef struct AssetManager AssetManager;
@@ -15,17 +17,25 @@ typedef struct AssetManager AssetManager;
 /// @brief Temps global du jeu.
 extern Timer *g_time;
 
+/// @brief Régulateur de la cadence d'affichage du jeu.
+extern FramePacer *g_pacer;
+
 /// @brief Fenêtre du jeu.
 extern SDL_Window *g_window;
 
 /// @brief Moteur de rendu du jeu.
 extern SDL_Renderer *g_renderer;
 
+/// @brief Suivi de l'état du moteur de rendu du jeu.
+extern RenderState *g_renderState;
+
 /// @brief Initialise les librairies utilisées par le jeu.
 /// @param sdlFlags les flags pour la librairie SDL.
 /// @param imgFlags les flags pour la librairie SDL Image.
 /// @param mixFlags les flags pour la librairie SDL Mixer.
-void Game_init(int sdlFlags, int imgFlags, int mixFlags);
+/// @param targetFPS le nombre d'images par seconde visé par g_pacer,
+///     ou 0 pour laisser la synchronisation verticale réguler l'affichage.
+void Game_init(int sdlFlags, int imgFlags, int mixFlags, float targetFPS);
 
 /// @brief Crée la fenêtre du jeu.
 /// @param width largeur de la fenêtre.
@@ -34,6 +44,12 @@ void Game_init(int sdlFlags, int imgFlags, int mixFlags);
 void Game_createWindow(int width, int height, Uint32 flags);
 
 /// @brief Crée le moteur de rendu.
+/// Le pilote demandé par SDL_HINT_RENDER_DRIVER (ou choisi par la SDL) est
+/// essayé en premier. En cas d'échec, chaque pilote accéléré est essayé
+/// avec puis sans synchronisation verticale, puis les pilotes logiciels.
+/// La synchronisation verticale n'est demandée que si g_pacer est désactivé,
+/// sinon les deux horloges se contrarient.
+/// Le jeu s'arrête si aucun pilote ne fonctionne.
 /// @param width largeur logique du rendu.
 /// @param height hauteur logique du rendu.
 void Game_createRenderer(int width, int height);
@@ -74,6 +90,11 @@ void Game_setFXChannelsVolume(float volume);
 /// @param soundID l'identifiant du son.
 void Game_playSoundFX(AssetManager *assets, int soundID);
 
+/// @brief Coupe ou rétablit les effets sonores.
+/// Lorsqu'ils sont coupés, Game_playSoundFX() n'a aucun effet.
+/// @param muted booléen indiquant si les effets sonores sont coupés.
+void Game_setSoundFXMuted(bool muted);
+
 /// @brief Joue une musique.
 /// @param assets le gestionnaire des assets.
 /// @param musicID l'identifiant de la musique.
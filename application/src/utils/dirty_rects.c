@@ -0,0 +1,190 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "utils/dirty_rects.h"
+#include "utils/math.h"
+
+DirtyRects *DirtyRects_create(int width, int height)
+{
+    assert(width > 0 && height > 0);
+
+    DirtyRects *self = (DirtyRects *)calloc(1, sizeof(DirtyRects));
+    AssertNew(self);
+
+    self->m_width = width;
+    self->m_height = height;
+    self->m_columnCount = (width + DIRTY_RECTS_TILE_SIZE - 1) / DIRTY_RECTS_TILE_SIZE;
+    self->m_rowCount = (height + DIRTY_RECTS_TILE_SIZE - 1) / DIRTY_RECTS_TILE_SIZE;
+
+    int tileCount = self->m_columnCount * self->m_rowCount;
+    self->m_tiles = (Uint8 *)calloc(tileCount, sizeof(Uint8));
+    self->m_prevTiles = (Uint8 *)calloc(tileCount, sizeof(Uint8));
+    AssertNew(self->m_tiles);
+    AssertNew(self->m_prevTiles);
+
+    // Au pire, une tuile sur deux de chaque ligne forme un rectangle
+    int rectCapacity = (self->m_columnCount / 2 + 1) * self->m_rowCount;
+    self->m_rects = (SDL_Rect *)calloc(rectCapacity, sizeof(SDL_Rect));
+    AssertNew(self->m_rects);
+
+    self->m_invalid = true;
+
+    return self;
+}
+
+void DirtyRects_destroy(DirtyRects *self)
+{
+    if (!self) return;
+    free(self->m_tiles);
+    free(self->m_prevTiles);
+    free(self->m_rects);
+    free(self);
+}
+
+void DirtyRects_invalidate(DirtyRects *self)
+{
+    assert(self && "The DirtyRects must be created");
+    self->m_invalid = true;
+}
+
+void DirtyRects_addRect(DirtyRects *self, const SDL_FRect *rect)
+{
+    assert(self && "The DirtyRects must be created");
+    assert(rect);
+
+    // Un pixel de marge couvre le filtrage et l'arrondi des coordonnées
+    int x0 = (int)floorf(rect->x) - 1;
+    int y0 = (int)floorf(rect->y) - 1;
+    int x1 = (int)ceilf(rect->x + rect->w) + 1;
+    int y1 = (int)ceilf(rect->y + rect->h) + 1;
+
+    x0 = Int_clamp(x0, 0, self->m_width);
+    y0 = Int_clamp(y0, 0, self->m_height);
+    x1 = Int_clamp(x1, 0, self->m_width);
+    y1 = Int_clamp(y1, 0, self->m_height);
+    if (x0 >= x1 || y0 >= y1)
+        return;
+
+    int c0 = x0 / DIRTY_RECTS_TILE_SIZE;
+    int c1 = (x1 - 1) / DIRTY_RECTS_TILE_SIZE;
+    int r0 = y0 / DIRTY_RECTS_TILE_SIZE;
+    int r1 = (y1 - 1) / DIRTY_RECTS_TILE_SIZE;
+    for (int r = r0; r <= r1; r++)
+    {
+        memset(self->m_tiles + r * self->m_columnCount + c0, 1, c1 - c0 + 1);
+    }
+}
+
+void DirtyRects_update(DirtyRects *self)
+{
+    assert(self && "The DirtyRects must be created");
+
+    const int columnCount = self->m_columnCount;
+    const int rowCount = self->m_rowCount;
+    const int tileCount = columnCount * rowCount;
+
+    // Une tuile est à redessiner si elle est couverte maintenant
+    // (nouvelle position) ou à l'image précédente (ancienne position)
+    int dirtyCount = 0;
+    for (int i = 0; i < tileCount; i++)
+    {
+        self->m_prevTiles[i] |= self->m_tiles[i];
+        dirtyCount += self->m_prevTiles[i];
+    }
+
+    self->m_rectCount = 0;
+    self->m_fullRedraw =
+        self->m_invalid || (dirtyCount > (int)(DIRTY_RECTS_FULL_RATIO * tileCount));
+
+    if (self->m_fullRedraw == false)
+    {
+        // Regroupe les tuiles de chaque ligne en segments, puis prolonge
+        // vers le bas les rectangles de la ligne précédente de même largeur
+        for (int r = 0; r < rowCount; r++)
+        {
+            const Uint8 *row = self->m_prevTiles + r * columnCount;
+            const int rectCount = self->m_rectCount;
+            int c = 0;
+            while (c < columnCount)
+            {
+                if (row[c] == 0) { c++; continue; }
+
+                int start = c;
+                while (c < columnCount && row[c]) c++;
+
+                SDL_Rect rect = { 0 };
+                rect.x = start * DIRTY_RECTS_TILE_SIZE;
+                rect.y = r * DIRTY_RECTS_TILE_SIZE;
+                rect.w = c * DIRTY_RECTS_TILE_SIZE - rect.x;
+                rect.h = DIRTY_RECTS_TILE_SIZE;
+
+                bool merged = false;
+                for (int i = 0; i < rectCount; i++)
+                {
+                    SDL_Rect *prev = self->m_rects + i;
+                    if (prev->x == rect.x && prev->w == rect.w &&
+                        prev->y + prev->h == rect.y)
+                    {
+                        prev->h += DIRTY_RECTS_TILE_SIZE;
+                        merged = true;
+                        break;
+                    }
+                }
+                if (merged == false)
+                {
+                    self->m_rects[self->m_rectCount++] = rect;
+                }
+            }
+        }
+
+        // Les dernières tuiles peuvent dépasser de l'écran
+        for (int i = 0; i < self->m_rectCount; i++)
+        {
+            SDL_Rect *rect = self->m_rects + i;
+            rect->w = SDL_min(rect->w, self->m_width - rect->x);
+            rect->h = SDL_min(rect->h, self->m_height - rect->y);
+            self->m_totalPixelCount += (Uint64)rect->w * (Uint64)rect->h;
+        }
+    }
+    else
+    {
+        self->m_totalPixelCount += (Uint64)self->m_width * (Uint64)self->m_height;
+        self->m_fullFrameCount++;
+    }
+    self->m_totalRectCount += self->m_rectCount;
+    self->m_frameCount++;
+    self->m_invalid = false;
+
+    // Prépare l'image suivante
+    Uint8 *tiles = self->m_prevTiles;
+    self->m_prevTiles = self->m_tiles;
+    self->m_tiles = tiles;
+    memset(self->m_tiles, 0, tileCount);
+}
+
+void DirtyRects_printStats(DirtyRects *self)
+{
+    assert(self && "The DirtyRects must be created");
+
+    if (self->m_frameCount > 0)
+    {
+        double frameCount = (double)self->m_frameCount;
+        double screenPixels = (double)self->m_width * (double)self->m_height;
+        printf("INFO - Dirty rectangles over %llu frames\n",
+            (unsigned long long)self->m_frameCount);
+        printf("     - %.1f rects/frame, %.1f%% of the screen redrawn\n",
+            (double)self->m_totalRectCount / frameCount,
+            100.0 * (double)self->m_totalPixelCount / frameCount / screenPixels);
+        printf("     - full redraws %llu (%.1f%%)\n",
+            (unsigned long long)self->m_fullFrameCount,
+            100.0 * (double)self->m_fullFrameCount / frameCount);
+    }
+
+    self->m_frameCount = 0;
+    self->m_fullFrameCount = 0;
+    self->m_totalRectCount = 0;
+    self->m_totalPixelCount = 0;
+}
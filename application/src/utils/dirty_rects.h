@@ -0,0 +1,111 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+
+/// @brief Taille d'une tuile de la grille des zones modifiées (en pixels).
+#define DIRTY_RECTS_TILE_SIZE 32
+
+/// @brief Proportion de tuiles modifiées au-delà de laquelle l'image
+/// est entièrement redessinée.
+#define DIRTY_RECTS_FULL_RATIO 0.6f
+
+/// @brief Structure représentant l'ensemble des zones de l'écran à
+/// redessiner d'une image à l'autre.
+/// Chaque élément mobile déclare son rectangle à chaque image ; une zone
+/// est à redessiner si elle est couverte dans l'image courante ou dans
+/// l'image précédente. Les rectangles sont accumulés sur une grille de
+/// tuiles, ce qui fusionne les chevauchements, puis les tuiles sont
+/// regroupées en rectangles disjoints.
+typedef struct DirtyRects
+{
+    /// @brief Dimensions de l'écran (en pixels).
+    int m_width, m_height;
+
+    /// @brief Dimensions de la grille (en tuiles).
+    int m_columnCount, m_rowCount;
+
+    /// @brief Tuiles couvertes dans l'image courante et dans la précédente.
+    Uint8 *m_tiles;
+    Uint8 *m_prevTiles;
+
+    /// @brief Rectangles à redessiner dans l'image courante.
+    SDL_Rect *m_rects;
+    int m_rectCount;
+
+    /// @brief Booléen indiquant si toute l'image doit être redessinée.
+    bool m_fullRedraw;
+
+    /// @brief Booléen indiquant si la prochaine image doit être
+    /// entièrement redessinée (contenu de l'écran perdu).
+    bool m_invalid;
+
+    /// @brief Statistiques.
+    Uint64 m_frameCount;
+    Uint64 m_fullFrameCount;
+    Uint64 m_totalRectCount;
+    Uint64 m_totalPixelCount;
+} DirtyRects;
+
+/// @brief Crée l'ensemble des zones modifiées d'un écran.
+/// La première image est entièrement redessinée.
+/// @param width la largeur de l'écran (en pixels).
+/// @param height la hauteur de l'écran (en pixels).
+/// @return L'ensemble créé.
+DirtyRects *DirtyRects_create(int width, int height);
+
+/// @brief Détruit un ensemble de zones modifiées.
+/// @param self l'ensemble.
+void DirtyRects_destroy(DirtyRects *self);
+
+/// @brief Demande que la prochaine image soit entièrement redessinée,
+/// par exemple lorsque le contenu de l'écran a été perdu.
+/// @param self l'ensemble.
+void DirtyRects_invalidate(DirtyRects *self);
+
+/// @brief Déclare le rectangle occupé par un élément dans l'image courante.
+/// @param self l'ensemble.
+/// @param rect le rectangle (en pixels).
+void DirtyRects_addRect(DirtyRects *self, const SDL_FRect *rect);
+
+/// @brief Calcule les rectangles à redessiner dans l'image courante
+/// puis prépare l'image suivante.
+/// @param self l'ensemble.
+void DirtyRects_update(DirtyRects *self);
+
+/// @brief Affiche les statistiques des zones redessinées puis les remet à zéro.
+/// @param self l'ensemble.
+void DirtyRects_printStats(DirtyRects *self);
+
+/// @brief Indique si toute l'image courante doit être redessinée.
+/// @param self l'ensemble.
+/// @return true si l'image doit être entièrement redessinée.
+INLINE bool DirtyRects_isFullRedraw(DirtyRects *self)
+{
+    assert(self && "The DirtyRects must be created");
+    return self->m_fullRedraw;
+}
+
+/// @brief Renvoie le nombre de rectangles à redessiner dans l'image courante.
+/// @param self l'ensemble.
+/// @return Le nombre de rectangles.
+INLINE int DirtyRects_getRectCount(DirtyRects *self)
+{
+    assert(self && "The DirtyRects must be created");
+    return self->m_rectCount;
+}
+
+/// @brief Renvoie les rectangles à redessiner dans l'image courante.
+/// Ils sont disjoints et contenus dans l'écran.
+/// @param self l'ensemble.
+/// @return Le tableau des rectangles.
+INLINE const SDL_Rect *DirtyRects_getRects(DirtyRects *self)
+{
+    assert(self && "The DirtyRects must be created");
+    return self->m_rects;
+}
@@ -0,0 +1,182 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "utils/dynamic_resolution.h"
+
+static void DynamicResolution_updateScale(DynamicResolution *self, double renderMS);
+static SDL_Rect DynamicResolution_getSourceRect(DynamicResolution *self);
+
+DynamicResolution *DynamicResolution_create(
+    SDL_Renderer *renderer, int width, int height,
+    float minScale, float maxScale, float budgetMS)
+{
+    assert(renderer && "The SDL_Renderer must be created");
+    assert(width > 0 && height > 0);
+    assert(0.f < minScale && minScale <= maxScale);
+
+    if (SDL_RenderTargetSupported(renderer) == SDL_FALSE)
+    {
+        printf("WARNING - Dynamic resolution needs render targets\n");
+        return NULL;
+    }
+
+    // La taille de la cible est limitée par celle des textures
+    SDL_RendererInfo info = { 0 };
+    SDL_GetRendererInfo(renderer, &info);
+    if (info.max_texture_width > 0)
+        maxScale = SDL_min(maxScale, (float)info.max_texture_width / (float)width);
+    if (info.max_texture_height > 0)
+        maxScale = SDL_min(maxScale, (float)info.max_texture_height / (float)height);
+    minScale = SDL_min(minScale, maxScale);
+
+    int targetW = (int)ceilf(maxScale * (float)width);
+    int targetH = (int)ceilf(maxScale * (float)height);
+    SDL_Texture *target = SDL_CreateTexture(
+        renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, targetW, targetH);
+    if (target == NULL)
+    {
+        printf("WARNING - Create dynamic resolution target %s\n", SDL_GetError());
+        return NULL;
+    }
+    SDL_SetTextureBlendMode(target, SDL_BLENDMODE_NONE);
+
+    DynamicResolution *self = (DynamicResolution *)calloc(1, sizeof(DynamicResolution));
+    AssertNew(self);
+
+    self->m_renderer = renderer;
+    self->m_target = target;
+    self->m_width = width;
+    self->m_height = height;
+    self->m_minScale = minScale;
+    self->m_maxScale = maxScale;
+    self->m_scale = maxScale;
+    self->m_budgetMS = budgetMS;
+    self->m_scaleMin = maxScale;
+
+    printf("INFO - Dynamic resolution from %.2f to %.2f (%dx%d), budget %.1f ms\n",
+        minScale, maxScale, targetW, targetH, budgetMS);
+
+    return self;
+}
+
+void DynamicResolution_destroy(DynamicResolution *self)
+{
+    if (!self) return;
+    if (self->m_target) SDL_DestroyTexture(self->m_target);
+    free(self);
+}
+
+bool DynamicResolution_begin(DynamicResolution *self)
+{
+    assert(self && "The DynamicResolution must be created");
+
+    self->m_prevTarget = SDL_GetRenderTarget(self->m_renderer);
+    if (SDL_SetRenderTarget(self->m_renderer, self->m_target) < 0)
+    {
+        printf("WARNING - Dynamic resolution target %s\n", SDL_GetError());
+        return false;
+    }
+
+    // Les coordonnées logiques sont réduites au facteur courant.
+    // La vue est limitée à la partie utilisée de la cible : les copies sans
+    // rectangle de destination couvrent alors le rendu logique.
+    SDL_Rect viewport = { 0, 0, self->m_width, self->m_height };
+    SDL_RenderSetScale(self->m_renderer, self->m_scale, self->m_scale);
+    SDL_RenderSetViewport(self->m_renderer, &viewport);
+    self->m_start = SDL_GetPerformanceCounter();
+    return true;
+}
+
+void DynamicResolution_end(DynamicResolution *self)
+{
+    assert(self && "The DynamicResolution must be created");
+
+    // Le temps de rendu comprend l'exécution des commandes en attente
+    SDL_RenderFlush(self->m_renderer);
+    Uint64 end = SDL_GetPerformanceCounter();
+    double renderMS = 1000.0 * (double)(end - self->m_start) / (double)SDL_GetPerformanceFrequency();
+
+    // L'image est copiée avec le facteur qui a servi à la dessiner
+    SDL_Rect srcRect = DynamicResolution_getSourceRect(self);
+    SDL_SetRenderTarget(self->m_renderer, self->m_prevTarget);
+    SDL_RenderCopy(self->m_renderer, self->m_target, &srcRect, NULL);
+
+    DynamicResolution_updateScale(self, renderMS);
+}
+
+void DynamicResolution_printStats(DynamicResolution *self)
+{
+    assert(self && "The DynamicResolution must be created");
+
+    if (self->m_frameCount > 0)
+    {
+        printf("INFO - Dynamic resolution over %llu frames\n",
+            (unsigned long long)self->m_frameCount);
+        printf("     - mean scale %.2f, min scale %.2f, current %.2f (%d changes)\n",
+            self->m_scaleSum / (double)self->m_frameCount,
+            self->m_scaleMin, self->m_scale, self->m_changeCount);
+        printf("     - average render time %.2f ms (budget %.1f ms)\n",
+            self->m_averageMS, self->m_budgetMS);
+    }
+
+    self->m_frameCount = 0;
+    self->m_scaleSum = 0.0;
+    self->m_scaleMin = self->m_scale;
+    self->m_changeCount = 0;
+}
+
+static void DynamicResolution_updateScale(DynamicResolution *self, double renderMS)
+{
+    if (self->m_averageMS <= 0.0)
+    {
+        self->m_averageMS = renderMS;
+    }
+    else
+    {
+        self->m_averageMS = 0.9 * self->m_averageMS + 0.1 * renderMS;
+    }
+
+    self->m_frameCount++;
+    self->m_scaleSum += self->m_scale;
+
+    if (self->m_cooldown > 0)
+    {
+        self->m_cooldown--;
+        return;
+    }
+
+    float scale = self->m_scale;
+    if (self->m_averageMS > self->m_budgetMS)
+    {
+        // Le coût du rendu est proportionnel au nombre de pixels :
+        // la baisse nécessaire est estimée en une seule fois
+        float ratio = sqrtf(self->m_budgetMS / (float)self->m_averageMS);
+        float target = floorf(scale * ratio / DYNAMIC_RES_STEP) * DYNAMIC_RES_STEP;
+        scale = SDL_min(target, scale - DYNAMIC_RES_STEP);
+    }
+    else if (self->m_averageMS < DYNAMIC_RES_RAISE_RATIO * self->m_budgetMS)
+    {
+        // Hausse prudente, un pas à la fois
+        scale += DYNAMIC_RES_STEP;
+    }
+    scale = SDL_clamp(scale, self->m_minScale, self->m_maxScale);
+
+    if (fabsf(scale - self->m_scale) > 1e-4f)
+    {
+        self->m_scale = scale;
+        self->m_scaleMin = SDL_min(self->m_scaleMin, scale);
+        self->m_cooldown = DYNAMIC_RES_COOLDOWN;
+        self->m_changeCount++;
+    }
+}
+
+static SDL_Rect DynamicResolution_getSourceRect(DynamicResolution *self)
+{
+    SDL_Rect rect = { 0 };
+    rect.w = (int)lroundf(self->m_scale * (float)self->m_width);
+    rect.h = (int)lroundf(self->m_scale * (float)self->m_height);
+    return rect;
+}
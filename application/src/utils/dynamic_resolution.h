@@ -0,0 +1,103 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+
+/// @brief Pas de variation du facteur de résolution.
+#define DYNAMIC_RES_STEP 0.05f
+
+/// @brief Nombre d'images entre deux changements de résolution, le temps
+/// que la moyenne du temps de rendu se stabilise.
+#define DYNAMIC_RES_COOLDOWN 30
+
+/// @brief Fraction du budget sous laquelle la résolution est augmentée.
+/// L'écart avec le budget évite les oscillations.
+#define DYNAMIC_RES_RAISE_RATIO 0.7f
+
+/// @brief Structure représentant une résolution de rendu dynamique.
+/// La scène est dessinée dans une cible de rendu dont la résolution suit le
+/// temps de rendu, puis agrandie vers le rendu. Les éléments dessinés après
+/// DynamicResolution_end() (interface) restent à la résolution native.
+typedef struct DynamicResolution
+{
+    SDL_Renderer *m_renderer;
+
+    /// @brief Cible de rendu, allouée pour le facteur maximal.
+    /// Seule la partie correspondant au facteur courant est utilisée.
+    SDL_Texture *m_target;
+
+    /// @brief Cible de rendu active avant DynamicResolution_begin().
+    SDL_Texture *m_prevTarget;
+
+    /// @brief Dimensions logiques du rendu (en pixels).
+    int m_width, m_height;
+
+    /// @brief Facteurs de résolution minimal, maximal et courant.
+    float m_minScale, m_maxScale, m_scale;
+
+    /// @brief Temps de rendu visé (en millisecondes).
+    float m_budgetMS;
+
+    /// @brief Moyenne glissante du temps de rendu (en millisecondes).
+    double m_averageMS;
+
+    /// @brief Début du rendu de l'image courante.
+    Uint64 m_start;
+
+    /// @brief Nombre d'images avant le prochain changement autorisé.
+    int m_cooldown;
+
+    /// @brief Statistiques depuis le dernier affichage.
+    Uint64 m_frameCount;
+    double m_scaleSum;
+    float m_scaleMin;
+    int m_changeCount;
+} DynamicResolution;
+
+/// @brief Crée une résolution de rendu dynamique.
+/// @param renderer le moteur de rendu.
+/// @param width la largeur logique du rendu.
+/// @param height la hauteur logique du rendu.
+/// @param minScale le facteur de résolution minimal (> 0).
+/// @param maxScale le facteur de résolution maximal (>= minScale).
+/// @param budgetMS le temps de rendu visé (en millisecondes).
+/// @return La résolution dynamique créée, ou NULL si les cibles de rendu
+/// ne sont pas disponibles.
+DynamicResolution *DynamicResolution_create(
+    SDL_Renderer *renderer, int width, int height,
+    float minScale, float maxScale, float budgetMS);
+
+/// @brief Détruit une résolution de rendu dynamique.
+/// @param self la résolution dynamique.
+void DynamicResolution_destroy(DynamicResolution *self);
+
+/// @brief Commence le rendu de la scène dans la cible de rendu.
+/// Les coordonnées restent celles du rendu logique.
+/// La cible de rendu ne doit pas changer avant DynamicResolution_end().
+/// @param self la résolution dynamique.
+/// @return true si la cible de rendu est active.
+bool DynamicResolution_begin(DynamicResolution *self);
+
+/// @brief Termine le rendu de la scène, mesure sa durée, adapte le facteur
+/// de résolution puis copie l'image agrandie dans la cible précédente.
+/// @param self la résolution dynamique.
+void DynamicResolution_end(DynamicResolution *self);
+
+/// @brief Affiche le facteur de résolution moyen puis remet les
+/// statistiques à zéro.
+/// @param self la résolution dynamique.
+void DynamicResolution_printStats(DynamicResolution *self);
+
+/// @brief Renvoie le facteur de résolution courant.
+/// @param self la résolution dynamique.
+/// @return Le facteur de résolution.
+INLINE float DynamicResolution_getScale(DynamicResolution *self)
+{
+    assert(self && "The DynamicResolution must be created");
+    return self->m_scale;
+}
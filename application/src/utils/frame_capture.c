@@ -0,0 +1,155 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "utils/frame_capture.h"
+#include "utils/common.h"
+
+static double FrameCapture_ticksToUS(Uint64 ticks);
+
+FrameCapture *FrameCapture_create(SDL_Renderer *renderer, int width, int height)
+{
+    assert(renderer && "The SDL_Renderer must be created");
+    assert(width > 0 && height > 0);
+
+    if (SDL_RenderTargetSupported(renderer) == SDL_FALSE)
+    {
+        printf("ERROR - Frame capture needs render targets\n");
+        return NULL;
+    }
+
+    FrameCapture *self = (FrameCapture *)calloc(1, sizeof(FrameCapture));
+    AssertNew(self);
+
+    self->m_renderer = renderer;
+    self->m_target = SDL_CreateTexture(
+        renderer, SDL_PIXELFORMAT_ABGR8888, SDL_TEXTUREACCESS_TARGET, width, height
+    );
+    self->m_surface = SDL_CreateRGBSurfaceWithFormat(
+        0, width, height, 32, SDL_PIXELFORMAT_ABGR8888
+    );
+    if (self->m_target == NULL || self->m_surface == NULL)
+    {
+        printf("ERROR - Create frame capture %s\n", SDL_GetError());
+        FrameCapture_destroy(self);
+        return NULL;
+    }
+
+    return self;
+}
+
+void FrameCapture_destroy(FrameCapture *self)
+{
+    if (!self) return;
+    if (self->m_target) SDL_DestroyTexture(self->m_target);
+    if (self->m_surface) SDL_FreeSurface(self->m_surface);
+    free(self);
+}
+
+bool FrameCapture_begin(FrameCapture *self)
+{
+    assert(self && "The FrameCapture must be created");
+
+    self->m_prevTarget = SDL_GetRenderTarget(self->m_renderer);
+    if (SDL_SetRenderTarget(self->m_renderer, self->m_target) < 0)
+    {
+        printf("ERROR - Frame capture target %s\n", SDL_GetError());
+        return false;
+    }
+    self->m_start = SDL_GetPerformanceCounter();
+    return true;
+}
+
+void FrameCapture_end(FrameCapture *self, bool readBack)
+{
+    assert(self && "The FrameCapture must be created");
+
+    // Les commandes sont mises en lot par SDL : on les exécute avant
+    // d'arrêter la mesure
+    SDL_RenderFlush(self->m_renderer);
+    Uint64 rendered = SDL_GetPerformanceCounter();
+    self->m_renderUS = FrameCapture_ticksToUS(rendered - self->m_start);
+    self->m_readUS = 0.0;
+
+    if (readBack)
+    {
+        SDL_Surface *surface = self->m_surface;
+        if (SDL_RenderReadPixels(
+            self->m_renderer, NULL, surface->format->format,
+            surface->pixels, surface->pitch) < 0)
+        {
+            printf("ERROR - Read frame pixels %s\n", SDL_GetError());
+        }
+        self->m_readUS = FrameCapture_ticksToUS(SDL_GetPerformanceCounter() - rendered);
+    }
+
+    SDL_SetRenderTarget(self->m_renderer, self->m_prevTarget);
+    self->m_prevTarget = NULL;
+}
+
+bool FrameCapture_savePNG(FrameCapture *self, const char *path)
+{
+    assert(self && "The FrameCapture must be created");
+    assert(path);
+    if (IMG_SavePNG(self->m_surface, path) < 0)
+    {
+        printf("ERROR - Save %s %s\n", path, IMG_GetError());
+        return false;
+    }
+    return true;
+}
+
+FrameCompareResult FrameCapture_compare(FrameCapture *self, const char *path, int tolerance)
+{
+    assert(self && "The FrameCapture must be created");
+    assert(path);
+
+    FrameCompareResult result = { 0 };
+    SDL_Surface *golden = IMG_Load(path);
+    if (golden == NULL)
+        return result;
+
+    // Les deux images sont comparées dans le même format de pixels
+    SDL_Surface *converted = SDL_ConvertSurfaceFormat(golden, self->m_surface->format->format, 0);
+    SDL_FreeSurface(golden);
+    if (converted == NULL)
+        return result;
+
+    SDL_Surface *actual = self->m_surface;
+    if (converted->w != actual->w || converted->h != actual->h)
+    {
+        SDL_FreeSurface(converted);
+        return result;
+    }
+
+    result.loaded = true;
+    const int w = actual->w;
+    for (int y = 0; y < actual->h; y++)
+    {
+        const Uint8 *a = (const Uint8 *)actual->pixels + y * actual->pitch;
+        const Uint8 *b = (const Uint8 *)converted->pixels + y * converted->pitch;
+        for (int x = 0; x < w; x++, a += 4, b += 4)
+        {
+            int diff = 0;
+            for (int c = 0; c < 4; c++)
+            {
+                diff = SDL_max(diff, abs((int)a[c] - (int)b[c]));
+            }
+            result.maxDiff = SDL_max(result.maxDiff, diff);
+            if (diff > tolerance)
+            {
+                result.diffCount++;
+            }
+        }
+    }
+
+    SDL_FreeSurface(converted);
+    return result;
+}
+
+static double FrameCapture_ticksToUS(Uint64 ticks)
+{
+    return 1000000.0 * (double)ticks / (double)SDL_GetPerformanceFrequency();
+}
@@ -0,0 +1,105 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+
+/// @brief Structure représentant le résultat de la comparaison d'une image
+/// capturée avec une image de référence.
+typedef struct FrameCompareResult
+{
+    /// @brief Booléen indiquant si l'image de référence a pu être chargée
+    /// et possède les mêmes dimensions que la capture.
+    bool loaded;
+
+    /// @brief Nombre de pixels dont au moins une composante s'écarte de
+    /// plus de la tolérance.
+    int diffCount;
+
+    /// @brief Plus grand écart entre deux composantes.
+    int maxDiff;
+} FrameCompareResult;
+
+/// @brief Structure permettant de rendre des images dans une texture hors
+/// écran puis de les relire sur le processeur.
+/// Elle fonctionne aussi sans affichage (pilote vidéo "dummy").
+typedef struct FrameCapture
+{
+    SDL_Renderer *m_renderer;
+
+    /// @brief Cible de rendu hors écran.
+    SDL_Texture *m_target;
+
+    /// @brief Pixels relus (SDL_PIXELFORMAT_ABGR8888, octets RGBA).
+    SDL_Surface *m_surface;
+
+    /// @brief Cible de rendu à restaurer à la fin de la capture.
+    SDL_Texture *m_prevTarget;
+
+    /// @brief Début du rendu de l'image courante.
+    Uint64 m_start;
+
+    /// @brief Durées du rendu et de la relecture de la dernière image
+    /// (en microsecondes).
+    double m_renderUS;
+    double m_readUS;
+} FrameCapture;
+
+/// @brief Crée une capture d'images hors écran.
+/// @param renderer le moteur de rendu.
+/// @param width la largeur des images (en pixels).
+/// @param height la hauteur des images (en pixels).
+/// @return La capture créée, ou NULL si le moteur de rendu ne supporte pas
+/// les cibles de rendu.
+FrameCapture *FrameCapture_create(SDL_Renderer *renderer, int width, int height);
+
+/// @brief Détruit une capture d'images.
+/// @param self la capture.
+void FrameCapture_destroy(FrameCapture *self);
+
+/// @brief Redirige le rendu vers la texture hors écran et démarre la mesure
+/// du temps de rendu de l'image.
+/// @param self la capture.
+/// @return true si la cible de rendu a pu être activée.
+bool FrameCapture_begin(FrameCapture *self);
+
+/// @brief Termine le rendu de l'image et restaure la cible précédente.
+/// Les commandes de rendu sont exécutées avant la fin de la mesure.
+/// @param self la capture.
+/// @param readBack booléen indiquant si les pixels doivent être relus.
+void FrameCapture_end(FrameCapture *self, bool readBack);
+
+/// @brief Enregistre la dernière image relue au format PNG.
+/// @param self la capture.
+/// @param path le chemin du fichier.
+/// @return true en cas de succès.
+bool FrameCapture_savePNG(FrameCapture *self, const char *path);
+
+/// @brief Compare la dernière image relue avec une image de référence.
+/// @param self la capture.
+/// @param path le chemin de l'image de référence.
+/// @param tolerance l'écart maximal toléré par composante.
+/// @return Le résultat de la comparaison.
+FrameCompareResult FrameCapture_compare(FrameCapture *self, const char *path, int tolerance);
+
+/// @brief Renvoie la durée du rendu de la dernière image.
+/// @param self la capture.
+/// @return La durée (en microsecondes).
+INLINE double FrameCapture_getRenderTime(FrameCapture *self)
+{
+    assert(self && "The FrameCapture must be created");
+    return self->m_renderUS;
+}
+
+/// @brief Renvoie la durée de la relecture de la dernière image.
+/// @param self la capture.
+/// @return La durée (en microsecondes), 0 si l'image n'a pas été relue.
+INLINE double FrameCapture_getReadTime(FrameCapture *self)
+{
+    assert(self && "The FrameCapture must be created");
+    return self->m_readUS;
+}
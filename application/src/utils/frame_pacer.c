@@ -0,0 +1,197 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "utils/frame_pacer.h"
+
+/// @brief Marge d'attente active (en millisecondes).
+/// SDL_Delay() peut se réveiller avec environ une milliseconde de retard.
+#define FRAME_PACER_SPIN_MS 2
+
+/// @brief Marge de sécurité ajoutée à l'estimation du travail d'une image
+/// lorsque la lecture des entrées est retardée (en millisecondes).
+#define FRAME_PACER_INPUT_SAFETY_MS 1
+
+static void FramePacer_waitUntil(FramePacer *self, Uint64 target);
+static double FramePacer_ticksToUS(FramePacer *self, Uint64 ticks);
+
+FramePacer *FramePacer_create(float targetFPS)
+{
+    FramePacer *self = (FramePacer *)calloc(1, sizeof(FramePacer));
+    AssertNew(self);
+
+    self->m_frequency = SDL_GetPerformanceFrequency();
+    self->m_spinMargin = self->m_frequency * FRAME_PACER_SPIN_MS / 1000;
+    self->m_delayInput = false;
+    self->m_background = false;
+    self->m_backgroundPeriod = (Uint64)((double)self->m_frequency / FRAME_PACER_BACKGROUND_FPS);
+
+    FramePacer_setTargetFPS(self, targetFPS);
+    FramePacer_resync(self);
+
+    return self;
+}
+
+void FramePacer_destroy(FramePacer *self)
+{
+    if (!self) return;
+    free(self);
+}
+
+void FramePacer_setTargetFPS(FramePacer *self, float targetFPS)
+{
+    assert(self && "The FramePacer must be created");
+    if (targetFPS > 0.f)
+    {
+        self->m_targetPeriod = (Uint64)((double)self->m_frequency / targetFPS);
+    }
+    else
+    {
+        self->m_targetPeriod = 0;
+    }
+    self->m_period = self->m_background ? self->m_backgroundPeriod : self->m_targetPeriod;
+    FramePacer_resync(self);
+}
+
+void FramePacer_setBackground(FramePacer *self, bool background)
+{
+    assert(self && "The FramePacer must be created");
+    if (self->m_background == background)
+        return;
+
+    self->m_background = background;
+    self->m_period = background ? self->m_backgroundPeriod : self->m_targetPeriod;
+    FramePacer_resync(self);
+}
+
+void FramePacer_setInputDelay(FramePacer *self, bool delayInput)
+{
+    assert(self && "The FramePacer must be created");
+    self->m_delayInput = delayInput;
+}
+
+void FramePacer_resync(FramePacer *self)
+{
+    assert(self && "The FramePacer must be created");
+    Uint64 now = SDL_GetPerformanceCounter();
+    self->m_deadline = now + self->m_period;
+    self->m_workStart = now;
+}
+
+void FramePacer_waitForInput(FramePacer *self)
+{
+    assert(self && "The FramePacer must be created");
+
+    if (self->m_period > 0 && self->m_delayInput)
+    {
+        // On garde juste assez de temps pour mettre à jour et rendre la scène
+        Uint64 safety = self->m_frequency * FRAME_PACER_INPUT_SAFETY_MS / 1000;
+        Uint64 lead = (Uint64)self->m_workEstimate + safety;
+        if (lead < self->m_period && self->m_deadline > lead)
+        {
+            FramePacer_waitUntil(self, self->m_deadline - lead);
+        }
+    }
+
+    self->m_workStart = SDL_GetPerformanceCounter();
+}
+
+void FramePacer_waitForDeadline(FramePacer *self)
+{
+    assert(self && "The FramePacer must be created");
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    // Met à jour l'estimation de la durée du travail d'une image
+    double work = (double)(now - self->m_workStart);
+    if (self->m_workEstimate <= 0.0 || work > self->m_workEstimate)
+    {
+        // On réagit immédiatement à une image plus lente
+        self->m_workEstimate = work;
+    }
+    else
+    {
+        self->m_workEstimate = 0.95 * self->m_workEstimate + 0.05 * work;
+    }
+
+    if (self->m_period == 0)
+        return;
+
+    if (now > self->m_deadline)
+    {
+        // Le travail de l'image a dépassé l'échéance
+        self->m_missedCount++;
+    }
+    else
+    {
+        FramePacer_waitUntil(self, self->m_deadline);
+        now = SDL_GetPerformanceCounter();
+    }
+
+    Uint64 error = (now > self->m_deadline) ?
+        now - self->m_deadline : self->m_deadline - now;
+    double errorUS = FramePacer_ticksToUS(self, error);
+    self->m_errorSum += errorUS;
+    if (errorUS > self->m_errorMax) self->m_errorMax = errorUS;
+    self->m_frameCount++;
+
+    // Prochaine échéance.
+    // On ne cherche pas à rattraper plus d'une image de retard.
+    self->m_deadline += self->m_period;
+    if (now > self->m_deadline)
+    {
+        self->m_deadline = now + self->m_period;
+    }
+}
+
+void FramePacer_printStats(FramePacer *self)
+{
+    assert(self && "The FramePacer must be created");
+
+    if (self->m_frameCount > 0)
+    {
+        printf("INFO - Frame pacing over %llu frames\n",
+            (unsigned long long)self->m_frameCount);
+        printf("     - mean error %.1f us, max error %.1f us\n",
+            self->m_errorSum / (double)self->m_frameCount, self->m_errorMax);
+        printf("     - missed deadlines %llu (%.1f%%)\n",
+            (unsigned long long)self->m_missedCount,
+            100.0 * (double)self->m_missedCount / (double)self->m_frameCount);
+        printf("     - estimated frame work %.1f us\n",
+            FramePacer_ticksToUS(self, (Uint64)self->m_workEstimate));
+    }
+
+    self->m_frameCount = 0;
+    self->m_missedCount = 0;
+    self->m_errorSum = 0.0;
+    self->m_errorMax = 0.0;
+}
+
+static void FramePacer_waitUntil(FramePacer *self, Uint64 target)
+{
+    while (true)
+    {
+        Uint64 now = SDL_GetPerformanceCounter();
+        if (now >= target)
+            return;
+
+        Uint64 remaining = target - now;
+        if (remaining > self->m_spinMargin)
+        {
+            // Attente grossière, le processeur est libéré
+            Uint64 ms = (remaining - self->m_spinMargin) * 1000 / self->m_frequency;
+            SDL_Delay((Uint32)(ms > 0 ? ms : 1));
+        }
+        else
+        {
+            // Attente active jusqu'à l'échéance
+            SDL_CPUPauseInstruction();
+        }
+    }
+}
+
+static double FramePacer_ticksToUS(FramePacer *self, Uint64 ticks)
+{
+    return 1000000.0 * (double)ticks / (double)self->m_frequency;
+}
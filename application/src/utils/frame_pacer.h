@@ -0,0 +1,128 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+
+/// @brief Nombre d'images par seconde lorsque la fenêtre est en arrière-plan.
+#define FRAME_PACER_BACKGROUND_FPS 10.f
+
+/// @brief Structure représentant un régulateur de la cadence d'affichage.
+/// L'attente jusqu'à l'échéance d'une image se fait en deux temps :
+/// une attente grossière avec SDL_Delay() puis une attente active courte.
+typedef struct FramePacer
+{
+    /// @brief Durée cible d'une image.
+    /// Exprimée en ticks du compteur haute résolution.
+    /// Une valeur nulle désactive le régulateur.
+    Uint64 m_period;
+
+    /// @brief Durée cible d'une image au premier plan et en arrière-plan.
+    /// Exprimées en ticks du compteur haute résolution.
+    Uint64 m_targetPeriod;
+    Uint64 m_backgroundPeriod;
+
+    /// @brief Booléen indiquant si la fenêtre est en arrière-plan.
+    bool m_background;
+
+    /// @brief Fréquence du compteur haute résolution (ticks par seconde).
+    Uint64 m_frequency;
+
+    /// @brief Echéance de l'image courante.
+    /// Exprimée en ticks du compteur haute résolution.
+    Uint64 m_deadline;
+
+    /// @brief Marge conservée pour l'attente active.
+    /// En dessous de cette marge, SDL_Delay() n'est plus utilisée.
+    /// Exprimée en ticks du compteur haute résolution.
+    Uint64 m_spinMargin;
+
+    /// @brief Booléen indiquant si la lecture des entrées est retardée
+    /// jusqu'au plus près de l'échéance.
+    bool m_delayInput;
+
+    /// @brief Instant de début du travail de l'image (mise à jour et rendu).
+    /// Exprimé en ticks du compteur haute résolution.
+    Uint64 m_workStart;
+
+    /// @brief Moyenne glissante de la durée du travail d'une image.
+    /// Exprimée en ticks du compteur haute résolution.
+    double m_workEstimate;
+
+    /// @brief Nombre d'images régulées depuis la dernière réinitialisation
+    /// des statistiques.
+    Uint64 m_frameCount;
+
+    /// @brief Nombre d'images dont le travail a dépassé l'échéance.
+    Uint64 m_missedCount;
+
+    /// @brief Somme des erreurs absolues de cadencement (en microsecondes).
+    double m_errorSum;
+
+    /// @brief Erreur absolue maximale de cadencement (en microsecondes).
+    double m_errorMax;
+} FramePacer;
+
+/// @brief Crée un nouveau régulateur de cadence.
+/// @param targetFPS le nombre d'images par seconde visé,
+///     ou 0 pour désactiver la régulation.
+/// @return Le régulateur créé.
+FramePacer *FramePacer_create(float targetFPS);
+
+/// @brief Détruit un régulateur de cadence.
+/// @param self le régulateur.
+void FramePacer_destroy(FramePacer *self);
+
+/// @brief Définit le nombre d'images par seconde visé.
+/// @param self le régulateur.
+/// @param targetFPS le nombre d'images par seconde visé,
+///     ou 0 pour désactiver la régulation.
+void FramePacer_setTargetFPS(FramePacer *self, float targetFPS);
+
+/// @brief Active ou désactive le retard de la lecture des entrées.
+/// Lorsqu'il est actif, FramePacer_waitForInput() attend le plus tard possible
+/// avant l'échéance en fonction de la durée estimée du travail d'une image.
+/// Cela réduit la latence entre l'entrée et l'affichage.
+/// @param self le régulateur.
+/// @param delayInput booléen indiquant s'il faut retarder la lecture des entrées.
+void FramePacer_setInputDelay(FramePacer *self, bool delayInput);
+
+/// @brief Indique si la fenêtre du jeu est en arrière-plan.
+/// En arrière-plan, la cadence est réduite à FRAME_PACER_BACKGROUND_FPS.
+/// @param self le régulateur.
+/// @param background booléen indiquant si la fenêtre est en arrière-plan.
+void FramePacer_setBackground(FramePacer *self, bool background);
+
+/// @brief Attend le moment de lire les entrées.
+/// Cette fonction est appelée au début de chaque tour de la boucle de rendu,
+/// juste avant Timer_update() et la lecture des entrées.
+/// @param self le régulateur.
+void FramePacer_waitForInput(FramePacer *self);
+
+/// @brief Attend l'échéance de l'image courante.
+/// Cette fonction est appelée juste avant SDL_RenderPresent().
+/// @param self le régulateur.
+void FramePacer_waitForDeadline(FramePacer *self);
+
+/// @brief Réaligne l'échéance sur l'instant présent.
+/// A utiliser après une attente qui n'est pas gérée par le régulateur.
+/// @param self le régulateur.
+void FramePacer_resync(FramePacer *self);
+
+/// @brief Affiche les statistiques d'erreur de cadencement
+/// puis les réinitialise.
+/// @param self le régulateur.
+void FramePacer_printStats(FramePacer *self);
+
+/// @brief Indique si le régulateur impose une cadence au premier plan.
+/// @param self le régulateur.
+/// @return true si la régulation est active, false sinon.
+INLINE bool FramePacer_isEnabled(FramePacer *self)
+{
+    assert(self && "The FramePacer must be created");
+    return self->m_targetPeriod > 0;
+}
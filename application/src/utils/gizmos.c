@@ -6,6 +6,26 @@
 
 #include "utils/gizmos.h"
 
+/// @brief Police matricielle 3x5 des caractères ASCII 32 à 95.
+/// Chaque glyphe tient sur 15 bits, ligne par ligne depuis le haut,
+/// le bit de poids fort de chaque ligne est la colonne de gauche.
+static const Uint16 g_gizmosFont[64] = {
+    0x0000, 0x2482, 0x0000, 0x5F7D, 0x0000, 0x52A5, 0x0000, 0x0000, //  !"#$%&'
+    0x1491, 0x4494, 0x0AA8, 0x05D0, 0x0014, 0x01C0, 0x0002, 0x12A4, // ()*+,-./
+    0x7B6F, 0x2C97, 0x73E7, 0x73CF, 0x5BC9, 0x79CF, 0x79EF, 0x7252, // 01234567
+    0x7BEF, 0x7BCF, 0x0410, 0x0000, 0x1511, 0x0E38, 0x4454, 0x7282, // 89:;<=>?
+    0x0000, 0x2BED, 0x6BAE, 0x3923, 0x6B6E, 0x79A7, 0x79A4, 0x396B, // @ABCDEFG
+    0x5BED, 0x7497, 0x126A, 0x5BAD, 0x4927, 0x5FED, 0x6B6D, 0x2B6A, // HIJKLMNO
+    0x6BA4, 0x2B73, 0x6BAD, 0x388E, 0x7492, 0x5B6F, 0x5B6A, 0x5BFD, // PQRSTUVW
+    0x5AAD, 0x5A92, 0x72A7, 0x3493, 0x0000, 0x6496, 0x0000, 0x0007, // XYZ[\]^_
+};
+
+static GizmoCommand *Gizmos_newCommand(Gizmos *self, int type);
+static void Gizmos_addSegment(Gizmos *self, float x0, float y0, float x1, float y1, SDL_Color color);
+static void Gizmos_addQuad(Gizmos *self, const SDL_FPoint *points, SDL_Color color);
+static void Gizmos_tessellate(
+    Gizmos *self, const GizmoCommand *command, float x0, float y0, float x1, float y1);
+
 Gizmos *Gizmos_create(Camera *camera)
 {
     assert(camera);
@@ -19,12 +39,26 @@ Gizmos *Gizmos_create(Camera *camera)
     self->m_color.b = (Uint8)0;
     self->m_color.a = (Uint8)255;
 
+    // Cercle unité, calculé une seule fois
+    float inc = (float)(2.f * M_PI / GIZMOS_CIRCLE_SEGMENT_COUNT);
+    for (int i = 0; i < GIZMOS_CIRCLE_SEGMENT_COUNT; i++)
+    {
+        float theta = (float)i * inc;
+        self->m_unitCircle[i] = Vec2_set(cosf(theta), sinf(theta));
+    }
+    self->m_unitCircle[GIZMOS_CIRCLE_SEGMENT_COUNT] = self->m_unitCircle[0];
+
     return self;
 }
 
 void Gizmos_destroy(Gizmos *self)
 {
     if (!self) return;
+    free(self->m_commands);
+    free(self->m_vertices);
+    free(self->m_indices);
+    free(self->m_pointX);
+    free(self->m_pointY);
     free(self);
 }
 
@@ -42,44 +76,385 @@ void Gizmos_setColor(Gizmos *self, SDL_Color color)
     self->m_color = color;
 }
 
-#define CIRCLE_SEG_COUNT 16
+void Gizmos_beginRecord(Gizmos *self, GizmoCommand *buffer, int capacity)
+{
+    assert(self && "The Gizmos must be created");
+    assert(buffer && capacity >= 0);
+    self->m_record = buffer;
+    self->m_recordCapacity = capacity;
+    self->m_recordCount = 0;
+}
+
+int Gizmos_endRecord(Gizmos *self)
+{
+    assert(self && "The Gizmos must be created");
+    int count = self->m_recordCount;
+    self->m_record = NULL;
+    self->m_recordCapacity = 0;
+    self->m_recordCount = 0;
+    return count;
+}
+
 void Gizmos_drawCircle(Gizmos *self, Vec2 center, float radius)
 {
     assert(self && "The Gizmos must be created");
-    float inc = (float)(2.f * M_PI / CIRCLE_SEG_COUNT);
-    Vec2 vertices[CIRCLE_SEG_COUNT + 1] = { 0 };
+    GizmoCommand *command = Gizmos_newCommand(self, GIZMO_CIRCLE);
+    if (command == NULL) return;
+    command->a = center;
+    command->size = radius;
+}
+
+void Gizmos_drawLine(Gizmos *self, Vec2 from, Vec2 to)
+{
+    assert(self && "The Gizmos must be created");
+    GizmoCommand *command = Gizmos_newCommand(self, GIZMO_LINE);
+    if (command == NULL) return;
+    command->a = from;
+    command->b = to;
+}
+
+void Gizmos_drawRect(Gizmos *self, AABB box)
+{
+    assert(self && "The Gizmos must be created");
+    GizmoCommand *command = Gizmos_newCommand(self, GIZMO_RECT);
+    if (command == NULL) return;
+    command->a = box.lower;
+    command->b = box.upper;
+}
+
+void Gizmos_drawArrow(Gizmos *self, Vec2 from, Vec2 to)
+{
+    assert(self && "The Gizmos must be created");
+    GizmoCommand *command = Gizmos_newCommand(self, GIZMO_ARROW);
+    if (command == NULL) return;
+    command->a = from;
+    command->b = to;
+}
+
+void Gizmos_drawGrid(Gizmos *self, AABB box, float cellSize)
+{
+    assert(self && "The Gizmos must be created");
+    assert(cellSize > 0.f);
+    GizmoCommand *command = Gizmos_newCommand(self, GIZMO_GRID);
+    if (command == NULL) return;
+    command->a = box.lower;
+    command->b = box.upper;
+    command->size = cellSize;
+}
+
+void Gizmos_drawText(Gizmos *self, Vec2 position, const char *text)
+{
+    assert(self && "The Gizmos must be created");
+    assert(text);
+    GizmoCommand *command = Gizmos_newCommand(self, GIZMO_TEXT);
+    if (command == NULL) return;
+    command->a = position;
+    SDL_strlcpy(command->text, text, GIZMOS_TEXT_CAPACITY);
+}
+
+void Gizmos_flush(Gizmos *self)
+{
+    assert(self && "The Gizmos must be created");
+    Gizmos_render(self, self->m_commands, self->m_commandCount);
+    self->m_commandCount = 0;
+}
+
+void Gizmos_render(Gizmos *self, const GizmoCommand *commands, int count)
+{
+    assert(self && "The Gizmos must be created");
+    assert(commands || count == 0);
+    if (count <= 0) return;
+
+    if (2 * count > self->m_pointCapacity)
+    {
+        int capacity = SDL_max(2 * count, 2 * self->m_pointCapacity);
+        float *pointX = (float *)realloc(self->m_pointX, capacity * sizeof(float));
+        AssertNew(pointX);
+        float *pointY = (float *)realloc(self->m_pointY, capacity * sizeof(float));
+        AssertNew(pointY);
+        self->m_pointX = pointX;
+        self->m_pointY = pointY;
+        self->m_pointCapacity = capacity;
+    }
+
+    // Les extrémités de toutes les commandes sont transformées en un lot
+    float *pointX = self->m_pointX;
+    float *pointY = self->m_pointY;
+    for (int i = 0; i < count; i++)
+    {
+        pointX[2 * i + 0] = commands[i].a.x;
+        pointY[2 * i + 0] = commands[i].a.y;
+        pointX[2 * i + 1] = commands[i].b.x;
+        pointY[2 * i + 1] = commands[i].b.y;
+    }
+    Camera_worldToViewBatch(self->m_camera, pointX, pointY, pointX, pointY, 2 * count);
+
+    self->m_quadCount = 0;
+    for (int i = 0; i < count; i++)
+    {
+        Gizmos_tessellate(self, commands + i,
+            pointX[2 * i], pointY[2 * i], pointX[2 * i + 1], pointY[2 * i + 1]);
+    }
+    if (self->m_quadCount <= 0) return;
+
+    RenderState_setDrawBlendMode(g_renderState, SDL_BLENDMODE_BLEND);
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    // Un seul appel pour tous les gizmos, la couleur est portée par les sommets
+    if (SDL_RenderGeometry(
+        g_renderer, NULL,
+        self->m_vertices, 4 * self->m_quadCount,
+        self->m_indices, 6 * self->m_quadCount) == 0)
+    {
+        return;
+    }
+#endif
+
+    // Repli : chaque quadrilatère est rempli séparément
+    for (int i = 0; i < self->m_quadCount; i++)
+    {
+        const SDL_Vertex *vertices = self->m_vertices + 4 * i;
+        SDL_Color color = vertices[0].color;
+        float xMin = vertices[0].position.x, xMax = xMin;
+        float yMin = vertices[0].position.y, yMax = yMin;
+        for (int j = 1; j < 4; j++)
+        {
+            xMin = fminf(xMin, vertices[j].position.x);
+            xMax = fmaxf(xMax, vertices[j].position.x);
+            yMin = fminf(yMin, vertices[j].position.y);
+            yMax = fmaxf(yMax, vertices[j].position.y);
+        }
+        RenderState_setDrawColor(g_renderState, color.r, color.g, color.b, color.a);
+        if ((xMax - xMin) <= 1.5f || (yMax - yMin) <= 1.5f)
+        {
+            SDL_FRect rect = { xMin, yMin, xMax - xMin, yMax - yMin };
+            SDL_RenderFillRectF(g_renderer, &rect);
+        }
+        else
+        {
+            // Segment oblique : les milieux des petits côtés
+            SDL_RenderDrawLineF(g_renderer,
+                0.5f * (vertices[0].position.x + vertices[1].position.x),
+                0.5f * (vertices[0].position.y + vertices[1].position.y),
+                0.5f * (vertices[2].position.x + vertices[3].position.x),
+                0.5f * (vertices[2].position.y + vertices[3].position.y));
+        }
+    }
+}
+
+void Gizmos_getBounds(Gizmos *self, const GizmoCommand *command, SDL_FRect *bounds)
+{
+    assert(self && "The Gizmos must be created");
+    assert(command && bounds);
 
-    float theta = 0.f;
-    for (int i = 0; i < CIRCLE_SEG_COUNT; i++, theta += inc)
+    Camera *camera = self->m_camera;
+    float scale = Camera_getWorldToViewScale(camera);
+    float x0, y0, x1, y1;
+    Camera_worldToView(camera, command->a, &x0, &y0);
+    Camera_worldToView(camera, command->b, &x1, &y1);
+
+    // Marge couvrant l'épaisseur des segments
+    float margin = 1.f;
+    switch (command->type)
+    {
+    case GIZMO_CIRCLE:
+    {
+        float radius = command->size * scale;
+        x1 = x0 + radius; y1 = y0 + radius;
+        x0 -= radius; y0 -= radius;
+        break;
+    }
+    case GIZMO_TEXT:
     {
-        vertices[i] = Vec2_add(
-            center,
-            Vec2_scale(Vec2_set(cosf(theta), sinf(theta)), radius)
-        );
+        const float pixel = (float)GIZMOS_TEXT_SCALE;
+        x1 = x0 + (float)(4 * (int)strlen(command->text)) * pixel;
+        y1 = y0 + 5.f * pixel;
+        break;
+    }
+    case GIZMO_ARROW:
+        margin = 8.f;
+        break;
+    default:
+        break;
     }
-    vertices[CIRCLE_SEG_COUNT] = vertices[0];
 
-    SDL_SetRenderDrawColor(
-        g_renderer,
-        self->m_color.r,
-        self->m_color.g,
-        self->m_color.b,
-        self->m_color.a);
+    bounds->x = fminf(x0, x1) - margin;
+    bounds->y = fminf(y0, y1) - margin;
+    bounds->w = fabsf(x1 - x0) + 2.f * margin;
+    bounds->h = fabsf(y1 - y0) + 2.f * margin;
+}
 
-    float x, y;
-    SDL_Point points[2] = { 0 };
+static GizmoCommand *Gizmos_newCommand(Gizmos *self, int type)
+{
+    GizmoCommand *command = NULL;
+    if (self->m_record)
+    {
+        if (self->m_recordCount >= self->m_recordCapacity)
+            return NULL;
+        command = self->m_record + self->m_recordCount++;
+    }
+    else
+    {
+        if (self->m_commandCount >= self->m_commandCapacity)
+        {
+            int capacity = self->m_commandCapacity > 0 ? 2 * self->m_commandCapacity : 256;
+            GizmoCommand *commands = (GizmoCommand *)realloc(
+                self->m_commands, capacity * sizeof(GizmoCommand));
+            AssertNew(commands);
+            self->m_commands = commands;
+            self->m_commandCapacity = capacity;
+        }
+        command = self->m_commands + self->m_commandCount++;
+    }
+
+    memset(command, 0, sizeof(GizmoCommand));
+    command->type = type;
+    command->color = self->m_color;
+    return command;
+}
 
-    Camera_worldToView(self->m_camera, vertices[0], &x, &y);
-    points[0].x = (int)x;
-    points[0].y = (int)y;
+static void Gizmos_tessellate(
+    Gizmos *self, const GizmoCommand *command, float x0, float y0, float x1, float y1)
+{
+    SDL_Color color = command->color;
+    float scale = Camera_getWorldToViewScale(self->m_camera);
 
-    for (int i = 1; i < CIRCLE_SEG_COUNT + 1; ++i)
+    switch (command->type)
+    {
+    case GIZMO_CIRCLE:
     {
-        Camera_worldToView(self->m_camera, vertices[i], &x, &y);
-        points[1].x = (int)x;
-        points[1].y = (int)y;
+        float radius = command->size * scale;
+        for (int i = 0; i < GIZMOS_CIRCLE_SEGMENT_COUNT; i++)
+        {
+            Vec2 p = self->m_unitCircle[i];
+            Vec2 q = self->m_unitCircle[i + 1];
+            Gizmos_addSegment(self,
+                x0 + radius * p.x, y0 - radius * p.y,
+                x0 + radius * q.x, y0 - radius * q.y, color);
+        }
+        break;
+    }
+    case GIZMO_LINE:
+        Gizmos_addSegment(self, x0, y0, x1, y1, color);
+        break;
 
-        SDL_RenderDrawLines(g_renderer, points, 2);
-        points[0] = points[1];
+    case GIZMO_ARROW:
+    {
+        Gizmos_addSegment(self, x0, y0, x1, y1, color);
+
+        float dx = x1 - x0, dy = y1 - y0;
+        float length = sqrtf(dx * dx + dy * dy);
+        if (length < 1.f) break;
+
+        // Pointe de 8 pixels, au plus un tiers de la flèche
+        float head = fminf(8.f, length / 3.f);
+        dx *= head / length;
+        dy *= head / length;
+        Gizmos_addSegment(self, x1, y1, x1 - dx - 0.5f * dy, y1 - dy + 0.5f * dx, color);
+        Gizmos_addSegment(self, x1, y1, x1 - dx + 0.5f * dy, y1 - dy - 0.5f * dx, color);
+        break;
+    }
+    case GIZMO_RECT:
+        Gizmos_addSegment(self, x0, y0, x1, y0, color);
+        Gizmos_addSegment(self, x1, y0, x1, y1, color);
+        Gizmos_addSegment(self, x1, y1, x0, y1, color);
+        Gizmos_addSegment(self, x0, y1, x0, y0, color);
+        break;
+
+    case GIZMO_GRID:
+    {
+        float cell = command->size * scale;
+        if (cell < 2.f) break;
+
+        float yMin = fminf(y0, y1), yMax = fmaxf(y0, y1);
+        for (float x = x0; x <= x1 + 0.5f; x += cell)
+        {
+            Gizmos_addSegment(self, x, yMin, x, yMax, color);
+        }
+        for (float y = yMax; y >= yMin - 0.5f; y -= cell)
+        {
+            Gizmos_addSegment(self, x0, y, x1, y, color);
+        }
+        break;
+    }
+    case GIZMO_TEXT:
+    {
+        const float pixel = (float)GIZMOS_TEXT_SCALE;
+        for (int i = 0; command->text[i] != '\0'; i++)
+        {
+            int c = (unsigned char)command->text[i];
+            if ('a' <= c && c <= 'z') c += 'A' - 'a';
+            Uint16 glyph = (32 <= c && c < 96) ? g_gizmosFont[c - 32] : g_gizmosFont['?' - 32];
+
+            for (int bit = 0; bit < 15; bit++)
+            {
+                if ((glyph & (1 << (14 - bit))) == 0) continue;
+
+                float x = x0 + (float)(4 * i + bit % 3) * pixel;
+                float y = y0 + (float)(bit / 3) * pixel;
+                SDL_FPoint points[4] = {
+                    { x, y }, { x + pixel, y },
+                    { x + pixel, y + pixel }, { x, y + pixel }
+                };
+                Gizmos_addQuad(self, points, color);
+            }
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+static void Gizmos_addSegment(Gizmos *self, float x0, float y0, float x1, float y1, SDL_Color color)
+{
+    float dx = x1 - x0, dy = y1 - y0;
+    float length = sqrtf(dx * dx + dy * dy);
+    if (length < 1e-3f) return;
+
+    // Quadrilatère d'un pixel d'épaisseur autour du segment
+    float nx = -0.5f * dy / length;
+    float ny = +0.5f * dx / length;
+    SDL_FPoint points[4] = {
+        { x0 + nx, y0 + ny }, { x0 - nx, y0 - ny },
+        { x1 - nx, y1 - ny }, { x1 + nx, y1 + ny }
+    };
+    Gizmos_addQuad(self, points, color);
+}
+
+static void Gizmos_addQuad(Gizmos *self, const SDL_FPoint *points, SDL_Color color)
+{
+    if (self->m_quadCount >= self->m_quadCapacity)
+    {
+        int capacity = self->m_quadCapacity > 0 ? 2 * self->m_quadCapacity : 1024;
+        SDL_Vertex *vertices = (SDL_Vertex *)realloc(
+            self->m_vertices, 4 * capacity * sizeof(SDL_Vertex));
+        AssertNew(vertices);
+        int *indices = (int *)realloc(self->m_indices, 6 * capacity * sizeof(int));
+        AssertNew(indices);
+
+        // Les indices ne dépendent que de la position du quadrilatère
+        for (int i = self->m_quadCapacity; i < capacity; i++)
+        {
+            int first = 4 * i;
+            indices[6 * i + 0] = first + 0;
+            indices[6 * i + 1] = first + 1;
+            indices[6 * i + 2] = first + 2;
+            indices[6 * i + 3] = first + 2;
+            indices[6 * i + 4] = first + 3;
+            indices[6 * i + 5] = first + 0;
+        }
+        self->m_vertices = vertices;
+        self->m_indices = indices;
+        self->m_quadCapacity = capacity;
+    }
+
+    SDL_Vertex *vertices = self->m_vertices + 4 * self->m_quadCount++;
+    for (int i = 0; i < 4; i++)
+    {
+        vertices[i].position = points[i];
+        vertices[i].color = color;
+        vertices[i].tex_coord.x = 0.f;
+        vertices[i].tex_coord.y = 0.f;
     }
 }
@@ -11,15 +11,145 @@
 #include "utils/camera.h"
 #include "utils/math.h"
 
+/// @brief Nombre de segments utilisés pour dessiner un cercle.
+#define GIZMOS_CIRCLE_SEGMENT_COUNT 16
+
+/// @brief Nombre maximal de caractères d'un texte de débogage.
+#define GIZMOS_TEXT_CAPACITY 24
+
+/// @brief Taille d'un pixel de la police des textes (en pixels).
+#define GIZMOS_TEXT_SCALE 2
+
+/// @brief Types des primitives dessinées par les gizmos.
+typedef enum GizmoType
+{
+    GIZMO_CIRCLE,
+    GIZMO_LINE,
+    GIZMO_RECT,
+    GIZMO_ARROW,
+    GIZMO_GRID,
+    GIZMO_TEXT,
+} GizmoType;
+
+/// @brief Structure représentant une primitive enregistrée par les gizmos.
+/// Les coordonnées sont exprimées dans le référentiel monde.
+typedef struct GizmoCommand
+{
+    /// @brief Type de la primitive (GizmoType).
+    int type;
+    SDL_Color color;
+
+    /// @brief Points de la primitive :
+    /// centre (cercle, texte), extrémités (ligne, flèche)
+    /// ou coins inférieur et supérieur (rectangle, grille).
+    Vec2 a;
+    Vec2 b;
+
+    /// @brief Rayon d'un cercle ou taille d'une cellule de grille.
+    float size;
+
+    /// @brief Texte à afficher.
+    char text[GIZMOS_TEXT_CAPACITY];
+} GizmoCommand;
+
+/// @brief Structure représentant les gizmos, des primitives de débogage.
+/// Les primitives sont enregistrées dans un tampon de commandes puis
+/// dessinées en un seul appel à SDL_RenderGeometry() par Gizmos_flush() :
+/// chaque segment et chaque pixel de texte devient un quadrilatère
+/// portant sa couleur dans ses sommets.
 typedef struct Gizmos
 {
     Camera *m_camera;
     SDL_Color m_color;
+
+    /// @brief Cercle unité pré-calculé (GIZMOS_CIRCLE_SEGMENT_COUNT + 1 points).
+    Vec2 m_unitCircle[GIZMOS_CIRCLE_SEGMENT_COUNT + 1];
+
+    /// @brief Commandes en attente de dessin.
+    GizmoCommand *m_commands;
+    int m_commandCount;
+    int m_commandCapacity;
+
+    /// @brief Tampon d'enregistrement externe,
+    /// ou NULL si les commandes sont conservées jusqu'à Gizmos_flush().
+    GizmoCommand *m_record;
+    int m_recordCapacity;
+    int m_recordCount;
+
+    /// @brief Sommets et indices des quadrilatères de l'image courante.
+    SDL_Vertex *m_vertices;
+    int *m_indices;
+    int m_quadCount;
+    int m_quadCapacity;
+
+    /// @brief Extrémités des commandes de l'image courante, transformées
+    /// dans la vue en un seul lot (deux points par commande).
+    float *m_pointX;
+    float *m_pointY;
+    int m_pointCapacity;
 } Gizmos;
 
 Gizmos *Gizmos_create(Camera *camera);
 void Gizmos_destroy(Gizmos *self);
 
+/// @brief Enregistre les prochains dessins dans un tampon externe.
+/// Les gizmos peuvent ainsi être produits hors du thread principal.
+/// @param self les gizmos.
+/// @param buffer le tampon d'enregistrement.
+/// @param capacity le nombre maximal de commandes du tampon.
+void Gizmos_beginRecord(Gizmos *self, GizmoCommand *buffer, int capacity);
+
+/// @brief Termine l'enregistrement commencé avec Gizmos_beginRecord().
+/// @param self les gizmos.
+/// @return Le nombre de commandes enregistrées.
+int Gizmos_endRecord(Gizmos *self);
+
 void Gizmos_setColor(Gizmos *self, SDL_Color color);
 void Gizmos_setColorRGB(Gizmos *self, Uint8 r, Uint8 g, Uint8 b);
 void Gizmos_drawCircle(Gizmos *self, Vec2 center, float radius);
+
+/// @brief Dessine un segment.
+/// @param self les gizmos.
+/// @param from la première extrémité.
+/// @param to la seconde extrémité.
+void Gizmos_drawLine(Gizmos *self, Vec2 from, Vec2 to);
+
+/// @brief Dessine le contour d'une boîte.
+/// @param self les gizmos.
+/// @param box la boîte.
+void Gizmos_drawRect(Gizmos *self, AABB box);
+
+/// @brief Dessine une flèche.
+/// @param self les gizmos.
+/// @param from l'origine de la flèche.
+/// @param to la pointe de la flèche.
+void Gizmos_drawArrow(Gizmos *self, Vec2 from, Vec2 to);
+
+/// @brief Dessine une grille régulière couvrant une boîte.
+/// @param self les gizmos.
+/// @param box la boîte couverte par la grille.
+/// @param cellSize la taille d'une cellule.
+void Gizmos_drawGrid(Gizmos *self, AABB box, float cellSize);
+
+/// @brief Dessine un court texte avec une police matricielle 3x5.
+/// Les lettres minuscules sont affichées en majuscules.
+/// @param self les gizmos.
+/// @param position la position du coin supérieur gauche du texte.
+/// @param text le texte (tronqué à GIZMOS_TEXT_CAPACITY - 1 caractères).
+void Gizmos_drawText(Gizmos *self, Vec2 position, const char *text);
+
+/// @brief Dessine les commandes en attente puis vide le tampon.
+/// @param self les gizmos.
+void Gizmos_flush(Gizmos *self);
+
+/// @brief Dessine une liste de commandes enregistrées.
+/// @param self les gizmos.
+/// @param commands les commandes.
+/// @param count le nombre de commandes.
+void Gizmos_render(Gizmos *self, const GizmoCommand *commands, int count);
+
+/// @brief Calcule le rectangle de la vue couvert par une commande.
+/// @param self les gizmos.
+/// @param command la commande.
+/// @param bounds le rectangle couvert (en pixels).
+void Gizmos_getBounds(Gizmos *self, const GizmoCommand *command, SDL_FRect *bounds);
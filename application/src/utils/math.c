@@ -140,4 +140,21 @@ float Float_smoothDamp(
         *currentVelocity = (res - targetCopy) / deltaTime;
     }
     return res;
-}
\ No newline at end of file
+}
+
+AABB AABB_fromRotatedRect(Vec2 center, Vec2 extent, float angle)
+{
+    float hx = 0.5f * extent.x;
+    float hy = 0.5f * extent.y;
+    if (angle != 0.0f)
+    {
+        float radians = angle * (M_PI / 180.0f);
+        float c = fabsf(cosf(radians));
+        float s = fabsf(sinf(radians));
+        float rx = c * hx + s * hy;
+        float ry = s * hx + c * hy;
+        hx = rx;
+        hy = ry;
+    }
+    return AABB_set(center.x - hx, center.y - hy, center.x + hx, center.y + hy);
+}
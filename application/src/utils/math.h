@@ -160,6 +160,23 @@ INLINE void AABB_translate(AABB *aabb, Vec2 transform)
     aabb->upper = Vec2_add(aabb->upper, transform);
 }
 
+/// @brief Indique si deux boîtes se chevauchent.
+/// @param a la première boîte.
+/// @param b la seconde boîte.
+/// @return true si les boîtes ont une intersection non vide, false sinon.
+INLINE bool AABB_overlap(AABB a, AABB b)
+{
+    return (a.lower.x < b.upper.x) && (b.lower.x < a.upper.x)
+        && (a.lower.y < b.upper.y) && (b.lower.y < a.upper.y);
+}
+
+/// @brief Renvoie la plus petite boîte contenant un rectangle tourné.
+/// @param center le centre du rectangle.
+/// @param extent les dimensions du rectangle avant la rotation.
+/// @param angle l'angle de rotation du rectangle, en degrés.
+/// @return La boîte englobant le rectangle.
+AABB AABB_fromRotatedRect(Vec2 center, Vec2 extent, float angle);
+
 /// @brief Limite un entier entre une valeur minimale et une valeur maximale.
 /// @param value la valeur à borner.
 /// @param a la valeur minimale.
@@ -0,0 +1,259 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "utils/parallax.h"
+#include "utils/common.h"
+
+static ParallaxLayer *Parallax_newLayer(Parallax *self);
+static void ParallaxLayer_compose(Parallax *self, ParallaxLayer *layer);
+static void ParallaxLayer_composeSprite(Parallax *self, ParallaxLayer *layer);
+static void ParallaxLayer_composeStars(Parallax *self, ParallaxLayer *layer);
+static void ParallaxLayer_renderTiles(Parallax *self, ParallaxLayer *layer, int offset);
+
+Parallax *Parallax_create(SDL_Renderer *renderer, int width, int height)
+{
+    assert(renderer && width > 0 && height > 0);
+
+    Parallax *self = (Parallax *)calloc(1, sizeof(Parallax));
+    AssertNew(self);
+
+    self->m_renderer = renderer;
+    self->m_width = width;
+    self->m_height = height;
+
+    return self;
+}
+
+void Parallax_destroy(Parallax *self)
+{
+    if (!self) return;
+    for (int i = 0; i < self->m_layerCount; i++)
+    {
+        if (self->m_layers[i].texture)
+            SDL_DestroyTexture(self->m_layers[i].texture);
+    }
+    free(self);
+}
+
+void Parallax_addSpriteLayer(
+    Parallax *self, SpriteSheet *spriteSheet, int index,
+    int tileW, int tileH, float speed)
+{
+    assert(self && "The Parallax must be created");
+    assert(spriteSheet && tileW > 0 && tileH > 0);
+
+    ParallaxLayer *layer = Parallax_newLayer(self);
+    if (layer == NULL) return;
+
+    layer->spriteSheet = spriteSheet;
+    layer->index = index;
+    layer->tileW = tileW;
+    layer->tileH = tileH;
+    layer->period = tileW;
+    layer->speed = speed;
+
+    if (SDL_RenderTargetSupported(self->m_renderer))
+    {
+        layer->texture = SDL_CreateTexture(
+            self->m_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+            self->m_width + layer->period, self->m_height
+        );
+        if (layer->texture == NULL)
+        {
+            printf("WARNING - Create parallax layer %s\n", SDL_GetError());
+        }
+        else
+        {
+            SDL_SetTextureBlendMode(layer->texture, SDL_BLENDMODE_BLEND);
+        }
+    }
+    layer->dirty = true;
+}
+
+void Parallax_addStarLayer(Parallax *self, int starCount, Uint32 seed, float speed)
+{
+    assert(self && "The Parallax must be created");
+    assert(starCount >= 0);
+
+    ParallaxLayer *layer = Parallax_newLayer(self);
+    if (layer == NULL) return;
+
+    layer->starCount = starCount;
+    layer->seed = seed;
+    layer->period = self->m_width;
+    layer->speed = speed;
+    layer->texture = SDL_CreateTexture(
+        self->m_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
+        self->m_width + layer->period, self->m_height
+    );
+    if (layer->texture == NULL)
+    {
+        printf("ERROR - Create star layer %s\n", SDL_GetError());
+        self->m_layerCount--;
+        return;
+    }
+    SDL_SetTextureBlendMode(layer->texture, SDL_BLENDMODE_BLEND);
+    layer->dirty = true;
+}
+
+void Parallax_invalidate(Parallax *self)
+{
+    assert(self && "The Parallax must be created");
+    for (int i = 0; i < self->m_layerCount; i++)
+    {
+        self->m_layers[i].dirty = true;
+    }
+}
+
+void Parallax_update(Parallax *self)
+{
+    assert(self && "The Parallax must be created");
+
+    for (int i = 0; i < self->m_layerCount; i++)
+    {
+        ParallaxLayer *layer = self->m_layers + i;
+        if (layer->dirty)
+        {
+            ParallaxLayer_compose(self, layer);
+        }
+    }
+}
+
+void Parallax_render(Parallax *self, float scroll)
+{
+    assert(self && "The Parallax must be created");
+
+    for (int i = 0; i < self->m_layerCount; i++)
+    {
+        ParallaxLayer *layer = self->m_layers + i;
+        if (layer->dirty)
+        {
+            ParallaxLayer_compose(self, layer);
+        }
+
+        // Décalage dans la période, toujours positif
+        int offset = (int)fmodf(scroll * layer->speed, (float)layer->period);
+        if (offset < 0) offset += layer->period;
+
+        if (layer->texture == NULL)
+        {
+            ParallaxLayer_renderTiles(self, layer, offset);
+            continue;
+        }
+
+        SDL_Rect srcRect = { offset, 0, self->m_width, self->m_height };
+        SDL_RenderCopy(self->m_renderer, layer->texture, &srcRect, NULL);
+    }
+}
+
+static ParallaxLayer *Parallax_newLayer(Parallax *self)
+{
+    if (self->m_layerCount >= PARALLAX_LAYER_CAPACITY)
+    {
+        assert(false && "PARALLAX_LAYER_CAPACITY exceeded");
+        return NULL;
+    }
+    ParallaxLayer *layer = self->m_layers + self->m_layerCount++;
+    memset(layer, 0, sizeof(ParallaxLayer));
+    return layer;
+}
+
+static void ParallaxLayer_compose(Parallax *self, ParallaxLayer *layer)
+{
+    if (layer->spriteSheet)
+    {
+        if (layer->texture) ParallaxLayer_composeSprite(self, layer);
+    }
+    else
+    {
+        ParallaxLayer_composeStars(self, layer);
+    }
+    layer->dirty = false;
+}
+
+static void ParallaxLayer_composeSprite(Parallax *self, ParallaxLayer *layer)
+{
+    SDL_Texture *target = SDL_GetRenderTarget(self->m_renderer);
+    if (SDL_SetRenderTarget(self->m_renderer, layer->texture) < 0)
+    {
+        printf("WARNING - Compose parallax layer %s\n", SDL_GetError());
+        SDL_DestroyTexture(layer->texture);
+        layer->texture = NULL;
+        return;
+    }
+
+    assert(self->m_renderer == g_renderer);
+    RenderState_setDrawColor(g_renderState, 0, 0, 0, 0);
+    SDL_RenderClear(self->m_renderer);
+    ParallaxLayer_renderTiles(self, layer, 0);
+
+    SDL_SetRenderTarget(self->m_renderer, target);
+}
+
+static void ParallaxLayer_renderTiles(Parallax *self, ParallaxLayer *layer, int offset)
+{
+    // La bande fait la largeur de la vue plus une période
+    int stripW = self->m_width + layer->period;
+    SDL_Rect dstRect = { -offset, 0, layer->tileW, layer->tileH };
+    if (layer->texture == NULL)
+    {
+        stripW = self->m_width;
+    }
+    while (dstRect.x < stripW)
+    {
+        SDL_RenderCopy(
+            self->m_renderer, layer->spriteSheet->texture,
+            layer->spriteSheet->rects + layer->index, &dstRect
+        );
+        dstRect.x += layer->tileW;
+    }
+}
+
+static void ParallaxLayer_composeStars(Parallax *self, ParallaxLayer *layer)
+{
+    void *pixels = NULL;
+    int pitch = 0;
+    if (SDL_LockTexture(layer->texture, NULL, &pixels, &pitch) < 0)
+    {
+        printf("WARNING - Lock star layer %s\n", SDL_GetError());
+        return;
+    }
+
+    int stripW = self->m_width + layer->period;
+    int height = self->m_height;
+    for (int y = 0; y < height; y++)
+    {
+        memset((Uint8 *)pixels + y * pitch, 0, stripW * sizeof(Uint32));
+    }
+
+    // Générateur congruentiel : le motif ne dépend que de la graine
+    Uint32 state = layer->seed ? layer->seed : 1;
+    for (int i = 0; i < layer->starCount; i++)
+    {
+        state = state * 1664525u + 1013904223u;
+        int x = (int)((state >> 8) % (Uint32)layer->period);
+        state = state * 1664525u + 1013904223u;
+        int y = (int)((state >> 8) % (Uint32)height);
+        state = state * 1664525u + 1013904223u;
+        Uint32 alpha = 64 + ((state >> 16) % 192);
+        int size = ((state >> 8) & 0x7) == 0 ? 2 : 1;
+
+        Uint32 color = (alpha << 24) | 0x00FFFFFF;
+        for (int dy = 0; dy < size && y + dy < height; dy++)
+        {
+            Uint32 *row = (Uint32 *)((Uint8 *)pixels + (y + dy) * pitch);
+            for (int dx = 0; dx < size; dx++)
+            {
+                // Le motif est recopié une période plus loin pour boucler
+                int px = (x + dx) % layer->period;
+                row[px] = color;
+                if (px + layer->period < stripW) row[px + layer->period] = color;
+            }
+        }
+    }
+
+    SDL_UnlockTexture(layer->texture);
+}
@@ -0,0 +1,104 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+#include "utils/asset_manager.h"
+
+#define PARALLAX_LAYER_CAPACITY 8
+
+/// @brief Structure représentant une couche d'un fond défilant.
+typedef struct ParallaxLayer
+{
+    /// @brief Bande pré-composée de la couche, de la hauteur de la vue.
+    /// Sa largeur vaut la largeur de la vue plus une période, une seule
+    /// copie suffit donc pour couvrir la vue quel que soit le décalage.
+    SDL_Texture *texture;
+
+    /// @brief Booléen indiquant si la bande doit être recomposée
+    /// (cible de rendu perdue).
+    bool dirty;
+
+    /// @brief Période horizontale du motif (en pixels).
+    int period;
+
+    /// @brief Facteur de défilement de la couche (1 pour suivre le premier plan).
+    float speed;
+
+    /// @brief Image répétée par la couche (NULL pour une couche d'étoiles).
+    SpriteSheet *spriteSheet;
+    int index;
+    int tileW, tileH;
+
+    /// @brief Paramètres d'une couche d'étoiles.
+    int starCount;
+    Uint32 seed;
+} ParallaxLayer;
+
+/// @brief Structure représentant un fond composé de plusieurs couches
+/// défilant horizontalement à des vitesses différentes.
+/// Chaque couche coûte une seule copie par image.
+typedef struct Parallax
+{
+    SDL_Renderer *m_renderer;
+
+    /// @brief Dimensions de la vue (en pixels).
+    int m_width, m_height;
+
+    ParallaxLayer m_layers[PARALLAX_LAYER_CAPACITY];
+    int m_layerCount;
+} Parallax;
+
+/// @brief Crée un fond défilant vide.
+/// @param renderer le moteur de rendu.
+/// @param width la largeur de la vue (en pixels).
+/// @param height la hauteur de la vue (en pixels).
+/// @return Le fond défilant créé.
+Parallax *Parallax_create(SDL_Renderer *renderer, int width, int height);
+
+/// @brief Détruit un fond défilant.
+/// @param self le fond défilant.
+void Parallax_destroy(Parallax *self);
+
+/// @brief Ajoute une couche répétant un sprite horizontalement.
+/// Le sprite est composé une seule fois dans une bande (cible de rendu).
+/// Si les cibles de rendu ne sont pas supportées, les tuiles sont
+/// copiées à chaque image.
+/// @param self le fond défilant.
+/// @param spriteSheet la sprite sheet.
+/// @param index l'indice du sprite.
+/// @param tileW la largeur d'une tuile dans la vue (en pixels).
+/// @param tileH la hauteur d'une tuile dans la vue (en pixels).
+/// @param speed le facteur de défilement de la couche.
+void Parallax_addSpriteLayer(
+    Parallax *self, SpriteSheet *spriteSheet, int index,
+    int tileW, int tileH, float speed);
+
+/// @brief Ajoute une couche d'étoiles générées procéduralement.
+/// Les pixels sont calculés par le processeur puis écrits dans une
+/// texture de streaming. La période de la couche est la largeur de la vue.
+/// @param self le fond défilant.
+/// @param starCount le nombre d'étoiles par période.
+/// @param seed la graine du générateur pseudo-aléatoire.
+/// @param speed le facteur de défilement de la couche.
+void Parallax_addStarLayer(Parallax *self, int starCount, Uint32 seed, float speed);
+
+/// @brief Indique que les bandes des couches doivent être recomposées,
+/// par exemple après un événement SDL_RENDER_TARGETS_RESET.
+/// @param self le fond défilant.
+void Parallax_invalidate(Parallax *self);
+
+/// @brief Recompose les bandes des couches invalidées.
+/// Parallax_render() le fait si besoin, mais la composition change de cible
+/// de rendu : cette fonction permet de la faire avant de choisir la cible.
+/// @param self le fond défilant.
+void Parallax_update(Parallax *self);
+
+/// @brief Dessine le fond défilant dans le moteur de rendu.
+/// @param self le fond défilant.
+/// @param scroll le défilement du premier plan (en pixels).
+void Parallax_render(Parallax *self, float scroll);
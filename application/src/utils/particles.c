@@ -0,0 +1,438 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "utils/particles.h"
+#include "utils/common.h"
+
+static void ParticlePool_init(ParticlePool *pool, int capacity);
+static void ParticlePool_free(ParticlePool *pool);
+static void ParticlePool_integrate(ParticlePool *pool, float delta);
+static void ParticlePool_removeDead(ParticlePool *pool);
+static void ParticlePool_render(
+    ParticlePool *pool, ParticleSystem *system, Camera *camera);
+static SDL_Texture *ParticleSystem_createTexture(
+    SDL_Renderer *renderer, int size, float hardness, SDL_BlendMode blendMode);
+static Uint8 ParticlePool_lerpChannel(Uint32 c0, Uint32 c1, int shift, int w);
+static float ParticleSystem_random(ParticleSystem *self);
+
+ParticleSystem *ParticleSystem_create(SDL_Renderer *renderer, int capacity)
+{
+    assert(renderer && "The SDL_Renderer must be created");
+    assert(capacity > 0);
+
+    ParticleSystem *self = (ParticleSystem *)calloc(1, sizeof(ParticleSystem));
+    AssertNew(self);
+
+    // Capacité multiple de 4 pour l'intégration vectorielle
+    capacity = (capacity + 3) & ~3;
+
+    self->m_renderer = renderer;
+    self->m_seed = 0x9E3779B9u;
+    for (int i = 0; i < PARTICLE_TEXTURE_COUNT; i++)
+    {
+        ParticlePool_init(self->m_pools + i, capacity);
+    }
+    self->m_pools[PARTICLE_TEXTURE_SPARK].texture =
+        ParticleSystem_createTexture(renderer, 8, 2.f, SDL_BLENDMODE_ADD);
+    self->m_pools[PARTICLE_TEXTURE_SMOKE].texture =
+        ParticleSystem_createTexture(renderer, 32, 1.f, SDL_BLENDMODE_BLEND);
+
+    // Les indices des quadrilatères ne changent jamais
+    self->m_vertices = (SDL_Vertex *)calloc(4 * (size_t)capacity, sizeof(SDL_Vertex));
+    self->m_indices = (int *)calloc(6 * (size_t)capacity, sizeof(int));
+    AssertNew(self->m_vertices);
+    AssertNew(self->m_indices);
+    self->m_viewX = (float *)SDL_SIMDAlloc((size_t)capacity * sizeof(float));
+    self->m_viewY = (float *)SDL_SIMDAlloc((size_t)capacity * sizeof(float));
+    AssertNew(self->m_viewX);
+    AssertNew(self->m_viewY);
+    for (int i = 0; i < capacity; i++)
+    {
+        int *indices = self->m_indices + 6 * i;
+        indices[0] = 4 * i + 0;
+        indices[1] = 4 * i + 1;
+        indices[2] = 4 * i + 2;
+        indices[3] = 4 * i + 0;
+        indices[4] = 4 * i + 2;
+        indices[5] = 4 * i + 3;
+    }
+    for (int i = 0; i < capacity; i++)
+    {
+        SDL_Vertex *vertices = self->m_vertices + 4 * i;
+        vertices[1].tex_coord.x = 1.f;
+        vertices[2].tex_coord.x = 1.f;
+        vertices[2].tex_coord.y = 1.f;
+        vertices[3].tex_coord.y = 1.f;
+    }
+
+    return self;
+}
+
+void ParticleSystem_destroy(ParticleSystem *self)
+{
+    if (!self) return;
+    for (int i = 0; i < PARTICLE_TEXTURE_COUNT; i++)
+    {
+        ParticlePool_free(self->m_pools + i);
+    }
+    free(self->m_vertices);
+    free(self->m_indices);
+    SDL_SIMDFree(self->m_viewX);
+    SDL_SIMDFree(self->m_viewY);
+    free(self);
+}
+
+void ParticleSystem_clear(ParticleSystem *self)
+{
+    assert(self && "The ParticleSystem must be created");
+    for (int i = 0; i < PARTICLE_TEXTURE_COUNT; i++)
+    {
+        self->m_pools[i].count = 0;
+    }
+    self->m_bounds = AABB_set(0.f, 0.f, 0.f, 0.f);
+}
+
+void ParticleSystem_emit(
+    ParticleSystem *self, const ParticleParams *params,
+    Vec2 position, Vec2 velocity, int count)
+{
+    assert(self && "The ParticleSystem must be created");
+    assert(params);
+    assert(0 <= params->texture && params->texture < PARTICLE_TEXTURE_COUNT);
+
+    ParticlePool *pool = self->m_pools + params->texture;
+    count = SDL_min(count, pool->capacity - pool->count);
+
+    const Uint32 colorStart =
+        ((Uint32)params->colorStart.r << 24) | ((Uint32)params->colorStart.g << 16) |
+        ((Uint32)params->colorStart.b << 8) | (Uint32)params->colorStart.a;
+    const Uint32 colorEnd =
+        ((Uint32)params->colorEnd.r << 24) | ((Uint32)params->colorEnd.g << 16) |
+        ((Uint32)params->colorEnd.b << 8) | (Uint32)params->colorEnd.a;
+
+    for (int k = 0; k < count; k++)
+    {
+        int i = pool->count++;
+
+        float angle = params->angle + params->spread * (2.f * ParticleSystem_random(self) - 1.f);
+        float speed = params->speedMin +
+            (params->speedMax - params->speedMin) * ParticleSystem_random(self);
+        float life = params->lifeMin +
+            (params->lifeMax - params->lifeMin) * ParticleSystem_random(self);
+        angle *= (float)(M_PI / 180.0);
+
+        pool->x[i] = position.x;
+        pool->y[i] = position.y;
+        pool->vx[i] = velocity.x + speed * cosf(angle);
+        pool->vy[i] = velocity.y + speed * sinf(angle);
+        pool->drag[i] = params->drag;
+        pool->age[i] = 0.f;
+        pool->ageRate[i] = 1.f / fmaxf(life, 0.01f);
+        pool->sizeStart[i] = params->sizeStart;
+        pool->sizeDelta[i] = params->sizeEnd - params->sizeStart;
+        pool->colorStart[i] = colorStart;
+        pool->colorEnd[i] = colorEnd;
+    }
+}
+
+void ParticleSystem_emitRate(
+    ParticleSystem *self, const ParticleParams *params,
+    Vec2 position, Vec2 velocity, float rate, float delta)
+{
+    assert(self && "The ParticleSystem must be created");
+    float expected = rate * delta;
+    int count = (int)expected;
+    if (ParticleSystem_random(self) < expected - (float)count)
+    {
+        count++;
+    }
+    if (count > 0)
+    {
+        ParticleSystem_emit(self, params, position, velocity, count);
+    }
+}
+
+void ParticleSystem_update(ParticleSystem *self, float delta)
+{
+    assert(self && "The ParticleSystem must be created");
+
+    float xMin = INFINITY, yMin = INFINITY;
+    float xMax = -INFINITY, yMax = -INFINITY;
+    float sizeMax = 0.f;
+
+    for (int p = 0; p < PARTICLE_TEXTURE_COUNT; p++)
+    {
+        ParticlePool *pool = self->m_pools + p;
+        if (pool->count == 0) continue;
+
+        ParticlePool_integrate(pool, delta);
+        ParticlePool_removeDead(pool);
+
+        for (int i = 0; i < pool->count; i++)
+        {
+            xMin = fminf(xMin, pool->x[i]);
+            xMax = fmaxf(xMax, pool->x[i]);
+            yMin = fminf(yMin, pool->y[i]);
+            yMax = fmaxf(yMax, pool->y[i]);
+            sizeMax = fmaxf(sizeMax, pool->sizeStart[i] + fmaxf(pool->sizeDelta[i], 0.f));
+        }
+    }
+
+    if (xMin > xMax)
+    {
+        self->m_bounds = AABB_set(0.f, 0.f, 0.f, 0.f);
+    }
+    else
+    {
+        float margin = 0.5f * sizeMax;
+        self->m_bounds = AABB_set(xMin - margin, yMin - margin, xMax + margin, yMax + margin);
+    }
+}
+
+void ParticleSystem_render(ParticleSystem *self, Camera *camera)
+{
+    assert(self && "The ParticleSystem must be created");
+    assert(camera && "The Camera must be created");
+
+    for (int p = 0; p < PARTICLE_TEXTURE_COUNT; p++)
+    {
+        ParticlePool *pool = self->m_pools + p;
+        if (pool->count > 0 && pool->texture)
+        {
+            ParticlePool_render(pool, self, camera);
+        }
+    }
+}
+
+static void ParticlePool_init(ParticlePool *pool, int capacity)
+{
+    size_t size = (size_t)capacity * sizeof(float);
+    float **arrays[] = {
+        &pool->x, &pool->y, &pool->vx, &pool->vy, &pool->drag,
+        &pool->age, &pool->ageRate, &pool->sizeStart, &pool->sizeDelta
+    };
+    for (int i = 0; i < (int)(sizeof(arrays) / sizeof(arrays[0])); i++)
+    {
+        // Mémoire alignée pour les chargements vectoriels
+        *arrays[i] = (float *)SDL_SIMDAlloc(size);
+        AssertNew(*arrays[i]);
+        memset(*arrays[i], 0, size);
+    }
+    pool->colorStart = (Uint32 *)calloc(capacity, sizeof(Uint32));
+    pool->colorEnd = (Uint32 *)calloc(capacity, sizeof(Uint32));
+    AssertNew(pool->colorStart);
+    AssertNew(pool->colorEnd);
+
+    pool->count = 0;
+    pool->capacity = capacity;
+}
+
+static void ParticlePool_free(ParticlePool *pool)
+{
+    SDL_SIMDFree(pool->x);
+    SDL_SIMDFree(pool->y);
+    SDL_SIMDFree(pool->vx);
+    SDL_SIMDFree(pool->vy);
+    SDL_SIMDFree(pool->drag);
+    SDL_SIMDFree(pool->age);
+    SDL_SIMDFree(pool->ageRate);
+    SDL_SIMDFree(pool->sizeStart);
+    SDL_SIMDFree(pool->sizeDelta);
+    free(pool->colorStart);
+    free(pool->colorEnd);
+    if (pool->texture) SDL_DestroyTexture(pool->texture);
+}
+
+static void ParticlePool_integrate(ParticlePool *pool, float delta)
+{
+    // Les particules au-delà de count sont aussi intégrées : la capacité
+    // est un multiple de 4 et leurs valeurs sont ignorées
+    const int n = (pool->count + 3) & ~3;
+    float *x = pool->x, *y = pool->y;
+    float *vx = pool->vx, *vy = pool->vy;
+    const float *drag = pool->drag;
+    float *age = pool->age;
+    const float *ageRate = pool->ageRate;
+
+#if defined(__SSE__)
+    const __m128 dt = _mm_set1_ps(delta);
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 zero = _mm_setzero_ps();
+    for (int i = 0; i < n; i += 4)
+    {
+        __m128 damping = _mm_max_ps(zero, _mm_sub_ps(one, _mm_mul_ps(_mm_load_ps(drag + i), dt)));
+        __m128 vx4 = _mm_mul_ps(_mm_load_ps(vx + i), damping);
+        __m128 vy4 = _mm_mul_ps(_mm_load_ps(vy + i), damping);
+        _mm_store_ps(vx + i, vx4);
+        _mm_store_ps(vy + i, vy4);
+        _mm_store_ps(x + i, _mm_add_ps(_mm_load_ps(x + i), _mm_mul_ps(vx4, dt)));
+        _mm_store_ps(y + i, _mm_add_ps(_mm_load_ps(y + i), _mm_mul_ps(vy4, dt)));
+        _mm_store_ps(age + i, _mm_add_ps(_mm_load_ps(age + i), _mm_mul_ps(_mm_load_ps(ageRate + i), dt)));
+    }
+#elif defined(__ARM_NEON)
+    const float32x4_t one = vdupq_n_f32(1.f);
+    const float32x4_t zero = vdupq_n_f32(0.f);
+    for (int i = 0; i < n; i += 4)
+    {
+        float32x4_t damping = vmaxq_f32(zero, vsubq_f32(one, vmulq_n_f32(vld1q_f32(drag + i), delta)));
+        float32x4_t vx4 = vmulq_f32(vld1q_f32(vx + i), damping);
+        float32x4_t vy4 = vmulq_f32(vld1q_f32(vy + i), damping);
+        vst1q_f32(vx + i, vx4);
+        vst1q_f32(vy + i, vy4);
+        vst1q_f32(x + i, vaddq_f32(vld1q_f32(x + i), vmulq_n_f32(vx4, delta)));
+        vst1q_f32(y + i, vaddq_f32(vld1q_f32(y + i), vmulq_n_f32(vy4, delta)));
+        vst1q_f32(age + i, vaddq_f32(vld1q_f32(age + i), vmulq_n_f32(vld1q_f32(ageRate + i), delta)));
+    }
+#else
+    for (int i = 0; i < n; i++)
+    {
+        float damping = fmaxf(0.f, 1.f - drag[i] * delta);
+        vx[i] *= damping;
+        vy[i] *= damping;
+        x[i] += vx[i] * delta;
+        y[i] += vy[i] * delta;
+        age[i] += ageRate[i] * delta;
+    }
+#endif
+}
+
+static void ParticlePool_removeDead(ParticlePool *pool)
+{
+    // Une particule morte est remplacée par la dernière du réservoir
+    int count = pool->count;
+    int i = 0;
+    while (i < count)
+    {
+        if (pool->age[i] < 1.f)
+        {
+            i++;
+            continue;
+        }
+        count--;
+        pool->x[i] = pool->x[count];
+        pool->y[i] = pool->y[count];
+        pool->vx[i] = pool->vx[count];
+        pool->vy[i] = pool->vy[count];
+        pool->drag[i] = pool->drag[count];
+        pool->age[i] = pool->age[count];
+        pool->ageRate[i] = pool->ageRate[count];
+        pool->sizeStart[i] = pool->sizeStart[count];
+        pool->sizeDelta[i] = pool->sizeDelta[count];
+        pool->colorStart[i] = pool->colorStart[count];
+        pool->colorEnd[i] = pool->colorEnd[count];
+    }
+    pool->count = count;
+}
+
+static void ParticlePool_render(
+    ParticlePool *pool, ParticleSystem *system, Camera *camera)
+{
+    SDL_Vertex *vertices = system->m_vertices;
+    const float *viewX = system->m_viewX;
+    const float *viewY = system->m_viewY;
+    const float scale = Camera_getWorldToViewScale(camera);
+    const int count = pool->count;
+
+    // Toutes les positions sont transformées d'un seul coup
+    Camera_worldToViewBatch(camera, pool->x, pool->y, system->m_viewX, system->m_viewY, count);
+
+    for (int i = 0; i < count; i++)
+    {
+        float t = fminf(pool->age[i], 1.f);
+        float half = 0.5f * scale * (pool->sizeStart[i] + pool->sizeDelta[i] * t);
+        float cx = viewX[i];
+        float cy = viewY[i];
+
+        // Fondu de la couleur en virgule fixe
+        int w = (int)(256.f * t);
+        Uint32 c0 = pool->colorStart[i];
+        Uint32 c1 = pool->colorEnd[i];
+        SDL_Color color = { 0 };
+        color.r = ParticlePool_lerpChannel(c0, c1, 24, w);
+        color.g = ParticlePool_lerpChannel(c0, c1, 16, w);
+        color.b = ParticlePool_lerpChannel(c0, c1, 8, w);
+        color.a = ParticlePool_lerpChannel(c0, c1, 0, w);
+
+        SDL_Vertex *quad = vertices + 4 * i;
+        quad[0].position.x = cx - half; quad[0].position.y = cy - half;
+        quad[1].position.x = cx + half; quad[1].position.y = cy - half;
+        quad[2].position.x = cx + half; quad[2].position.y = cy + half;
+        quad[3].position.x = cx - half; quad[3].position.y = cy + half;
+        quad[0].color = quad[1].color = quad[2].color = quad[3].color = color;
+    }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (SDL_RenderGeometry(
+        system->m_renderer, pool->texture,
+        vertices, 4 * count, system->m_indices, 6 * count) == 0)
+    {
+        return;
+    }
+#endif
+
+    // Repli : une copie par particule
+    for (int i = 0; i < count; i++)
+    {
+        const SDL_Vertex *quad = vertices + 4 * i;
+        SDL_FRect dst = {
+            quad[0].position.x, quad[0].position.y,
+            quad[2].position.x - quad[0].position.x,
+            quad[2].position.y - quad[0].position.y
+        };
+        RenderState_setTextureColorMod(g_renderState, pool->texture, quad[0].color.r, quad[0].color.g, quad[0].color.b);
+        RenderState_setTextureAlphaMod(g_renderState, pool->texture, quad[0].color.a);
+        SDL_RenderCopyF(system->m_renderer, pool->texture, NULL, &dst);
+    }
+    RenderState_setTextureColorMod(g_renderState, pool->texture, 255, 255, 255);
+    RenderState_setTextureAlphaMod(g_renderState, pool->texture, 255);
+}
+
+static Uint8 ParticlePool_lerpChannel(Uint32 c0, Uint32 c1, int shift, int w)
+{
+    int a = (int)((c0 >> shift) & 0xFF);
+    int b = (int)((c1 >> shift) & 0xFF);
+    return (Uint8)(a + (((b - a) * w) >> 8));
+}
+
+static SDL_Texture *ParticleSystem_createTexture(
+    SDL_Renderer *renderer, int size, float hardness, SDL_BlendMode blendMode)
+{
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(
+        0, size, size, 32, SDL_PIXELFORMAT_ARGB8888);
+    AssertNew(surface);
+
+    // Disque blanc dont l'opacité décroît du centre vers le bord
+    SDL_LockSurface(surface);
+    for (int j = 0; j < size; j++)
+    {
+        Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + j * surface->pitch);
+        for (int i = 0; i < size; i++)
+        {
+            float dx = (2.f * i + 1.f) / size - 1.f;
+            float dy = (2.f * j + 1.f) / size - 1.f;
+            float d = fmaxf(0.f, 1.f - sqrtf(dx * dx + dy * dy));
+            Uint32 alpha = (Uint32)(255.f * powf(d, hardness));
+            row[i] = (alpha << 24) | 0x00FFFFFFu;
+        }
+    }
+    SDL_UnlockSurface(surface);
+
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+    if (texture == NULL)
+    {
+        printf("ERROR - Create particle texture %s\n", SDL_GetError());
+        return NULL;
+    }
+    SDL_SetTextureBlendMode(texture, blendMode);
+    return texture;
+}
+
+static float ParticleSystem_random(ParticleSystem *self)
+{
+    self->m_seed = self->m_seed * 1664525u + 1013904223u;
+    return (float)(self->m_seed >> 8) * (1.f / 16777216.f);
+}
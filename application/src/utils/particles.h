@@ -0,0 +1,168 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+#include "utils/math.h"
+#include "utils/camera.h"
+
+/// @brief Textures des particules. Chaque texture possède son propre
+/// réservoir de particules, dessiné en un seul appel.
+typedef enum ParticleTexture
+{
+    /// @brief Petit point lumineux (mélange additif).
+    PARTICLE_TEXTURE_SPARK,
+    /// @brief Tache diffuse (mélange alpha).
+    PARTICLE_TEXTURE_SMOKE,
+    PARTICLE_TEXTURE_COUNT
+} ParticleTexture;
+
+/// @brief Structure décrivant les particules émises par un effet.
+typedef struct ParticleParams
+{
+    /// @brief Texture des particules (ParticleTexture).
+    int texture;
+
+    /// @brief Direction moyenne (en degrés) et demi-angle de dispersion.
+    float angle;
+    float spread;
+
+    /// @brief Vitesse initiale dans le référentiel monde.
+    float speedMin, speedMax;
+
+    /// @brief Fraction de la vitesse perdue par seconde.
+    float drag;
+
+    /// @brief Durée de vie (en secondes).
+    float lifeMin, lifeMax;
+
+    /// @brief Taille au début et à la fin de la vie (dans le référentiel monde).
+    float sizeStart, sizeEnd;
+
+    /// @brief Couleur au début et à la fin de la vie.
+    SDL_Color colorStart, colorEnd;
+} ParticleParams;
+
+/// @brief Structure représentant les particules d'une même texture,
+/// stockées en structure de tableaux (SoA).
+/// Les tableaux sont alignés et leur capacité est un multiple de 4 afin
+/// que l'intégration traite quatre particules par instruction.
+typedef struct ParticlePool
+{
+    float *x, *y;
+    float *vx, *vy;
+    float *drag;
+
+    /// @brief Age normalisé (de 0 à 1) et son accroissement par seconde.
+    float *age;
+    float *ageRate;
+
+    float *sizeStart, *sizeDelta;
+
+    /// @brief Couleurs de début et de fin de vie (RGBA8888).
+    Uint32 *colorStart, *colorEnd;
+
+    int count;
+    int capacity;
+
+    SDL_Texture *texture;
+} ParticlePool;
+
+/// @brief Structure représentant un système de particules.
+/// Les particules ne sont jamais allouées individuellement et chaque
+/// réservoir est dessiné par un unique appel à SDL_RenderGeometry().
+typedef struct ParticleSystem
+{
+    SDL_Renderer *m_renderer;
+
+    ParticlePool m_pools[PARTICLE_TEXTURE_COUNT];
+
+    /// @brief Sommets et indices partagés par les réservoirs.
+    SDL_Vertex *m_vertices;
+    int *m_indices;
+
+    /// @brief Positions des particules d'un réservoir dans la vue (en pixels).
+    float *m_viewX;
+    float *m_viewY;
+
+    /// @brief Boîte englobante des particules dans le référentiel monde.
+    AABB m_bounds;
+
+    /// @brief Etat du générateur pseudo-aléatoire.
+    Uint32 m_seed;
+} ParticleSystem;
+
+/// @brief Crée un système de particules.
+/// @param renderer le moteur de rendu.
+/// @param capacity le nombre maximal de particules par texture.
+/// @return Le système créé.
+ParticleSystem *ParticleSystem_create(SDL_Renderer *renderer, int capacity);
+
+/// @brief Détruit un système de particules.
+/// @param self le système.
+void ParticleSystem_destroy(ParticleSystem *self);
+
+/// @brief Supprime toutes les particules.
+/// @param self le système.
+void ParticleSystem_clear(ParticleSystem *self);
+
+/// @brief Emet des particules. Les particules en excès sont ignorées
+/// lorsque le réservoir est plein.
+/// @param self le système.
+/// @param params les paramètres de l'effet.
+/// @param position la position d'émission dans le référentiel monde.
+/// @param velocity la vitesse de l'émetteur, transmise aux particules.
+/// @param count le nombre de particules.
+void ParticleSystem_emit(
+    ParticleSystem *self, const ParticleParams *params,
+    Vec2 position, Vec2 velocity, int count);
+
+/// @brief Emet des particules à un débit donné pendant une durée.
+/// La partie fractionnaire est tirée au hasard, le débit moyen est exact.
+/// @param self le système.
+/// @param params les paramètres de l'effet.
+/// @param position la position d'émission dans le référentiel monde.
+/// @param velocity la vitesse de l'émetteur, transmise aux particules.
+/// @param rate le débit (en particules par seconde).
+/// @param delta la durée (en secondes).
+void ParticleSystem_emitRate(
+    ParticleSystem *self, const ParticleParams *params,
+    Vec2 position, Vec2 velocity, float rate, float delta);
+
+/// @brief Fait avancer toutes les particules puis supprime les mortes.
+/// @param self le système.
+/// @param delta le temps écoulé (en secondes).
+void ParticleSystem_update(ParticleSystem *self, float delta);
+
+/// @brief Dessine les particules, un appel par texture.
+/// @param self le système.
+/// @param camera la caméra.
+void ParticleSystem_render(ParticleSystem *self, Camera *camera);
+
+/// @brief Renvoie le nombre total de particules vivantes.
+/// @param self le système.
+/// @return Le nombre de particules.
+INLINE int ParticleSystem_getCount(ParticleSystem *self)
+{
+    assert(self && "The ParticleSystem must be created");
+    int count = 0;
+    for (int i = 0; i < PARTICLE_TEXTURE_COUNT; i++)
+    {
+        count += self->m_pools[i].count;
+    }
+    return count;
+}
+
+/// @brief Renvoie la boîte englobante des particules, calculée par le
+/// dernier appel à ParticleSystem_update().
+/// @param self le système.
+/// @return La boîte dans le référentiel monde.
+INLINE AABB ParticleSystem_getBounds(ParticleSystem *self)
+{
+    assert(self && "The ParticleSystem must be created");
+    return self->m_bounds;
+}
@@ -0,0 +1,132 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "utils/render_queue.h"
+
+static int RenderQueue_getTextureID(RenderQueue *self, SDL_Texture *texture);
+
+RenderQueue *RenderQueue_create(int capacity)
+{
+    assert(0 < capacity && capacity <= (1 << RENDER_QUEUE_PAYLOAD_BITS));
+
+    RenderQueue *self = (RenderQueue *)calloc(1, sizeof(RenderQueue));
+    AssertNew(self);
+
+    self->m_capacity = capacity;
+    self->m_keys = (Uint64 *)calloc(capacity, sizeof(Uint64));
+    AssertNew(self->m_keys);
+    self->m_tmpKeys = (Uint64 *)calloc(capacity, sizeof(Uint64));
+    AssertNew(self->m_tmpKeys);
+
+    return self;
+}
+
+void RenderQueue_destroy(RenderQueue *self)
+{
+    if (!self) return;
+    free(self->m_keys);
+    free(self->m_tmpKeys);
+    free(self);
+}
+
+void RenderQueue_clear(RenderQueue *self)
+{
+    assert(self && "The RenderQueue must be created");
+    self->m_count = 0;
+}
+
+void RenderQueue_push(
+    RenderQueue *self, int layer, int depth,
+    SDL_Texture *texture, SDL_BlendMode blendMode, Uint32 command)
+{
+    assert(self && "The RenderQueue must be created");
+    assert(command < (1u << RENDER_QUEUE_PAYLOAD_BITS));
+    if (self->m_count >= self->m_capacity)
+    {
+        assert(false && "The RenderQueue capacity is exceeded");
+        return;
+    }
+
+    Uint64 key = 0;
+    key |= (Uint64)(layer & 0xFF) << 56;
+    key |= (Uint64)(0xFFFF - (depth & 0xFFFF)) << 40;
+    key |= (Uint64)RenderQueue_getTextureID(self, texture) << 32;
+    key |= (Uint64)(blendMode & 0xFF) << 24;
+    key |= (Uint64)command;
+
+    self->m_keys[self->m_count++] = key;
+}
+
+void RenderQueue_sort(RenderQueue *self)
+{
+    assert(self && "The RenderQueue must be created");
+    int count = self->m_count;
+    if (count <= 1)
+        return;
+
+    // Histogrammes des octets de poids fort, en une seule lecture.
+    // Les octets de l'indice ne sont pas triés : les commandes sont
+    // soumises dans l'ordre et le tri par base est stable.
+    const int firstByte = RENDER_QUEUE_PAYLOAD_BITS / 8;
+    int histograms[8][256] = { 0 };
+    for (int i = 0; i < count; i++)
+    {
+        Uint64 key = self->m_keys[i];
+        for (int b = firstByte; b < 8; b++)
+        {
+            histograms[b][(key >> (8 * b)) & 0xFF]++;
+        }
+    }
+
+    Uint64 *src = self->m_keys;
+    Uint64 *dst = self->m_tmpKeys;
+    for (int b = firstByte; b < 8; b++)
+    {
+        int *histogram = histograms[b];
+        int shift = 8 * b;
+
+        // Passe inutile si toutes les clés ont le même octet
+        if (histogram[(src[0] >> shift) & 0xFF] == count)
+            continue;
+
+        int offset = 0;
+        for (int v = 0; v < 256; v++)
+        {
+            int n = histogram[v];
+            histogram[v] = offset;
+            offset += n;
+        }
+        for (int i = 0; i < count; i++)
+        {
+            Uint64 key = src[i];
+            dst[histogram[(key >> shift) & 0xFF]++] = key;
+        }
+
+        Uint64 *tmp = src; src = dst; dst = tmp;
+    }
+
+    if (src != self->m_keys)
+    {
+        self->m_tmpKeys = self->m_keys;
+        self->m_keys = src;
+    }
+}
+
+static int RenderQueue_getTextureID(RenderQueue *self, SDL_Texture *texture)
+{
+    for (int i = 0; i < self->m_textureCount; i++)
+    {
+        if (self->m_textures[i] == texture)
+            return i;
+    }
+    if (self->m_textureCount < RENDER_QUEUE_TEXTURE_CAPACITY)
+    {
+        self->m_textures[self->m_textureCount] = texture;
+        return self->m_textureCount++;
+    }
+    // Les textures suivantes ne sont plus regroupées entre elles
+    return RENDER_QUEUE_TEXTURE_CAPACITY - 1;
+}
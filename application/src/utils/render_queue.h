@@ -0,0 +1,91 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+
+/// @brief Nombre maximal de textures distinguées par les clés de tri.
+#define RENDER_QUEUE_TEXTURE_CAPACITY 256
+
+/// @brief Nombre de bits de la clé réservés à l'indice de la commande.
+#define RENDER_QUEUE_PAYLOAD_BITS 24
+
+/// @brief Structure représentant une file de commandes de rendu triées.
+/// Chaque commande est identifiée par une clé de 64 bits :
+///   bits 56-63 : couche,
+///   bits 40-55 : profondeur inversée (les plus profonds d'abord),
+///   bits 32-39 : identifiant de la texture,
+///   bits 24-31 : mode de fusion,
+///   bits  0-23 : indice de la commande (ordre de soumission).
+/// Le tri par base (radix) est stable et regroupe, à couche et profondeur
+/// égales, les commandes partageant la même texture.
+typedef struct RenderQueue
+{
+    /// @brief Clés des commandes soumises.
+    Uint64 *m_keys;
+
+    /// @brief Tampon temporaire utilisé pendant le tri.
+    Uint64 *m_tmpKeys;
+
+    int m_count;
+    int m_capacity;
+
+    /// @brief Textures rencontrées, l'indice sert d'identifiant dans les clés.
+    SDL_Texture *m_textures[RENDER_QUEUE_TEXTURE_CAPACITY];
+    int m_textureCount;
+} RenderQueue;
+
+/// @brief Crée une file de commandes de rendu.
+/// @param capacity le nombre maximal de commandes par image.
+/// @return La file créée.
+RenderQueue *RenderQueue_create(int capacity);
+
+/// @brief Détruit une file de commandes de rendu.
+/// @param self la file.
+void RenderQueue_destroy(RenderQueue *self);
+
+/// @brief Vide la file.
+/// @param self la file.
+void RenderQueue_clear(RenderQueue *self);
+
+/// @brief Ajoute une commande à la file.
+/// L'indice de la commande est celui renvoyé par RenderQueue_getCommand()
+/// après le tri, il doit être inférieur à 2^RENDER_QUEUE_PAYLOAD_BITS.
+/// @param self la file.
+/// @param layer la couche (entre 0 et 255).
+/// @param depth la profondeur dans la couche (entre 0 et 65535),
+/// les commandes les plus profondes sont dessinées en premier.
+/// @param texture la texture utilisée par la commande.
+/// @param blendMode le mode de fusion utilisé par la commande.
+/// @param command l'indice de la commande.
+void RenderQueue_push(
+    RenderQueue *self, int layer, int depth,
+    SDL_Texture *texture, SDL_BlendMode blendMode, Uint32 command);
+
+/// @brief Trie les commandes de la file.
+/// @param self la file.
+void RenderQueue_sort(RenderQueue *self);
+
+/// @brief Renvoie le nombre de commandes de la file.
+/// @param self la file.
+/// @return Le nombre de commandes.
+INLINE int RenderQueue_getCount(RenderQueue *self)
+{
+    assert(self && "The RenderQueue must be created");
+    return self->m_count;
+}
+
+/// @brief Renvoie l'indice de la i-ème commande de la file.
+/// @param self la file.
+/// @param i la position de la commande dans la file.
+/// @return L'indice donné lors de l'ajout de la commande.
+INLINE Uint32 RenderQueue_getCommand(RenderQueue *self, int i)
+{
+    assert(self && "The RenderQueue must be created");
+    assert(0 <= i && i < self->m_count);
+    return (Uint32)(self->m_keys[i] & ((1u << RENDER_QUEUE_PAYLOAD_BITS) - 1));
+}
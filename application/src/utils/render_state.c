@@ -0,0 +1,163 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "utils/render_state.h"
+#include "utils/common.h"
+
+RenderState *RenderState_create(SDL_Renderer *renderer)
+{
+    assert(renderer && "The SDL_Renderer must be created");
+
+    RenderState *self = (RenderState *)calloc(1, sizeof(RenderState));
+    AssertNew(self);
+
+    self->m_renderer = renderer;
+    RenderState_invalidate(self);
+
+    return self;
+}
+
+void RenderState_destroy(RenderState *self)
+{
+    if (!self) return;
+    free(self);
+}
+
+void RenderState_invalidate(RenderState *self)
+{
+    assert(self && "The RenderState must be created");
+    self->m_drawColorValid = false;
+    self->m_drawBlendModeValid = false;
+}
+
+void RenderState_setDrawColor(RenderState *self, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    assert(self && "The RenderState must be created");
+    SDL_Color *color = &(self->m_drawColor);
+    if (self->m_drawColorValid &&
+        color->r == r && color->g == g && color->b == b && color->a == a)
+    {
+        self->m_frameSkipCount++;
+        return;
+    }
+
+    SDL_SetRenderDrawColor(self->m_renderer, r, g, b, a);
+    color->r = r; color->g = g; color->b = b; color->a = a;
+    self->m_drawColorValid = true;
+    self->m_frameCallCount++;
+}
+
+void RenderState_setDrawBlendMode(RenderState *self, SDL_BlendMode blendMode)
+{
+    assert(self && "The RenderState must be created");
+    if (self->m_drawBlendModeValid && self->m_drawBlendMode == blendMode)
+    {
+        self->m_frameSkipCount++;
+        return;
+    }
+
+    SDL_SetRenderDrawBlendMode(self->m_renderer, blendMode);
+    self->m_drawBlendMode = blendMode;
+    self->m_drawBlendModeValid = true;
+    self->m_frameCallCount++;
+}
+
+void RenderState_setTextureColorMod(
+    RenderState *self, SDL_Texture *texture, Uint8 r, Uint8 g, Uint8 b)
+{
+    assert(self && "The RenderState must be created");
+    assert(texture);
+
+    Uint8 curR = 0, curG = 0, curB = 0;
+    if (SDL_GetTextureColorMod(texture, &curR, &curG, &curB) == 0 &&
+        curR == r && curG == g && curB == b)
+    {
+        self->m_frameSkipCount++;
+        return;
+    }
+    SDL_SetTextureColorMod(texture, r, g, b);
+    self->m_frameCallCount++;
+}
+
+void RenderState_setTextureAlphaMod(RenderState *self, SDL_Texture *texture, Uint8 alpha)
+{
+    assert(self && "The RenderState must be created");
+    assert(texture);
+
+    Uint8 current = 0;
+    if (SDL_GetTextureAlphaMod(texture, &current) == 0 && current == alpha)
+    {
+        self->m_frameSkipCount++;
+        return;
+    }
+    SDL_SetTextureAlphaMod(texture, alpha);
+    self->m_frameCallCount++;
+}
+
+void RenderState_setTextureBlendMode(
+    RenderState *self, SDL_Texture *texture, SDL_BlendMode blendMode)
+{
+    assert(self && "The RenderState must be created");
+    assert(texture);
+
+    SDL_BlendMode current = SDL_BLENDMODE_INVALID;
+    if (SDL_GetTextureBlendMode(texture, &current) == 0 && current == blendMode)
+    {
+        self->m_frameSkipCount++;
+        return;
+    }
+    SDL_SetTextureBlendMode(texture, blendMode);
+    self->m_frameCallCount++;
+}
+
+void RenderState_setHint(RenderState *self, const char *name, const char *value)
+{
+    assert(self && "The RenderState must be created");
+    assert(name && value);
+
+    const char *current = SDL_GetHint(name);
+    if (current && strcmp(current, value) == 0)
+    {
+        self->m_frameSkipCount++;
+        return;
+    }
+    SDL_SetHintWithPriority(name, value, SDL_HINT_OVERRIDE);
+    self->m_frameCallCount++;
+}
+
+void RenderState_endFrame(RenderState *self)
+{
+    assert(self && "The RenderState must be created");
+    self->m_callCount += (Uint64)self->m_frameCallCount;
+    self->m_skipCount += (Uint64)self->m_frameSkipCount;
+    self->m_skipMax = SDL_max(self->m_skipMax, (Uint64)self->m_frameSkipCount);
+    self->m_frameCount++;
+    self->m_frameCallCount = 0;
+    self->m_frameSkipCount = 0;
+}
+
+void RenderState_printStats(RenderState *self)
+{
+    assert(self && "The RenderState must be created");
+
+    if (self->m_frameCount > 0)
+    {
+        Uint64 total = self->m_callCount + self->m_skipCount;
+        printf("INFO - Render state over %llu frames\n",
+            (unsigned long long)self->m_frameCount);
+        printf("     - avoided calls %.1f per frame (max %llu), forwarded %.1f per frame\n",
+            (double)self->m_skipCount / (double)self->m_frameCount,
+            (unsigned long long)self->m_skipMax,
+            (double)self->m_callCount / (double)self->m_frameCount);
+        printf("     - %.1f%% of the state changes were redundant\n",
+            total > 0 ? 100.0 * (double)self->m_skipCount / (double)total : 0.0);
+    }
+
+    self->m_callCount = 0;
+    self->m_skipCount = 0;
+    self->m_skipMax = 0;
+    self->m_frameCount = 0;
+}
@@ -0,0 +1,124 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+
+/// @brief Structure représentant une couche de suivi de l'état du moteur
+/// de rendu. Elle mémorise la couleur et le mode de mélange des dessins et
+/// n'appelle la SDL que si une valeur change réellement.
+/// Pour que le suivi reste exact, la couleur et le mode de mélange des
+/// dessins ne doivent être modifiés que par cette couche.
+typedef struct RenderState
+{
+    SDL_Renderer *m_renderer;
+
+    /// @brief Couleur et mode de mélange courants des dessins.
+    SDL_Color m_drawColor;
+    SDL_BlendMode m_drawBlendMode;
+
+    /// @brief Booléens indiquant si les valeurs mémorisées sont connues.
+    bool m_drawColorValid;
+    bool m_drawBlendModeValid;
+
+    /// @brief Appels transmis à la SDL et appels évités depuis le début de
+    /// l'image courante.
+    int m_frameCallCount;
+    int m_frameSkipCount;
+
+    /// @brief Cumuls depuis le dernier affichage des statistiques.
+    Uint64 m_callCount;
+    Uint64 m_skipCount;
+    Uint64 m_skipMax;
+    Uint64 m_frameCount;
+} RenderState;
+
+/// @brief Crée la couche de suivi de l'état d'un moteur de rendu.
+/// @param renderer le moteur de rendu.
+/// @return La couche créée.
+RenderState *RenderState_create(SDL_Renderer *renderer);
+
+/// @brief Détruit une couche de suivi de l'état du moteur de rendu.
+/// @param self la couche.
+void RenderState_destroy(RenderState *self);
+
+/// @brief Oublie les valeurs mémorisées. Les prochains appels sont tous
+/// transmis à la SDL. Utile si le moteur de rendu a été réinitialisé.
+/// @param self la couche.
+void RenderState_invalidate(RenderState *self);
+
+/// @brief Définit la couleur des dessins (SDL_SetRenderDrawColor()).
+/// @param self la couche.
+/// @param r la composante rouge.
+/// @param g la composante verte.
+/// @param b la composante bleue.
+/// @param a l'opacité.
+void RenderState_setDrawColor(RenderState *self, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+
+/// @brief Définit le mode de mélange des dessins (SDL_SetRenderDrawBlendMode()).
+/// @param self la couche.
+/// @param blendMode le mode de mélange.
+void RenderState_setDrawBlendMode(RenderState *self, SDL_BlendMode blendMode);
+
+/// @brief Définit la couleur de modulation d'une texture.
+/// La valeur courante est lue dans la texture, elle reste donc exacte même
+/// si la texture est modifiée ailleurs.
+/// @param self la couche.
+/// @param texture la texture.
+/// @param r la composante rouge.
+/// @param g la composante verte.
+/// @param b la composante bleue.
+void RenderState_setTextureColorMod(
+    RenderState *self, SDL_Texture *texture, Uint8 r, Uint8 g, Uint8 b);
+
+/// @brief Définit l'opacité de modulation d'une texture.
+/// @param self la couche.
+/// @param texture la texture.
+/// @param alpha l'opacité.
+void RenderState_setTextureAlphaMod(RenderState *self, SDL_Texture *texture, Uint8 alpha);
+
+/// @brief Définit le mode de mélange d'une texture.
+/// @param self la couche.
+/// @param texture la texture.
+/// @param blendMode le mode de mélange.
+void RenderState_setTextureBlendMode(
+    RenderState *self, SDL_Texture *texture, SDL_BlendMode blendMode);
+
+/// @brief Définit la valeur d'un indice de la SDL avec la priorité
+/// SDL_HINT_OVERRIDE, si elle est différente de la valeur courante.
+/// @param self la couche.
+/// @param name le nom de l'indice.
+/// @param value la valeur.
+void RenderState_setHint(RenderState *self, const char *name, const char *value);
+
+/// @brief Termine l'image courante et cumule ses compteurs.
+/// Cette fonction est appelée juste après SDL_RenderPresent().
+/// @param self la couche.
+void RenderState_endFrame(RenderState *self);
+
+/// @brief Affiche les statistiques des appels évités puis les réinitialise.
+/// @param self la couche.
+void RenderState_printStats(RenderState *self);
+
+/// @brief Renvoie le nombre d'appels évités depuis le début de l'image.
+/// @param self la couche.
+/// @return Le nombre d'appels évités.
+INLINE int RenderState_getFrameSkipCount(RenderState *self)
+{
+    assert(self && "The RenderState must be created");
+    return self->m_frameSkipCount;
+}
+
+/// @brief Renvoie le nombre d'appels transmis à la SDL depuis le début de
+/// l'image.
+/// @param self la couche.
+/// @return Le nombre d'appels transmis.
+INLINE int RenderState_getFrameCallCount(RenderState *self)
+{
+    assert(self && "The RenderState must be created");
+    return self->m_frameCallCount;
+}
@@ -0,0 +1,334 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "utils/rewind_buffer.h"
+
+/// @brief Longueur minimale d'une plage de zéros interrompant une plage
+/// d'octets littéraux lors de l'encodage.
+#define REWIND_MIN_ZERO_RUN 4
+
+/// @brief Longueur maximale d'une plage (taille d'un en-tête Uint16).
+#define REWIND_MAX_RUN 0xFFFF
+
+static size_t RewindBuffer_encode(
+    const Uint8 *state, const Uint8 *base, size_t size, Uint8 *dst);
+static void RewindBuffer_applyPatch(
+    const Uint8 *src, size_t srcSize, Uint8 *state, size_t size);
+static RewindFrame *RewindBuffer_getFrame(RewindBuffer *self, int index);
+static void RewindBuffer_decode(RewindBuffer *self, int index, Uint8 *state);
+static bool RewindBuffer_overlaps(RewindBuffer *self, size_t offset, size_t size);
+static void RewindBuffer_dropOldestGroup(RewindBuffer *self);
+
+RewindBuffer *RewindBuffer_create(
+    size_t stateSize, int frameCapacity, int keyframeInterval, size_t byteCapacity)
+{
+    assert(stateSize > 0 && frameCapacity > 0 && keyframeInterval > 0);
+
+    RewindBuffer *self = (RewindBuffer *)calloc(1, sizeof(RewindBuffer));
+    AssertNew(self);
+
+    self->m_stateSize = stateSize;
+    self->m_keyframeInterval = keyframeInterval;
+
+    // Un état encodé ne dépasse jamais cette taille, l'anneau doit pouvoir
+    // contenir au moins une image clé.
+    size_t maxEncoded = stateSize + 4 * (stateSize / REWIND_MIN_ZERO_RUN + 2);
+    self->m_capacity = (byteCapacity > maxEncoded) ? byteCapacity : maxEncoded;
+
+    self->m_data = (Uint8 *)malloc(self->m_capacity);
+    AssertNew(self->m_data);
+
+    self->m_frameCapacity = frameCapacity;
+    self->m_frames = (RewindFrame *)calloc(frameCapacity, sizeof(RewindFrame));
+    AssertNew(self->m_frames);
+
+    self->m_prev = (Uint8 *)calloc(1, stateSize);
+    AssertNew(self->m_prev);
+
+    self->m_scratch = (Uint8 *)malloc(maxEncoded);
+    AssertNew(self->m_scratch);
+
+    RewindBuffer_clear(self);
+
+    return self;
+}
+
+void RewindBuffer_destroy(RewindBuffer *self)
+{
+    if (!self) return;
+    free(self->m_data);
+    free(self->m_frames);
+    free(self->m_prev);
+    free(self->m_scratch);
+    free(self);
+}
+
+void RewindBuffer_clear(RewindBuffer *self)
+{
+    assert(self && "The RewindBuffer must be created");
+    self->m_head = 0;
+    self->m_byteCount = 0;
+    self->m_first = 0;
+    self->m_count = 0;
+}
+
+void RewindBuffer_push(RewindBuffer *self, const void *state)
+{
+    assert(self && "The RewindBuffer must be created");
+    assert(state);
+
+    // Une image clé est nécessaire au début et toutes les N images
+    int chain = 0;
+    if (self->m_count > 0)
+    {
+        RewindFrame *last = RewindBuffer_getFrame(self, self->m_count - 1);
+        chain = last->chain + 1;
+        if (chain >= self->m_keyframeInterval) chain = 0;
+    }
+
+    const Uint8 *base = (chain == 0) ? NULL : self->m_prev;
+    size_t size = RewindBuffer_encode(
+        (const Uint8 *)state, base, self->m_stateSize, self->m_scratch);
+
+    // Libère de la place pour la nouvelle image
+    if (self->m_count == self->m_frameCapacity)
+    {
+        RewindBuffer_dropOldestGroup(self);
+    }
+    size_t offset = (self->m_head + size <= self->m_capacity) ? self->m_head : 0;
+    while (RewindBuffer_overlaps(self, offset, size))
+    {
+        RewindBuffer_dropOldestGroup(self);
+        if (self->m_count == 0)
+        {
+            self->m_head = 0;
+            offset = 0;
+        }
+    }
+
+    // Si la différence a perdu son image clé, on enregistre une image clé
+    if (chain > 0 && self->m_count == 0)
+    {
+        chain = 0;
+        size = RewindBuffer_encode(
+            (const Uint8 *)state, NULL, self->m_stateSize, self->m_scratch);
+        self->m_head = 0;
+        offset = 0;
+    }
+
+    if (chain == 0)
+    {
+        self->m_keyframeBytes += size;
+        self->m_keyframeCount++;
+    }
+    else
+    {
+        self->m_deltaBytes += size;
+        self->m_deltaCount++;
+    }
+
+    memcpy(self->m_data + offset, self->m_scratch, size);
+    self->m_head = offset + size;
+    self->m_byteCount += size;
+
+    int index = (self->m_first + self->m_count) % self->m_frameCapacity;
+    self->m_frames[index].offset = offset;
+    self->m_frames[index].size = size;
+    self->m_frames[index].chain = chain;
+    self->m_count++;
+
+    memcpy(self->m_prev, state, self->m_stateSize);
+}
+
+bool RewindBuffer_pop(RewindBuffer *self, void *state)
+{
+    assert(self && "The RewindBuffer must be created");
+    assert(state);
+
+    if (self->m_count == 0)
+        return false;
+
+    int index = self->m_count - 1;
+    RewindFrame *frame = RewindBuffer_getFrame(self, index);
+
+    if (index == 0)
+    {
+        RewindBuffer_decode(self, index, (Uint8 *)state);
+    }
+    else
+    {
+        // L'avant dernier état devient la référence des prochaines
+        // différences, le dernier état s'en déduit avec un seul patch.
+        RewindBuffer_decode(self, index - 1, self->m_prev);
+        if (frame->chain == 0)
+        {
+            memset(state, 0, self->m_stateSize);
+        }
+        else
+        {
+            memcpy(state, self->m_prev, self->m_stateSize);
+        }
+        RewindBuffer_applyPatch(
+            self->m_data + frame->offset, frame->size,
+            (Uint8 *)state, self->m_stateSize);
+    }
+
+    self->m_head = frame->offset;
+    self->m_byteCount -= frame->size;
+    self->m_count--;
+
+    return true;
+}
+
+void RewindBuffer_printStats(RewindBuffer *self, float framesPerSecond)
+{
+    assert(self && "The RewindBuffer must be created");
+
+    double seconds = (framesPerSecond > 0.f) ?
+        (double)self->m_count / (double)framesPerSecond : 0.0;
+    double bytesPerSecond = (seconds > 0.0) ?
+        (double)self->m_byteCount / seconds : 0.0;
+    size_t allocated = self->m_capacity
+        + 2 * self->m_stateSize
+        + self->m_frameCapacity * sizeof(RewindFrame);
+
+    printf("INFO - Rewind history %.1f s (%d frames), %.1f kB used, %.1f kB allocated\n",
+        seconds, self->m_count,
+        (double)self->m_byteCount / 1024.0, (double)allocated / 1024.0);
+    printf("     - %.1f kB per second of history (raw state %.1f kB)\n",
+        bytesPerSecond / 1024.0, (double)self->m_stateSize / 1024.0);
+    if (self->m_keyframeCount > 0 && self->m_deltaCount > 0)
+    {
+        printf("     - mean keyframe %.0f bytes, mean delta %.0f bytes\n",
+            (double)self->m_keyframeBytes / (double)self->m_keyframeCount,
+            (double)self->m_deltaBytes / (double)self->m_deltaCount);
+    }
+}
+
+static RewindFrame *RewindBuffer_getFrame(RewindBuffer *self, int index)
+{
+    assert(0 <= index && index < self->m_count);
+    return self->m_frames + (self->m_first + index) % self->m_frameCapacity;
+}
+
+static void RewindBuffer_decode(RewindBuffer *self, int index, Uint8 *state)
+{
+    // Remonte jusqu'à l'image clé puis applique les différences
+    int key = index - RewindBuffer_getFrame(self, index)->chain;
+    assert(key >= 0);
+
+    memset(state, 0, self->m_stateSize);
+    for (int i = key; i <= index; i++)
+    {
+        RewindFrame *frame = RewindBuffer_getFrame(self, i);
+        RewindBuffer_applyPatch(
+            self->m_data + frame->offset, frame->size, state, self->m_stateSize);
+    }
+}
+
+static bool RewindBuffer_overlaps(RewindBuffer *self, size_t offset, size_t size)
+{
+    if (self->m_count == 0)
+        return false;
+
+    size_t start = RewindBuffer_getFrame(self, 0)->offset;
+    size_t end = offset + size;
+    if (start < self->m_head)
+    {
+        // Données contiguës [start, head)
+        return (offset < self->m_head) && (end > start);
+    }
+    // Données sur deux parties [start, capacité) et [0, head)
+    return (end > start) || (offset < self->m_head);
+}
+
+static void RewindBuffer_dropOldestGroup(RewindBuffer *self)
+{
+    // Supprime l'image clé la plus ancienne et les différences qui en dépendent
+    do
+    {
+        RewindFrame *frame = RewindBuffer_getFrame(self, 0);
+        self->m_byteCount -= frame->size;
+        self->m_first = (self->m_first + 1) % self->m_frameCapacity;
+        self->m_count--;
+    } while (self->m_count > 0 && RewindBuffer_getFrame(self, 0)->chain > 0);
+}
+
+static void RewindBuffer_writeRun(Uint8 **dst, size_t zeros, size_t literals)
+{
+    Uint8 *p = *dst;
+    p[0] = (Uint8)(zeros & 0xFF);
+    p[1] = (Uint8)(zeros >> 8);
+    p[2] = (Uint8)(literals & 0xFF);
+    p[3] = (Uint8)(literals >> 8);
+    *dst = p + 4;
+}
+
+static size_t RewindBuffer_encode(
+    const Uint8 *state, const Uint8 *base, size_t size, Uint8 *dst)
+{
+    // Format : suite de (Uint16 zéros, Uint16 littéraux, octets littéraux).
+    // Les octets encodés sont state XOR base (base nulle pour une image clé).
+    Uint8 *out = dst;
+    size_t i = 0;
+    while (i < size)
+    {
+        size_t zeros = 0;
+        while (i + zeros < size && zeros < REWIND_MAX_RUN &&
+            (state[i + zeros] ^ (base ? base[i + zeros] : 0)) == 0)
+        {
+            zeros++;
+        }
+        i += zeros;
+        if (i >= size)
+            break;
+
+        // Les littéraux s'arrêtent à la prochaine plage de zéros suffisamment longue
+        size_t literals = 0;
+        size_t zeroRun = 0;
+        while (i + literals < size && literals < REWIND_MAX_RUN)
+        {
+            Uint8 x = state[i + literals] ^ (base ? base[i + literals] : 0);
+            zeroRun = (x == 0) ? zeroRun + 1 : 0;
+            literals++;
+            if (zeroRun >= REWIND_MIN_ZERO_RUN)
+            {
+                literals -= zeroRun;
+                break;
+            }
+        }
+        RewindBuffer_writeRun(&out, zeros, literals);
+        for (size_t k = 0; k < literals; k++)
+        {
+            out[k] = state[i + k] ^ (base ? base[i + k] : 0);
+        }
+        out += literals;
+        i += literals;
+    }
+    return (size_t)(out - dst);
+}
+
+static void RewindBuffer_applyPatch(
+    const Uint8 *src, size_t srcSize, Uint8 *state, size_t size)
+{
+    const Uint8 *end = src + srcSize;
+    size_t i = 0;
+    while (src < end)
+    {
+        size_t zeros = (size_t)src[0] | ((size_t)src[1] << 8);
+        size_t literals = (size_t)src[2] | ((size_t)src[3] << 8);
+        src += 4;
+
+        i += zeros;
+        assert(i + literals <= size);
+        for (size_t k = 0; k < literals; k++)
+        {
+            state[i + k] ^= src[k];
+        }
+        src += literals;
+        i += literals;
+    }
+}
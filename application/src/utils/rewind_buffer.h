@@ -0,0 +1,118 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+
+/// @brief Structure décrivant une image enregistrée dans un RewindBuffer.
+typedef struct RewindFrame
+{
+    /// @brief Position des données encodées dans l'anneau (en octets).
+    size_t offset;
+
+    /// @brief Taille des données encodées (en octets).
+    size_t size;
+
+    /// @brief Nombre d'images depuis la dernière image clé
+    /// (0 pour une image clé).
+    int chain;
+} RewindFrame;
+
+/// @brief Structure représentant un historique borné d'états de taille fixe.
+/// Une image clé est enregistrée toutes les N images, les images
+/// intermédiaires sont stockées sous forme de différences (XOR avec l'image
+/// précédente) compressées par plages (RLE).
+/// Lorsque la mémoire est pleine, les images les plus anciennes sont
+/// supprimées par groupe (image clé et différences associées).
+typedef struct RewindBuffer
+{
+    /// @brief Taille d'un état (en octets).
+    size_t m_stateSize;
+
+    /// @brief Nombre d'images entre deux images clés.
+    int m_keyframeInterval;
+
+    /// @brief Anneau contenant les données encodées.
+    Uint8 *m_data;
+    size_t m_capacity;
+
+    /// @brief Position de la prochaine écriture dans l'anneau.
+    size_t m_head;
+
+    /// @brief Nombre d'octets encodés actuellement enregistrés.
+    size_t m_byteCount;
+
+    /// @brief Descripteurs des images (tableau circulaire).
+    RewindFrame *m_frames;
+    int m_frameCapacity;
+    int m_first;
+    int m_count;
+
+    /// @brief Dernier état enregistré, référence de la prochaine différence.
+    Uint8 *m_prev;
+
+    /// @brief Tampon d'encodage.
+    Uint8 *m_scratch;
+
+    /// @brief Statistiques sur les tailles encodées.
+    Uint64 m_keyframeBytes;
+    Uint64 m_keyframeCount;
+    Uint64 m_deltaBytes;
+    Uint64 m_deltaCount;
+} RewindBuffer;
+
+/// @brief Crée un historique d'états.
+/// @param stateSize la taille d'un état (en octets).
+/// @param frameCapacity le nombre maximal d'images conservées.
+/// @param keyframeInterval le nombre d'images entre deux images clés.
+/// @param byteCapacity la mémoire réservée aux données encodées (en octets).
+/// @return L'historique créé.
+RewindBuffer *RewindBuffer_create(
+    size_t stateSize, int frameCapacity, int keyframeInterval, size_t byteCapacity);
+
+/// @brief Détruit un historique d'états.
+/// @param self l'historique.
+void RewindBuffer_destroy(RewindBuffer *self);
+
+/// @brief Supprime toutes les images d'un historique.
+/// @param self l'historique.
+void RewindBuffer_clear(RewindBuffer *self);
+
+/// @brief Ajoute un état à la fin d'un historique.
+/// Les images les plus anciennes sont supprimées si nécessaire.
+/// @param self l'historique.
+/// @param state l'état à enregistrer (m_stateSize octets).
+void RewindBuffer_push(RewindBuffer *self, const void *state);
+
+/// @brief Décode puis supprime le dernier état d'un historique.
+/// @param self l'historique.
+/// @param state l'état décodé (m_stateSize octets).
+/// @return true si un état a été décodé, false si l'historique est vide.
+bool RewindBuffer_pop(RewindBuffer *self, void *state);
+
+/// @brief Affiche la mémoire utilisée par un historique.
+/// @param self l'historique.
+/// @param framesPerSecond le nombre d'images enregistrées par seconde.
+void RewindBuffer_printStats(RewindBuffer *self, float framesPerSecond);
+
+/// @brief Renvoie le nombre d'images enregistrées dans un historique.
+/// @param self l'historique.
+/// @return Le nombre d'images enregistrées.
+INLINE int RewindBuffer_getFrameCount(RewindBuffer *self)
+{
+    assert(self && "The RewindBuffer must be created");
+    return self->m_count;
+}
+
+/// @brief Renvoie la mémoire occupée par les images d'un historique.
+/// @param self l'historique.
+/// @return Le nombre d'octets encodés enregistrés.
+INLINE size_t RewindBuffer_getByteCount(RewindBuffer *self)
+{
+    assert(self && "The RewindBuffer must be created");
+    return self->m_byteCount;
+}
@@ -0,0 +1,159 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "utils/skyline_packer.h"
+
+#include <limits.h>
+
+static int SkylinePacker_fit(SkylinePacker *self, int index, int w, int h);
+static void SkylinePacker_addNode(SkylinePacker *self, int index, int x, int y, int w);
+
+SkylinePacker *SkylinePacker_create(int width, int height)
+{
+    assert(width > 0 && height > 0);
+
+    SkylinePacker *self = (SkylinePacker *)calloc(1, sizeof(SkylinePacker));
+    AssertNew(self);
+
+    self->m_width = width;
+    self->m_height = height;
+    self->m_nodeCapacity = 64;
+    self->m_nodes = (SkylineNode *)calloc(self->m_nodeCapacity, sizeof(SkylineNode));
+    AssertNew(self->m_nodes);
+
+    self->m_nodes[0].x = 0;
+    self->m_nodes[0].y = 0;
+    self->m_nodes[0].w = width;
+    self->m_nodeCount = 1;
+
+    return self;
+}
+
+void SkylinePacker_destroy(SkylinePacker *self)
+{
+    if (!self) return;
+    free(self->m_nodes);
+    free(self);
+}
+
+bool SkylinePacker_insert(SkylinePacker *self, int w, int h, SDL_Point *position)
+{
+    assert(self && "The SkylinePacker must be created");
+    assert(position);
+    if (w <= 0 || h <= 0)
+        return false;
+
+    int bestIndex = -1;
+    int bestBottom = INT_MAX;
+    int bestWidth = INT_MAX;
+
+    for (int i = 0; i < self->m_nodeCount; i++)
+    {
+        int y = SkylinePacker_fit(self, i, w, h);
+        if (y < 0)
+            continue;
+
+        int bottom = y + h;
+        int nodeWidth = self->m_nodes[i].w;
+        if (bottom < bestBottom || (bottom == bestBottom && nodeWidth < bestWidth))
+        {
+            bestIndex = i;
+            bestBottom = bottom;
+            bestWidth = nodeWidth;
+        }
+    }
+
+    if (bestIndex < 0)
+        return false;
+
+    position->x = self->m_nodes[bestIndex].x;
+    position->y = bestBottom - h;
+
+    // Le nouveau segment recouvre le haut du rectangle
+    SkylinePacker_addNode(self, bestIndex, position->x, bestBottom, w);
+
+    // Raccourcit ou supprime les segments suivants recouverts
+    int i = bestIndex + 1;
+    while (i < self->m_nodeCount)
+    {
+        SkylineNode *prev = self->m_nodes + i - 1;
+        SkylineNode *node = self->m_nodes + i;
+        int prevEnd = prev->x + prev->w;
+        if (node->x >= prevEnd)
+            break;
+
+        int shrink = prevEnd - node->x;
+        node->x += shrink;
+        node->w -= shrink;
+        if (node->w > 0)
+            break;
+
+        memmove(node, node + 1, (self->m_nodeCount - i - 1) * sizeof(SkylineNode));
+        self->m_nodeCount--;
+    }
+
+    // Fusionne les segments consécutifs de même hauteur
+    for (i = 0; i < self->m_nodeCount - 1; i++)
+    {
+        SkylineNode *node = self->m_nodes + i;
+        if (node->y == node[1].y)
+        {
+            node->w += node[1].w;
+            memmove(node + 1, node + 2, (self->m_nodeCount - i - 2) * sizeof(SkylineNode));
+            self->m_nodeCount--;
+            i--;
+        }
+    }
+
+    self->m_usedArea += w * h;
+    return true;
+}
+
+/// @brief Cherche l'ordonnée à laquelle un rectangle peut être posé en
+/// commençant sur le segment d'indice index.
+/// @return L'ordonnée du haut du rectangle, ou -1 s'il ne tient pas.
+static int SkylinePacker_fit(SkylinePacker *self, int index, int w, int h)
+{
+    int x = self->m_nodes[index].x;
+    if (x + w > self->m_width)
+        return -1;
+
+    int y = 0;
+    int remaining = w;
+    while (remaining > 0)
+    {
+        if (index >= self->m_nodeCount)
+            return -1;
+
+        const SkylineNode *node = self->m_nodes + index;
+        if (node->y > y) y = node->y;
+        if (y + h > self->m_height)
+            return -1;
+
+        remaining -= node->w;
+        index++;
+    }
+    return y;
+}
+
+static void SkylinePacker_addNode(SkylinePacker *self, int index, int x, int y, int w)
+{
+    if (self->m_nodeCount >= self->m_nodeCapacity)
+    {
+        int capacity = 2 * self->m_nodeCapacity;
+        SkylineNode *nodes = (SkylineNode *)realloc(self->m_nodes, capacity * sizeof(SkylineNode));
+        AssertNew(nodes);
+        self->m_nodes = nodes;
+        self->m_nodeCapacity = capacity;
+    }
+
+    SkylineNode *node = self->m_nodes + index;
+    memmove(node + 1, node, (self->m_nodeCount - index) * sizeof(SkylineNode));
+    node->x = x;
+    node->y = y;
+    node->w = w;
+    self->m_nodeCount++;
+}
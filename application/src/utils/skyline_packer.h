@@ -0,0 +1,61 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+
+/// @brief Segment horizontal de la ligne d'horizon d'un SkylinePacker.
+typedef struct SkylineNode
+{
+    int x, y, w;
+} SkylineNode;
+
+/// @brief Structure représentant un algorithme de placement de rectangles
+/// dans une zone de dimensions fixées (méthode "skyline", bottom-left).
+/// La zone occupée est décrite par une ligne d'horizon : une suite de
+/// segments horizontaux sous lesquels toute la place est considérée prise.
+typedef struct SkylinePacker
+{
+    int m_width;
+    int m_height;
+
+    SkylineNode *m_nodes;
+    int m_nodeCount;
+    int m_nodeCapacity;
+
+    /// @brief Aire totale des rectangles placés (en pixels).
+    int m_usedArea;
+} SkylinePacker;
+
+/// @brief Crée un algorithme de placement pour une zone vide.
+/// @param width la largeur de la zone.
+/// @param height la hauteur de la zone.
+/// @return L'algorithme de placement créé.
+SkylinePacker *SkylinePacker_create(int width, int height);
+
+/// @brief Détruit un algorithme de placement.
+/// @param self l'algorithme de placement.
+void SkylinePacker_destroy(SkylinePacker *self);
+
+/// @brief Place un rectangle dans la zone.
+/// La position choisie minimise l'ordonnée du bas du rectangle
+/// puis la largeur du segment sur lequel il repose.
+/// @param self l'algorithme de placement.
+/// @param w la largeur du rectangle.
+/// @param h la hauteur du rectangle.
+/// @param position la position du coin supérieur gauche du rectangle placé.
+/// @return true si le rectangle a pu être placé, false sinon.
+bool SkylinePacker_insert(SkylinePacker *self, int w, int h, SDL_Point *position);
+
+/// @brief Renvoie le taux de remplissage de la zone.
+/// @param self l'algorithme de placement.
+/// @return Le taux de remplissage, entre 0 et 1.
+INLINE float SkylinePacker_getOccupancy(SkylinePacker *self)
+{
+    assert(self && "The SkylinePacker must be created");
+    return (float)self->m_usedArea / (float)(self->m_width * self->m_height);
+}
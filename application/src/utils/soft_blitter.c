@@ -0,0 +1,501 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "utils/soft_blitter.h"
+#include "utils/common.h"
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+#  define SOFT_BLITTER_SIMD 1
+#else
+#  define SOFT_BLITTER_SIMD 0
+#endif
+
+/// @brief Position de l'octet alpha d'un pixel SDL_PIXELFORMAT_ARGB8888
+/// en mémoire.
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#  define SOFT_BLITTER_ALPHA_BYTE 3
+#else
+#  define SOFT_BLITTER_ALPHA_BYTE 0
+#endif
+
+static void SoftBlitter_blendRow(
+    SoftBlitter *self, Uint32 *dst, const Uint32 *src, int count,
+    Uint32 mod, bool modulate);
+
+/// @brief Calcule x * y / 255 arrondi, pour x et y entre 0 et 255.
+INLINE Uint32 SoftBlitter_mul255(Uint32 x, Uint32 y)
+{
+    Uint32 t = x * y + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+/// @brief Mélange un pixel source prémultiplié sur un pixel de destination.
+static Uint32 SoftBlitter_blendPixel(Uint32 src, Uint32 dst, Uint32 mod, bool modulate)
+{
+    if (modulate)
+    {
+        Uint32 modulated = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            modulated |= SoftBlitter_mul255((src >> shift) & 0xFF, (mod >> shift) & 0xFF) << shift;
+        }
+        src = modulated;
+    }
+
+    Uint32 inv = 255 - (src >> 24);
+    Uint32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        Uint32 c = ((src >> shift) & 0xFF) + SoftBlitter_mul255((dst >> shift) & 0xFF, inv);
+        out |= SDL_min(c, 255u) << shift;
+    }
+    return out;
+}
+
+SoftImage *SoftImage_createFromSurface(SDL_Surface *surface)
+{
+    assert(surface);
+
+    SDL_Surface *converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (converted == NULL)
+    {
+        printf("ERROR - Convert soft image %s\n", SDL_GetError());
+        return NULL;
+    }
+
+    SoftImage *self = (SoftImage *)calloc(1, sizeof(SoftImage));
+    AssertNew(self);
+
+    self->m_w = converted->w;
+    self->m_h = converted->h;
+    self->m_pitch = converted->w;
+    self->m_pixels = (Uint32 *)SDL_SIMDAlloc((size_t)self->m_w * self->m_h * sizeof(Uint32));
+    AssertNew(self->m_pixels);
+
+    // Prémultiplie les couleurs par l'alpha une seule fois, au chargement
+    SDL_LockSurface(converted);
+    for (int y = 0; y < self->m_h; y++)
+    {
+        const Uint32 *srcRow = (const Uint32 *)((const Uint8 *)converted->pixels + y * converted->pitch);
+        Uint32 *dstRow = self->m_pixels + y * self->m_pitch;
+        for (int x = 0; x < self->m_w; x++)
+        {
+            Uint32 pixel = srcRow[x];
+            Uint32 a = pixel >> 24;
+            Uint32 r = SoftBlitter_mul255((pixel >> 16) & 0xFF, a);
+            Uint32 g = SoftBlitter_mul255((pixel >> 8) & 0xFF, a);
+            Uint32 b = SoftBlitter_mul255(pixel & 0xFF, a);
+            dstRow[x] = (a << 24) | (r << 16) | (g << 8) | b;
+        }
+    }
+    SDL_UnlockSurface(converted);
+    SDL_FreeSurface(converted);
+
+    return self;
+}
+
+void SoftImage_destroy(SoftImage *self)
+{
+    if (!self) return;
+    SDL_SIMDFree(self->m_pixels);
+    free(self);
+}
+
+SoftBlitter *SoftBlitter_create(SDL_Renderer *renderer, int w, int h)
+{
+    assert(renderer && "The SDL_Renderer must be created");
+    assert(w > 0 && h > 0);
+
+    SoftBlitter *self = (SoftBlitter *)calloc(1, sizeof(SoftBlitter));
+    AssertNew(self);
+
+    self->m_renderer = renderer;
+    self->m_useSIMD = SOFT_BLITTER_SIMD;
+
+    self->m_framebuffer = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+    self->m_texture = SDL_CreateTexture(
+        renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, w, h);
+    self->m_captureTexture = SDL_CreateTexture(
+        renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, w, h);
+    if (self->m_framebuffer == NULL || self->m_texture == NULL ||
+        self->m_captureTexture == NULL)
+    {
+        printf("ERROR - Create soft blitter %s\n", SDL_GetError());
+        SoftBlitter_destroy(self);
+        return NULL;
+    }
+    SDL_SetTextureBlendMode(self->m_texture, SDL_BLENDMODE_NONE);
+
+    self->m_row = (Uint32 *)SDL_SIMDAlloc((size_t)w * sizeof(Uint32));
+    AssertNew(self->m_row);
+
+    self->m_captureImage.m_w = w;
+    self->m_captureImage.m_h = h;
+    self->m_captureImage.m_pitch = w;
+    self->m_captureImage.m_pixels = (Uint32 *)SDL_SIMDAlloc((size_t)w * h * sizeof(Uint32));
+    AssertNew(self->m_captureImage.m_pixels);
+
+    return self;
+}
+
+void SoftBlitter_destroy(SoftBlitter *self)
+{
+    if (!self) return;
+    SDL_SIMDFree(self->m_row);
+    SDL_SIMDFree(self->m_captureImage.m_pixels);
+    if (self->m_captureTexture) SDL_DestroyTexture(self->m_captureTexture);
+    if (self->m_texture) SDL_DestroyTexture(self->m_texture);
+    if (self->m_framebuffer) SDL_FreeSurface(self->m_framebuffer);
+    free(self);
+}
+
+void SoftBlitter_setSIMD(SoftBlitter *self, bool useSIMD)
+{
+    assert(self && "The SoftBlitter must be created");
+    self->m_useSIMD = useSIMD && SOFT_BLITTER_SIMD;
+}
+
+void SoftBlitter_clear(SoftBlitter *self, SDL_Color color)
+{
+    assert(self && "The SoftBlitter must be created");
+    SDL_Surface *framebuffer = self->m_framebuffer;
+    SDL_FillRect(framebuffer, NULL, SDL_MapRGBA(framebuffer->format, color.r, color.g, color.b, 255));
+}
+
+void SoftBlitter_copy(
+    SoftBlitter *self, SoftImage *image,
+    const SDL_Rect *srcRect, const SDL_FRect *dstRect,
+    double angle, SDL_RendererFlip flip, SDL_Color color)
+{
+    assert(self && "The SoftBlitter must be created");
+    assert(image && dstRect);
+
+    SDL_Rect src = { 0, 0, image->m_w, image->m_h };
+    if (srcRect) src = *srcRect;
+    assert(src.x >= 0 && src.y >= 0);
+    assert(src.x + src.w <= image->m_w && src.y + src.h <= image->m_h);
+    if (src.w <= 0 || src.h <= 0 || color.a == 0)
+        return;
+
+    // Seuls les quarts de tour sont copiés, les autres angles sont dessinés
+    // par la SDL pendant une capture
+    if (SoftBlitter_isQuarterTurn(angle) == false)
+    {
+        assert(false && "The angle must be a multiple of 90 degrees");
+        return;
+    }
+    int quarter = (int)floor(angle / 90.0 + 0.5);
+    quarter = ((quarter % 4) + 4) % 4;
+
+    // Rectangle occupé par la copie tournée autour du centre de dstRect
+    float w = dstRect->w, h = dstRect->h;
+    float cx = dstRect->x + 0.5f * w;
+    float cy = dstRect->y + 0.5f * h;
+    if (quarter & 1)
+    {
+        float tmp = w; w = h; h = tmp;
+    }
+    int x0 = (int)lroundf(cx - 0.5f * w);
+    int y0 = (int)lroundf(cy - 0.5f * h);
+    int x1 = (int)lroundf(cx + 0.5f * w);
+    int y1 = (int)lroundf(cy + 0.5f * h);
+    int dw = x1 - x0, dh = y1 - y0;
+    if (dw <= 0 || dh <= 0)
+        return;
+
+    SDL_Surface *framebuffer = self->m_framebuffer;
+    int cx0 = SDL_max(x0, 0), cy0 = SDL_max(y0, 0);
+    int cx1 = SDL_min(x1, framebuffer->w), cy1 = SDL_min(y1, framebuffer->h);
+    if (cx0 >= cx1 || cy0 >= cy1)
+        return;
+
+    // Coordonnées normalisées de l'image source (a, b) en fonction de celles
+    // de la destination (s, t) : a = a0 + as * s + at * t, idem pour b
+    static const int coeffs[4][6] = {
+        // a0, as, at, b0, bs, bt
+        { 0,  1,  0, 0,  0,  1 },
+        { 0,  0,  1, 1, -1,  0 },
+        { 1, -1,  0, 1,  0, -1 },
+        { 1,  0, -1, 0,  1,  0 },
+    };
+    int a0 = coeffs[quarter][0], as = coeffs[quarter][1], at = coeffs[quarter][2];
+    int b0 = coeffs[quarter][3], bs = coeffs[quarter][4], bt = coeffs[quarter][5];
+    if (flip & SDL_FLIP_HORIZONTAL)
+    {
+        a0 = 1 - a0; as = -as; at = -at;
+    }
+    if (flip & SDL_FLIP_VERTICAL)
+    {
+        b0 = 1 - b0; bs = -bs; bt = -bt;
+    }
+
+    // Pas en virgule fixe 16.16, échantillonnage au centre des pixels
+    double sw = (double)src.w, sh = (double)src.h;
+    Sint32 dudx = (Sint32)lround(65536.0 * sw * as / dw);
+    Sint32 dudy = (Sint32)lround(65536.0 * sw * at / dh);
+    Sint32 dvdx = (Sint32)lround(65536.0 * sh * bs / dw);
+    Sint32 dvdy = (Sint32)lround(65536.0 * sh * bt / dh);
+    double s0 = (cx0 - x0 + 0.5) / dw, t0 = (cy0 - y0 + 0.5) / dh;
+    Sint32 u = (Sint32)floor(65536.0 * (src.x + sw * (a0 + as * s0 + at * t0)));
+    Sint32 v = (Sint32)floor(65536.0 * (src.y + sh * (b0 + bs * s0 + bt * t0)));
+
+    // Modulation appliquée aux couleurs prémultipliées
+    bool modulate = (color.r & color.g & color.b & color.a) != 255;
+    Uint32 mod =
+        ((Uint32)color.a << 24) |
+        (SoftBlitter_mul255(color.r, color.a) << 16) |
+        (SoftBlitter_mul255(color.g, color.a) << 8) |
+        SoftBlitter_mul255(color.b, color.a);
+
+    int fbPitch = framebuffer->pitch / (int)sizeof(Uint32);
+    Uint32 *fbPixels = (Uint32 *)framebuffer->pixels;
+    int count = cx1 - cx0;
+    bool direct = (dudx == 65536 && dvdx == 0);
+    int uMin = src.x, uMax = src.x + src.w - 1;
+    int vMin = src.y, vMax = src.y + src.h - 1;
+
+    for (int y = cy0; y < cy1; y++)
+    {
+        const Uint32 *srcRow = self->m_row;
+        if (direct)
+        {
+            // Copie pixel à pixel, la ligne source est lue directement
+            int sx = SDL_clamp(u >> 16, uMin, uMax - count + 1);
+            int sy = SDL_clamp(v >> 16, vMin, vMax);
+            srcRow = image->m_pixels + sy * image->m_pitch + sx;
+        }
+        else
+        {
+            // Rassemble les pixels sources (agrandissement, quarts de tour)
+            Sint32 ui = u, vi = v;
+            for (int i = 0; i < count; i++)
+            {
+                int sx = SDL_clamp(ui >> 16, uMin, uMax);
+                int sy = SDL_clamp(vi >> 16, vMin, vMax);
+                self->m_row[i] = image->m_pixels[sy * image->m_pitch + sx];
+                ui += dudx;
+                vi += dvdx;
+            }
+        }
+        SoftBlitter_blendRow(self, fbPixels + y * fbPitch + cx0, srcRow, count, mod, modulate);
+        u += dudy;
+        v += dvdy;
+    }
+
+    self->m_blitCount++;
+    self->m_pixelCount += (Uint64)count * (Uint64)(cy1 - cy0);
+}
+
+bool SoftBlitter_beginCapture(SoftBlitter *self, int w, int h)
+{
+    assert(self && "The SoftBlitter must be created");
+    assert(self->m_captureW == 0 && "A capture is already in progress");
+    assert(w <= self->m_framebuffer->w && h <= self->m_framebuffer->h);
+    if (w <= 0 || h <= 0)
+        return false;
+
+    // Les cibles de type texture perdent leur échelle et leur viewport
+    // lorsqu'elles sont quittées : ils sont rétablis à la fin de la capture
+    SDL_Renderer *renderer = self->m_renderer;
+    self->m_prevTarget = SDL_GetRenderTarget(renderer);
+    SDL_RenderGetScale(renderer, &self->m_prevScaleX, &self->m_prevScaleY);
+    SDL_RenderGetViewport(renderer, &self->m_prevViewport);
+    if (SDL_SetRenderTarget(renderer, self->m_captureTexture) < 0)
+    {
+        printf("ERROR - Soft blitter capture %s\n", SDL_GetError());
+        return false;
+    }
+
+    // Zone transparente : les dessins mélangés y donnent directement
+    // des couleurs prémultipliées
+    SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+    SDL_GetRenderDrawBlendMode(renderer, &blendMode);
+    SDL_Rect rect = { 0, 0, w, h };
+    RenderState_setDrawBlendMode(g_renderState, SDL_BLENDMODE_NONE);
+    RenderState_setDrawColor(g_renderState, 0, 0, 0, 0);
+    SDL_RenderFillRect(renderer, &rect);
+    RenderState_setDrawBlendMode(g_renderState, blendMode);
+
+    self->m_captureW = w;
+    self->m_captureH = h;
+    return true;
+}
+
+void SoftBlitter_endCapture(SoftBlitter *self, int x, int y, bool replace)
+{
+    assert(self && "The SoftBlitter must be created");
+    assert(self->m_captureW > 0 && "No capture in progress");
+
+    SDL_Renderer *renderer = self->m_renderer;
+    SDL_Surface *framebuffer = self->m_framebuffer;
+    SDL_Rect rect = { 0, 0, self->m_captureW, self->m_captureH };
+    assert(x >= 0 && y >= 0);
+    assert(x + rect.w <= framebuffer->w && y + rect.h <= framebuffer->h);
+
+    if (replace)
+    {
+        Uint8 *dst = (Uint8 *)framebuffer->pixels + y * framebuffer->pitch + x * sizeof(Uint32);
+        SDL_RenderReadPixels(renderer, &rect, SDL_PIXELFORMAT_ARGB8888, dst, framebuffer->pitch);
+    }
+    else
+    {
+        SoftImage *image = &(self->m_captureImage);
+        SDL_RenderReadPixels(
+            renderer, &rect, SDL_PIXELFORMAT_ARGB8888,
+            image->m_pixels, image->m_pitch * (int)sizeof(Uint32)
+        );
+        SDL_FRect dstRect = { (float)x, (float)y, (float)rect.w, (float)rect.h };
+        SDL_Color white = { 255, 255, 255, 255 };
+        SoftBlitter_copy(self, image, &rect, &dstRect, 0.0, SDL_FLIP_NONE, white);
+    }
+
+    SDL_SetRenderTarget(renderer, self->m_prevTarget);
+    if (self->m_prevTarget)
+    {
+        SDL_RenderSetScale(renderer, self->m_prevScaleX, self->m_prevScaleY);
+        SDL_RenderSetViewport(renderer, &self->m_prevViewport);
+    }
+
+    self->m_captureW = 0;
+    self->m_captureH = 0;
+    self->m_captureCount++;
+}
+
+void SoftBlitter_upload(SoftBlitter *self)
+{
+    assert(self && "The SoftBlitter must be created");
+    SDL_Surface *framebuffer = self->m_framebuffer;
+    SDL_UpdateTexture(self->m_texture, NULL, framebuffer->pixels, framebuffer->pitch);
+    SDL_RenderCopy(self->m_renderer, self->m_texture, NULL, NULL);
+}
+
+void SoftBlitter_present(SoftBlitter *self)
+{
+    assert(self && "The SoftBlitter must be created");
+    SoftBlitter_upload(self);
+    SDL_RenderPresent(self->m_renderer);
+    RenderState_endFrame(g_renderState);
+}
+
+#if defined(__SSE2__)
+
+/// @brief Calcule x * y / 255 arrondi sur 8 composantes de 16 bits.
+INLINE __m128i SoftBlitter_mul255SSE2(__m128i x, __m128i y)
+{
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(x, y), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+static int SoftBlitter_blendRowSSE2(
+    Uint32 *dst, const Uint32 *src, int count, Uint32 mod, bool modulate)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(255);
+    const __m128i alphaMask = _mm_set1_epi32((int)0xFF000000);
+    const __m128i modv = _mm_unpacklo_epi8(_mm_set1_epi32((int)mod), zero);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+
+        // Pixels entièrement transparents : rien à faire
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(s, zero)) == 0xFFFF)
+            continue;
+
+        // Pixels opaques sans modulation : simple copie
+        if (modulate == false &&
+            _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(s, alphaMask), alphaMask)) == 0xFFFF)
+        {
+            _mm_storeu_si128((__m128i *)(dst + i), s);
+            continue;
+        }
+
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        __m128i sLo = _mm_unpacklo_epi8(s, zero);
+        __m128i sHi = _mm_unpackhi_epi8(s, zero);
+        if (modulate)
+        {
+            sLo = SoftBlitter_mul255SSE2(sLo, modv);
+            sHi = SoftBlitter_mul255SSE2(sHi, modv);
+        }
+
+        // Alpha de chaque pixel répété sur ses quatre composantes
+        __m128i aLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sLo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i aHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sHi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+        __m128i dLo = SoftBlitter_mul255SSE2(_mm_unpacklo_epi8(d, zero), _mm_sub_epi16(full, aLo));
+        __m128i dHi = SoftBlitter_mul255SSE2(_mm_unpackhi_epi8(d, zero), _mm_sub_epi16(full, aHi));
+
+        __m128i out = _mm_packus_epi16(_mm_add_epi16(sLo, dLo), _mm_add_epi16(sHi, dHi));
+        _mm_storeu_si128((__m128i *)(dst + i), out);
+    }
+    return i;
+}
+
+#elif defined(__ARM_NEON)
+
+/// @brief Calcule x * y / 255 arrondi sur 8 composantes de 8 bits.
+INLINE uint8x8_t SoftBlitter_mul255NEON(uint8x8_t x, uint8x8_t y)
+{
+    uint16x8_t t = vmull_u8(x, y);
+    return vrshrn_n_u16(vrsraq_n_u16(t, t, 8), 8);
+}
+
+static int SoftBlitter_blendRowNEON(
+    Uint32 *dst, const Uint32 *src, int count, Uint32 mod, bool modulate)
+{
+    const uint8x8_t full = vdup_n_u8(255);
+    const uint8x8_t modv = vreinterpret_u8_u32(vdup_n_u32(mod));
+    const uint8x8_t alphaIndex = {
+        SOFT_BLITTER_ALPHA_BYTE, SOFT_BLITTER_ALPHA_BYTE,
+        SOFT_BLITTER_ALPHA_BYTE, SOFT_BLITTER_ALPHA_BYTE,
+        SOFT_BLITTER_ALPHA_BYTE + 4, SOFT_BLITTER_ALPHA_BYTE + 4,
+        SOFT_BLITTER_ALPHA_BYTE + 4, SOFT_BLITTER_ALPHA_BYTE + 4
+    };
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        uint8x16_t s = vld1q_u8((const uint8_t *)(src + i));
+        uint8x16_t d = vld1q_u8((const uint8_t *)(dst + i));
+        uint8x8_t sLo = vget_low_u8(s);
+        uint8x8_t sHi = vget_high_u8(s);
+        if (modulate)
+        {
+            sLo = SoftBlitter_mul255NEON(sLo, modv);
+            sHi = SoftBlitter_mul255NEON(sHi, modv);
+        }
+
+        uint8x8_t invLo = vsub_u8(full, vtbl1_u8(sLo, alphaIndex));
+        uint8x8_t invHi = vsub_u8(full, vtbl1_u8(sHi, alphaIndex));
+        uint8x8_t outLo = vqadd_u8(sLo, SoftBlitter_mul255NEON(vget_low_u8(d), invLo));
+        uint8x8_t outHi = vqadd_u8(sHi, SoftBlitter_mul255NEON(vget_high_u8(d), invHi));
+        vst1q_u8((uint8_t *)(dst + i), vcombine_u8(outLo, outHi));
+    }
+    return i;
+}
+
+#endif
+
+static void SoftBlitter_blendRow(
+    SoftBlitter *self, Uint32 *dst, const Uint32 *src, int count,
+    Uint32 mod, bool modulate)
+{
+    int i = 0;
+    if (self->m_useSIMD)
+    {
+#if defined(__SSE2__)
+        i = SoftBlitter_blendRowSSE2(dst, src, count, mod, modulate);
+#elif defined(__ARM_NEON)
+        i = SoftBlitter_blendRowNEON(dst, src, count, mod, modulate);
+#endif
+    }
+    for (; i < count; i++)
+    {
+        dst[i] = SoftBlitter_blendPixel(src[i], dst[i], mod, modulate);
+    }
+}
@@ -0,0 +1,160 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+
+/// @brief Structure représentant une image en mémoire centrale utilisée par
+/// le SoftBlitter. Les pixels sont au format SDL_PIXELFORMAT_ARGB8888 avec
+/// un alpha prémultiplié.
+typedef struct SoftImage
+{
+    Uint32 *m_pixels;
+
+    /// @brief Dimensions de l'image (en pixels).
+    int m_w, m_h;
+
+    /// @brief Nombre de pixels entre deux lignes consécutives.
+    int m_pitch;
+} SoftImage;
+
+/// @brief Crée une image du SoftBlitter à partir d'une surface.
+/// La surface est convertie et ses couleurs sont prémultipliées par l'alpha.
+/// @param surface la surface source, elle n'est pas modifiée.
+/// @return L'image créée.
+SoftImage *SoftImage_createFromSurface(SDL_Surface *surface);
+
+/// @brief Détruit une image du SoftBlitter.
+/// @param self l'image.
+void SoftImage_destroy(SoftImage *self);
+
+/// @brief Structure représentant un moteur de rendu 2D logiciel.
+/// Les sprites sont copiés dans une surface en mémoire centrale (mélange
+/// alpha, modulation de couleur, mise à l'échelle au plus proche voisin et
+/// quarts de tour), vectorisés avec SSE2 ou NEON.
+/// Ce qui ne peut pas être copié (angles quelconques, textures sans copie
+/// en mémoire centrale) est dessiné par la SDL dans une cible de capture
+/// puis relu, à sa place dans l'ordre de dessin.
+/// Chaque image se termine par un unique SDL_UpdateTexture() suivi de la
+/// présentation.
+typedef struct SoftBlitter
+{
+    SDL_Renderer *m_renderer;
+
+    /// @brief Image en cours de construction (SDL_PIXELFORMAT_ARGB8888).
+    SDL_Surface *m_framebuffer;
+
+    /// @brief Texture de diffusion recevant m_framebuffer à chaque image.
+    SDL_Texture *m_texture;
+
+    /// @brief Ligne de pixels sources rassemblés avant le mélange, lorsque
+    /// la copie est agrandie, tournée ou retournée.
+    Uint32 *m_row;
+
+    /// @brief Booléen indiquant si les chemins vectorisés sont utilisés.
+    bool m_useSIMD;
+
+    /// @brief Cible de rendu recevant les dessins de la SDL pendant une
+    /// capture, de la taille de m_framebuffer.
+    SDL_Texture *m_captureTexture;
+
+    /// @brief Pixels de la capture relus avant leur mélange dans l'image.
+    SoftImage m_captureImage;
+
+    /// @brief Dimensions de la capture en cours (nulles hors capture).
+    int m_captureW, m_captureH;
+
+    /// @brief Cible, échelle et viewport du moteur de rendu SDL à rétablir
+    /// à la fin de la capture.
+    SDL_Texture *m_prevTarget;
+    float m_prevScaleX, m_prevScaleY;
+    SDL_Rect m_prevViewport;
+
+    /// @brief Nombre de copies, de pixels écrits et de captures depuis la
+    /// création.
+    Uint64 m_blitCount;
+    Uint64 m_pixelCount;
+    Uint64 m_captureCount;
+} SoftBlitter;
+
+/// @brief Crée un moteur de rendu logiciel.
+/// @param renderer le moteur de rendu SDL utilisé pour la présentation.
+/// @param w la largeur de l'image (en pixels).
+/// @param h la hauteur de l'image (en pixels).
+/// @return Le moteur créé ou NULL en cas d'erreur.
+SoftBlitter *SoftBlitter_create(SDL_Renderer *renderer, int w, int h);
+
+/// @brief Détruit un moteur de rendu logiciel.
+/// @param self le moteur.
+void SoftBlitter_destroy(SoftBlitter *self);
+
+/// @brief Active ou désactive les chemins vectorisés.
+/// Sans support SIMD à la compilation, le chemin scalaire est toujours utilisé.
+/// @param self le moteur.
+/// @param useSIMD true pour utiliser SSE2 ou NEON.
+void SoftBlitter_setSIMD(SoftBlitter *self, bool useSIMD);
+
+/// @brief Remplit l'image avec une couleur opaque.
+/// @param self le moteur.
+/// @param color la couleur.
+void SoftBlitter_clear(SoftBlitter *self, SDL_Color color);
+
+/// @brief Indique si un angle est un multiple de 90 degrés, seuls angles
+/// acceptés par SoftBlitter_copy().
+/// @param angle l'angle, en degrés.
+/// @return true si l'angle est un quart de tour exact, false sinon.
+INLINE bool SoftBlitter_isQuarterTurn(double angle)
+{
+    double turns = angle / 90.0;
+    return fabs(turns - floor(turns + 0.5)) <= 1e-6;
+}
+
+/// @brief Copie une partie d'une image avec mélange alpha.
+/// Les paramètres sont ceux de SDL_RenderCopyExF() ; l'angle doit être un
+/// multiple de 90 degrés (voir SoftBlitter_isQuarterTurn()) et la rotation
+/// se fait autour du centre de dstRect. Les autres angles passent par
+/// SoftBlitter_beginCapture().
+/// @param self le moteur.
+/// @param image l'image source.
+/// @param srcRect le rectangle source, ou NULL pour toute l'image.
+/// @param dstRect le rectangle de destination.
+/// @param angle l'angle de rotation, en degrés (sens horaire).
+/// @param flip flag indiquant quels retournements sont appliqués à la copie.
+/// @param color la couleur de modulation (l'alpha module l'opacité).
+void SoftBlitter_copy(
+    SoftBlitter *self, SoftImage *image,
+    const SDL_Rect *srcRect, const SDL_FRect *dstRect,
+    double angle, SDL_RendererFlip flip, SDL_Color color);
+
+/// @brief Redirige le moteur de rendu SDL vers la cible de capture.
+/// La zone (0, 0, w, h) de la cible est rendue transparente ; les dessins
+/// qui y sont faits avec SDL_BLENDMODE_BLEND donnent des couleurs
+/// prémultipliées, relues par SoftBlitter_endCapture().
+/// @param self le moteur.
+/// @param w la largeur de la zone capturée (en pixels).
+/// @param h la hauteur de la zone capturée (en pixels).
+/// @return true si la capture a commencé, false sinon.
+bool SoftBlitter_beginCapture(SoftBlitter *self, int w, int h);
+
+/// @brief Termine une capture : la zone capturée est relue puis mélangée
+/// à l'image (ou la remplace), et la cible précédente du moteur de rendu
+/// SDL est rétablie.
+/// @param self le moteur.
+/// @param x l'abscisse de la zone dans l'image.
+/// @param y l'ordonnée de la zone dans l'image.
+/// @param replace true pour remplacer les pixels de l'image, false pour
+///     les mélanger avec l'alpha.
+void SoftBlitter_endCapture(SoftBlitter *self, int x, int y, bool replace);
+
+/// @brief Envoie l'image au moteur de rendu SDL (un seul SDL_UpdateTexture())
+/// et la copie sur sa cible, sans la présenter.
+/// @param self le moteur.
+void SoftBlitter_upload(SoftBlitter *self);
+
+/// @brief Envoie l'image au moteur de rendu SDL puis la présente.
+/// @param self le moteur.
+void SoftBlitter_present(SoftBlitter *self);
@@ -0,0 +1,390 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "utils/sprite_batch.h"
+#include "utils/common.h"
+#include "utils/math.h"
+
+static void SpriteBatch_setTexture(SpriteBatch *self, SDL_Texture *texture);
+static void SpriteBatch_copyPending(SpriteBatch *self);
+static void SpriteBatch_drawCaptured(
+    SpriteBatch *self, SDL_Texture *texture,
+    const SDL_Rect *srcRect, const SDL_FRect *dstRect,
+    double angle, SDL_RendererFlip flip, SDL_Color color);
+
+SpriteBatch *SpriteBatch_create(SDL_Renderer *renderer)
+{
+    assert(renderer);
+
+    SpriteBatch *self = (SpriteBatch *)calloc(1, sizeof(SpriteBatch));
+    AssertNew(self);
+
+    self->m_renderer = renderer;
+
+    self->m_vertices = (SDL_Vertex *)calloc(4 * SPRITE_BATCH_CAPACITY, sizeof(SDL_Vertex));
+    AssertNew(self->m_vertices);
+
+    self->m_indices = (int *)calloc(6 * SPRITE_BATCH_CAPACITY, sizeof(int));
+    AssertNew(self->m_indices);
+
+    self->m_copies = (SpriteBatchCopy *)calloc(SPRITE_BATCH_CAPACITY, sizeof(SpriteBatchCopy));
+    AssertNew(self->m_copies);
+
+    for (int i = 0; i < SPRITE_BATCH_CAPACITY; i++)
+    {
+        int *indices = self->m_indices + 6 * i;
+        int first = 4 * i;
+        indices[0] = first + 0;
+        indices[1] = first + 1;
+        indices[2] = first + 2;
+        indices[3] = first + 2;
+        indices[4] = first + 3;
+        indices[5] = first + 0;
+    }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    SDL_version version;
+    SDL_GetVersion(&version);
+    self->m_useGeometry =
+        SDL_VERSIONNUM(version.major, version.minor, version.patch) >=
+        SDL_VERSIONNUM(2, 0, 18);
+#else
+    self->m_useGeometry = false;
+#endif
+    if (self->m_useGeometry == false)
+    {
+        printf("WARNING - SDL_RenderGeometry() is not available, sprites are not batched\n");
+    }
+
+    return self;
+}
+
+void SpriteBatch_destroy(SpriteBatch *self)
+{
+    if (!self) return;
+    free(self->m_vertices);
+    free(self->m_indices);
+    free(self->m_copies);
+    free(self);
+}
+
+void SpriteBatch_begin(SpriteBatch *self)
+{
+    assert(self && "The SpriteBatch must be created");
+    self->m_spriteCount = 0;
+    self->m_texture = NULL;
+    self->m_frameSpriteCount = 0;
+    self->m_frameDrawCallCount = 0;
+}
+
+void SpriteBatch_setSoftBlitter(SpriteBatch *self, SoftBlitter *blitter)
+{
+    assert(self && "The SpriteBatch must be created");
+    SpriteBatch_flush(self);
+    self->m_blitter = blitter;
+}
+
+void SpriteBatch_draw(
+    SpriteBatch *self, SDL_Texture *texture,
+    const SDL_Rect *srcRect, const SDL_FRect *dstRect,
+    double angle, const SDL_FPoint *center, SDL_RendererFlip flip,
+    SDL_Color color)
+{
+    assert(self && "The SpriteBatch must be created");
+    assert(texture && dstRect);
+
+    self->m_frameSpriteCount++;
+
+    if (self->m_useGeometry == false)
+    {
+        Uint8 r = 255, g = 255, b = 255, a = 255;
+        SDL_GetTextureColorMod(texture, &r, &g, &b);
+        SDL_GetTextureAlphaMod(texture, &a);
+        RenderState_setTextureColorMod(g_renderState, texture, color.r, color.g, color.b);
+        RenderState_setTextureAlphaMod(g_renderState, texture, color.a);
+        if (angle == 0.0 && flip == SDL_FLIP_NONE)
+        {
+            SDL_RenderCopyF(self->m_renderer, texture, srcRect, dstRect);
+        }
+        else
+        {
+            SDL_RenderCopyExF(self->m_renderer, texture, srcRect, dstRect, angle, center, flip);
+        }
+        RenderState_setTextureColorMod(g_renderState, texture, r, g, b);
+        RenderState_setTextureAlphaMod(g_renderState, texture, a);
+        self->m_frameDrawCallCount++;
+        return;
+    }
+
+    if (texture != self->m_texture)
+    {
+        SpriteBatch_flush(self);
+        SpriteBatch_setTexture(self, texture);
+    }
+    else if (self->m_spriteCount >= SPRITE_BATCH_CAPACITY)
+    {
+        SpriteBatch_flush(self);
+    }
+
+    // Coordonnées de texture
+    float u0 = 0.f, v0 = 0.f, u1 = 1.f, v1 = 1.f;
+    if (srcRect)
+    {
+        u0 = (float)srcRect->x / self->m_textureW;
+        v0 = (float)srcRect->y / self->m_textureH;
+        u1 = (float)(srcRect->x + srcRect->w) / self->m_textureW;
+        v1 = (float)(srcRect->y + srcRect->h) / self->m_textureH;
+    }
+    if (flip & SDL_FLIP_HORIZONTAL)
+    {
+        float tmp = u0; u0 = u1; u1 = tmp;
+    }
+    if (flip & SDL_FLIP_VERTICAL)
+    {
+        float tmp = v0; v0 = v1; v1 = tmp;
+    }
+
+    // Coins du rectangle relativement au centre de rotation
+    float cx = center ? center->x : 0.5f * dstRect->w;
+    float cy = center ? center->y : 0.5f * dstRect->h;
+    float x0 = -cx, x1 = dstRect->w - cx;
+    float y0 = -cy, y1 = dstRect->h - cy;
+    float px = dstRect->x + cx;
+    float py = dstRect->y + cy;
+
+    // Rotation dans le sens horaire (l'axe y est orienté vers le bas)
+    float c = 1.f, s = 0.f;
+    if (angle != 0.0)
+    {
+        double radians = angle * M_PI / 180.0;
+        c = (float)cos(radians);
+        s = (float)sin(radians);
+    }
+
+    SDL_Vertex *vertices = self->m_vertices + 4 * self->m_spriteCount;
+    const float xs[4] = { x0, x1, x1, x0 };
+    const float ys[4] = { y0, y0, y1, y1 };
+    const float us[4] = { u0, u1, u1, u0 };
+    const float vs[4] = { v0, v0, v1, v1 };
+    for (int i = 0; i < 4; i++)
+    {
+        vertices[i].position.x = px + xs[i] * c - ys[i] * s;
+        vertices[i].position.y = py + xs[i] * s + ys[i] * c;
+        vertices[i].tex_coord.x = us[i];
+        vertices[i].tex_coord.y = vs[i];
+        vertices[i].color = color;
+    }
+
+    SpriteBatchCopy *copy = self->m_copies + self->m_spriteCount;
+    if (srcRect)
+    {
+        copy->srcRect = *srcRect;
+    }
+    else
+    {
+        SDL_Rect fullRect = { 0, 0, (int)self->m_textureW, (int)self->m_textureH };
+        copy->srcRect = fullRect;
+    }
+    copy->dstRect = *dstRect;
+    copy->center.x = cx;
+    copy->center.y = cy;
+    copy->angle = angle;
+    copy->flip = flip;
+    self->m_spriteCount++;
+}
+
+void SpriteBatch_drawSprite(
+    SpriteBatch *self, SpriteSheet *spriteSheet, int index,
+    const SDL_FRect *dstRect, double angle, SDL_RendererFlip flip)
+{
+    assert(self && "The SpriteBatch must be created");
+    assert(spriteSheet && index >= 0);
+    index = index % spriteSheet->rectCount;
+
+    // L'opacité est celle de la sprite sheet, pas celle de sa texture
+    // qui peut être partagée dans un atlas
+    SDL_Color color = { 255, 255, 255, 255 };
+    SDL_GetTextureColorMod(spriteSheet->texture, &color.r, &color.g, &color.b);
+    color.a = spriteSheet->opacity;
+
+    // La rotation intégrée à la sprite sheet est retranchée de l'angle
+    SDL_FRect rect = *dstRect;
+    if (spriteSheet->orientation != SPRITE_ORIENTATION_0)
+    {
+        SpriteSheet_getBakedCopy(spriteSheet, dstRect, angle, NULL, flip, &rect, &angle, &flip);
+    }
+
+    if (self->m_blitter && spriteSheet->image && SoftBlitter_isQuarterTurn(angle))
+    {
+        // Copie logicielle immédiate, sans appel au moteur de rendu SDL
+        SoftBlitter_copy(
+            self->m_blitter, spriteSheet->image, spriteSheet->rects + index,
+            &rect, angle, flip, color
+        );
+        self->m_frameSpriteCount++;
+        return;
+    }
+    if (self->m_blitter)
+    {
+        // Angle quelconque ou sprite sheet sans copie en mémoire centrale :
+        // la SDL dessine le sprite, relu aussitôt pour conserver l'ordre
+        SpriteBatch_drawCaptured(
+            self, spriteSheet->texture, spriteSheet->rects + index,
+            &rect, angle, flip, color
+        );
+        return;
+    }
+
+    SpriteBatch_draw(
+        self, spriteSheet->texture, spriteSheet->rects + index,
+        &rect, angle, NULL, flip, color
+    );
+}
+
+static void SpriteBatch_drawCaptured(
+    SpriteBatch *self, SDL_Texture *texture,
+    const SDL_Rect *srcRect, const SDL_FRect *dstRect,
+    double angle, SDL_RendererFlip flip, SDL_Color color)
+{
+    SoftBlitter *blitter = self->m_blitter;
+    SDL_Surface *framebuffer = blitter->m_framebuffer;
+
+    // Rectangle englobant la copie tournée, limité à l'image
+    float c = 1.f, s = 0.f;
+    if (angle != 0.0)
+    {
+        double radians = angle * M_PI / 180.0;
+        c = fabsf((float)cos(radians));
+        s = fabsf((float)sin(radians));
+    }
+    float w = dstRect->w * c + dstRect->h * s;
+    float h = dstRect->w * s + dstRect->h * c;
+    float cx = dstRect->x + 0.5f * dstRect->w;
+    float cy = dstRect->y + 0.5f * dstRect->h;
+    int x0 = SDL_max((int)floorf(cx - 0.5f * w), 0);
+    int y0 = SDL_max((int)floorf(cy - 0.5f * h), 0);
+    int x1 = SDL_min((int)ceilf(cx + 0.5f * w), framebuffer->w);
+    int y1 = SDL_min((int)ceilf(cy + 0.5f * h), framebuffer->h);
+    if (x0 >= x1 || y0 >= y1)
+    {
+        self->m_frameSpriteCount++;
+        return;
+    }
+
+    SpriteBatch_flush(self);
+    if (SoftBlitter_beginCapture(blitter, x1 - x0, y1 - y0) == false)
+        return;
+
+    // Le sprite est dessiné relativement au coin de la zone capturée
+    SDL_FRect rect = *dstRect;
+    rect.x -= (float)x0;
+    rect.y -= (float)y0;
+    SpriteBatch_draw(self, texture, srcRect, &rect, angle, NULL, flip, color);
+    SpriteBatch_flush(self);
+
+    SoftBlitter_endCapture(blitter, x0, y0, false);
+}
+
+void SpriteBatch_flush(SpriteBatch *self)
+{
+    assert(self && "The SpriteBatch must be created");
+    if (self->m_spriteCount <= 0)
+        return;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    // La modulation est portée par les sommets, celle de la texture
+    // est neutralisée le temps de l'appel puis rétablie
+    Uint8 r = 255, g = 255, b = 255, a = 255;
+    SDL_GetTextureColorMod(self->m_texture, &r, &g, &b);
+    SDL_GetTextureAlphaMod(self->m_texture, &a);
+    RenderState_setTextureColorMod(g_renderState, self->m_texture, 255, 255, 255);
+    RenderState_setTextureAlphaMod(g_renderState, self->m_texture, 255);
+
+    int exitStatus = SDL_RenderGeometry(
+        self->m_renderer, self->m_texture,
+        self->m_vertices, 4 * self->m_spriteCount,
+        self->m_indices, 6 * self->m_spriteCount
+    );
+
+    if (exitStatus < 0)
+    {
+        printf("WARNING - SDL_RenderGeometry() %s\n", SDL_GetError());
+        printf("        - sprites are no longer batched\n");
+        self->m_useGeometry = false;
+
+        // Les sprites du lot sont tout de même dessinés pour cette image
+        SpriteBatch_copyPending(self);
+    }
+    else
+    {
+        self->m_frameDrawCallCount++;
+    }
+
+    RenderState_setTextureColorMod(g_renderState, self->m_texture, r, g, b);
+    RenderState_setTextureAlphaMod(g_renderState, self->m_texture, a);
+#endif
+
+    self->m_spriteCount = 0;
+}
+
+void SpriteBatch_end(SpriteBatch *self)
+{
+    assert(self && "The SpriteBatch must be created");
+    SpriteBatch_flush(self);
+    self->m_texture = NULL;
+
+    self->m_totalSpriteCount += self->m_frameSpriteCount;
+    self->m_totalDrawCallCount += self->m_frameDrawCallCount;
+    self->m_frameCount++;
+}
+
+void SpriteBatch_printStats(SpriteBatch *self)
+{
+    assert(self && "The SpriteBatch must be created");
+
+    if (self->m_frameCount > 0)
+    {
+        double frameCount = (double)self->m_frameCount;
+        printf("INFO - Sprite batch over %llu frames\n",
+            (unsigned long long)self->m_frameCount);
+        printf("     - %.1f sprites/frame (draw calls/frame without batching)\n",
+            (double)self->m_totalSpriteCount / frameCount);
+        printf("     - %.1f draw calls/frame with batching (%s)\n",
+            (double)self->m_totalDrawCallCount / frameCount,
+            self->m_useGeometry ? "SDL_RenderGeometry" : "SDL_RenderCopyExF");
+    }
+
+    self->m_totalSpriteCount = 0;
+    self->m_totalDrawCallCount = 0;
+    self->m_frameCount = 0;
+}
+
+static void SpriteBatch_copyPending(SpriteBatch *self)
+{
+    for (int i = 0; i < self->m_spriteCount; i++)
+    {
+        const SpriteBatchCopy *copy = self->m_copies + i;
+        SDL_Color color = self->m_vertices[4 * i].color;
+        RenderState_setTextureColorMod(g_renderState, self->m_texture, color.r, color.g, color.b);
+        RenderState_setTextureAlphaMod(g_renderState, self->m_texture, color.a);
+        SDL_RenderCopyExF(
+            self->m_renderer, self->m_texture, &copy->srcRect, &copy->dstRect,
+            copy->angle, &copy->center, copy->flip
+        );
+        self->m_frameDrawCallCount++;
+    }
+}
+
+static void SpriteBatch_setTexture(SpriteBatch *self, SDL_Texture *texture)
+{
+    int w = 0, h = 0;
+    SDL_QueryTexture(texture, NULL, NULL, &w, &h);
+    assert(w > 0 && h > 0);
+
+    self->m_texture = texture;
+    self->m_textureW = (float)w;
+    self->m_textureH = (float)h;
+}
@@ -0,0 +1,144 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+#include "utils/asset_manager.h"
+#include "utils/soft_blitter.h"
+
+/// @brief Nombre de sprites pouvant être regroupés dans un même appel
+/// de dessin. Le lot est vidé automatiquement lorsqu'il est plein.
+#define SPRITE_BATCH_CAPACITY 2048
+
+/// @brief Paramètres de copie d'un sprite du lot, conservés pour le
+/// redessiner avec SDL_RenderCopyExF() si SDL_RenderGeometry() échoue.
+typedef struct SpriteBatchCopy
+{
+    SDL_Rect srcRect;
+    SDL_FRect dstRect;
+    SDL_FPoint center;
+    double angle;
+    SDL_RendererFlip flip;
+} SpriteBatchCopy;
+
+/// @brief Structure représentant un lot de sprites.
+/// Les quadrilatères texturés sont accumulés dans des tampons de sommets et
+/// d'indices puis envoyés au moteur de rendu avec un seul appel à
+/// SDL_RenderGeometry() par texture consécutive.
+typedef struct SpriteBatch
+{
+    SDL_Renderer *m_renderer;
+
+    /// @brief Texture des sprites en attente (NULL si le lot est vide).
+    SDL_Texture *m_texture;
+
+    /// @brief Dimensions de m_texture (en pixels).
+    float m_textureW, m_textureH;
+
+    /// @brief Sommets des sprites en attente (4 par sprite).
+    SDL_Vertex *m_vertices;
+
+    /// @brief Indices des deux triangles de chaque sprite.
+    /// Ils ne dépendent que de la position du sprite dans le lot
+    /// et sont donc calculés une seule fois.
+    int *m_indices;
+
+    /// @brief Paramètres de copie des sprites en attente.
+    SpriteBatchCopy *m_copies;
+
+    /// @brief Nombre de sprites en attente.
+    int m_spriteCount;
+
+    /// @brief Booléen indiquant si SDL_RenderGeometry() est utilisée.
+    /// Sinon chaque sprite est copié avec SDL_RenderCopyExF().
+    bool m_useGeometry;
+
+    /// @brief Moteur de rendu logiciel recevant tous les sprites de
+    /// SpriteBatch_drawSprite(), ou NULL.
+    SoftBlitter *m_blitter;
+
+    /// @brief Nombre de sprites et d'appels de dessin de l'image courante.
+    int m_frameSpriteCount;
+    int m_frameDrawCallCount;
+
+    /// @brief Statistiques cumulées depuis le dernier affichage.
+    Uint64 m_totalSpriteCount;
+    Uint64 m_totalDrawCallCount;
+    Uint64 m_frameCount;
+} SpriteBatch;
+
+/// @brief Crée un lot de sprites.
+/// @param renderer le moteur de rendu.
+/// @return Le lot de sprites créé.
+SpriteBatch *SpriteBatch_create(SDL_Renderer *renderer);
+
+/// @brief Détruit un lot de sprites.
+/// @param self le lot de sprites.
+void SpriteBatch_destroy(SpriteBatch *self);
+
+/// @brief Commence une nouvelle image.
+/// @param self le lot de sprites.
+void SpriteBatch_begin(SpriteBatch *self);
+
+/// @brief Définit le moteur de rendu logiciel utilisé par
+/// SpriteBatch_drawSprite(). Tant qu'il est défini, tous les sprites
+/// aboutissent dans son image, dans l'ordre des appels : ceux dont la sprite
+/// sheet possède une copie en mémoire centrale (voir
+/// AssetManager_setKeepImages()) et dont l'angle est un quart de tour y sont
+/// copiés directement, les autres sont dessinés par la SDL dans une capture
+/// (voir SoftBlitter_beginCapture()) puis relus.
+/// L'image doit ensuite être envoyée avec SoftBlitter_upload().
+/// @param self le lot de sprites.
+/// @param blitter le moteur de rendu logiciel, ou NULL pour le désactiver.
+void SpriteBatch_setSoftBlitter(SpriteBatch *self, SoftBlitter *blitter);
+
+/// @brief Ajoute la copie d'une partie d'une texture au lot.
+/// Les paramètres sont ceux de SDL_RenderCopyExF() auxquels s'ajoute
+/// une couleur qui module celle de la texture (l'alpha module l'opacité).
+/// Le lot est vidé si la texture change.
+/// @param self le lot de sprites.
+/// @param texture la texture source.
+/// @param srcRect le rectangle source, ou NULL pour toute la texture.
+/// @param dstRect le rectangle de destination sur le rendu.
+/// @param angle l'angle de rotation, en degrés (sens horaire).
+/// @param center le centre de rotation, ou NULL pour le centre de dstRect.
+/// @param flip flag indiquant quels retournements sont appliqués à la copie.
+/// @param color la couleur de modulation.
+void SpriteBatch_draw(
+    SpriteBatch *self, SDL_Texture *texture,
+    const SDL_Rect *srcRect, const SDL_FRect *dstRect,
+    double angle, const SDL_FPoint *center, SDL_RendererFlip flip,
+    SDL_Color color);
+
+/// @brief Ajoute un sprite d'une sprite sheet au lot.
+/// La couleur de la texture et l'opacité de la sprite sheet (voir
+/// SpriteSheet_setOpacity()) au moment de l'appel sont utilisées comme
+/// modulation.
+/// @param self le lot de sprites.
+/// @param spriteSheet la sprite sheet.
+/// @param index indice du sprite à copier.
+/// @param dstRect le rectangle de destination sur le rendu.
+/// @param angle l'angle de rotation, en degrés.
+/// @param flip flag indiquant quels retournements sont appliqués à la copie.
+void SpriteBatch_drawSprite(
+    SpriteBatch *self, SpriteSheet *spriteSheet, int index,
+    const SDL_FRect *dstRect, double angle, SDL_RendererFlip flip);
+
+/// @brief Envoie au moteur de rendu les sprites en attente.
+/// Doit être appelée avant toute autre opération de dessin
+/// qui doit apparaître au-dessus des sprites.
+/// @param self le lot de sprites.
+void SpriteBatch_flush(SpriteBatch *self);
+
+/// @brief Termine l'image courante et vide le lot.
+/// @param self le lot de sprites.
+void SpriteBatch_end(SpriteBatch *self);
+
+/// @brief Affiche le nombre moyen d'appels de dessin par image, avec et
+/// sans regroupement, puis remet les statistiques à zéro.
+/// @param self le lot de sprites.
+void SpriteBatch_printStats(SpriteBatch *self);
@@ -9,6 +9,9 @@
 
 void Text_refreshTexture(Text *self);
 
+/// @brief Dernière version attribuée à une texture de texte.
+static Uint32 g_textVersion = 0;
+
 Text *Text_create(SDL_Renderer *renderer, TTF_Font *font, const char *str, SDL_Color color)
 {
     assert(renderer && "The SDL_Renderer must be created");
@@ -83,6 +86,10 @@ void Text_refreshTexture(Text *self)
     self->m_texture = SDL_CreateTextureFromSurface(self->m_renderer, surface);
     AssertNew(self->m_texture);
 
+    self->m_width = surface->w;
+    self->m_height = surface->h;
+    self->m_version = ++g_textVersion;
+
     SDL_FreeSurface(surface);
 }
 
@@ -16,6 +16,13 @@ typedef struct Text
     SDL_Color m_color;
     SDL_Texture *m_texture;
     SDL_Renderer *m_renderer;
+
+    /// @brief Dimensions de la texture (en pixels).
+    int m_width, m_height;
+
+    /// @brief Version de la texture, unique parmi tous les textes.
+    /// Elle change à chaque fois que la texture est recréée.
+    Uint32 m_version;
 } Text;
 
 /// @brief Crée un texte affichable.
@@ -55,3 +62,30 @@ INLINE SDL_Texture *Text_getTexture(Text *self)
 {
     return self->m_texture;
 }
+
+/// @brief Renvoie la largeur de la texture d'un texte affichable.
+/// @param self le texte.
+/// @return La largeur de la texture (en pixels).
+INLINE int Text_getWidth(Text *self)
+{
+    return self->m_width;
+}
+
+/// @brief Renvoie la hauteur de la texture d'un texte affichable.
+/// @param self le texte.
+/// @return La hauteur de la texture (en pixels).
+INLINE int Text_getHeight(Text *self)
+{
+    return self->m_height;
+}
+
+/// @brief Renvoie la version de la texture d'un texte affichable.
+/// Deux textures différentes n'ont jamais la même version, ce qui permet
+/// de détecter un changement de contenu ou de couleur sans comparer
+/// les chaînes.
+/// @param self le texte.
+/// @return La version de la texture.
+INLINE Uint32 Text_getVersion(Text *self)
+{
+    return self->m_version;
+}
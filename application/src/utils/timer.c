@@ -54,4 +54,28 @@ void Timer_update(Timer* self)
 
     self->m_unscaledElapsed += self->m_unscaledDelta;
     self->m_elapsed += self->m_delta;
-}
\ No newline at end of file
+}
+
+void Timer_resync(Timer *self)
+{
+    assert(self && "The Timer must be created");
+    self->m_currentTime = SDL_GetTicks64();
+    self->m_previousTime = self->m_currentTime;
+}
+
+void Timer_step(Timer *self, Uint64 deltaMS)
+{
+    assert(self && "The Timer must be created");
+    self->m_previousTime = self->m_currentTime;
+    self->m_currentTime = SDL_GetTicks64();
+
+    self->m_unscaledDelta = deltaMS;
+    if (self->m_unscaledDelta > self->m_maxDelta)
+    {
+        self->m_unscaledDelta = self->m_maxDelta;
+    }
+    self->m_delta = (Uint64)(self->m_scale * (double)self->m_unscaledDelta);
+
+    self->m_unscaledElapsed += self->m_unscaledDelta;
+    self->m_elapsed += self->m_delta;
+}
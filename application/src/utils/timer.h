@@ -70,6 +70,21 @@ void Timer_start(Timer* self);
 /// @param self le timer.
 void Timer_update(Timer* self);
 
+/// @brief Ignore le temps écoulé depuis le dernier appel à Timer_update().
+/// A utiliser après une longue interruption (fenêtre minimisée...) pour que
+/// la prochaine mise à jour ne produise pas un écart de temps important.
+/// @param self le timer.
+void Timer_resync(Timer *self);
+
+/// @brief Fait avancer le timer d'un pas de temps fixe, indépendamment
+/// du temps réellement écoulé.
+/// Le temps actuel est tout de même relevé pour que le prochain appel à
+/// Timer_update() ne mesure que le temps écoulé depuis ce pas.
+/// Cette fonction est utilisée pour simuler plusieurs pas par image.
+/// @param self le timer.
+/// @param deltaMS le pas de temps (non affecté par l'échelle), en millisecondes.
+void Timer_step(Timer *self, Uint64 deltaMS);
+
 /// @brief Définit le facteur d'échelle de temps appliqué à un timer.
 /// Si l'échelle vaut 0.5f, le temps s'écoule deux fois moins rapidement.
 /// @param self le timer.
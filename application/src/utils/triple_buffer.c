@@ -0,0 +1,60 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "utils/triple_buffer.h"
+
+#define TRIPLE_BUFFER_INDEX 0x3
+#define TRIPLE_BUFFER_FRESH 0x4
+
+TripleBuffer *TripleBuffer_create(size_t size)
+{
+    assert(size > 0);
+
+    TripleBuffer *self = (TripleBuffer *)calloc(1, sizeof(TripleBuffer));
+    AssertNew(self);
+
+    self->m_memory = (Uint8 *)calloc(3, size);
+    AssertNew(self->m_memory);
+
+    self->m_size = size;
+    self->m_back = 0;
+    self->m_front = 1;
+    SDL_AtomicSet(&self->m_middle, 2);
+
+    return self;
+}
+
+void TripleBuffer_destroy(TripleBuffer *self)
+{
+    if (!self) return;
+    free(self->m_memory);
+    free(self);
+}
+
+void *TripleBuffer_getWriteBuffer(TripleBuffer *self)
+{
+    assert(self && "The TripleBuffer must be created");
+    return self->m_memory + (size_t)self->m_back * self->m_size;
+}
+
+void TripleBuffer_publish(TripleBuffer *self)
+{
+    assert(self && "The TripleBuffer must be created");
+    // SDL_AtomicSet() renvoie l'ancienne valeur et agit comme une barrière
+    int prev = SDL_AtomicSet(&self->m_middle, self->m_back | TRIPLE_BUFFER_FRESH);
+    self->m_back = prev & TRIPLE_BUFFER_INDEX;
+}
+
+const void *TripleBuffer_acquire(TripleBuffer *self)
+{
+    assert(self && "The TripleBuffer must be created");
+    if (SDL_AtomicGet(&self->m_middle) & TRIPLE_BUFFER_FRESH)
+    {
+        int prev = SDL_AtomicSet(&self->m_middle, self->m_front);
+        self->m_front = prev & TRIPLE_BUFFER_INDEX;
+    }
+    return self->m_memory + (size_t)self->m_front * self->m_size;
+}
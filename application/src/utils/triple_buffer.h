@@ -0,0 +1,58 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+
+/// @brief Structure représentant un tampon triple sans verrou.
+/// Un unique producteur écrit dans le tampon arrière puis le publie,
+/// un unique consommateur lit la dernière version publiée.
+/// Aucun des deux threads n'attend l'autre.
+typedef struct TripleBuffer
+{
+    /// @brief Mémoire des trois tampons (contigus).
+    Uint8 *m_memory;
+
+    /// @brief Taille d'un tampon (en octets).
+    size_t m_size;
+
+    /// @brief Indice du tampon en cours d'écriture (producteur).
+    int m_back;
+
+    /// @brief Indice du tampon en cours de lecture (consommateur).
+    int m_front;
+
+    /// @brief Indice du tampon intermédiaire échangé entre les threads.
+    /// Le bit TRIPLE_BUFFER_FRESH indique qu'il n'a pas encore été lu.
+    SDL_atomic_t m_middle;
+} TripleBuffer;
+
+/// @brief Crée un tampon triple.
+/// Les trois tampons sont initialisés à zéro.
+/// @param size la taille d'un tampon (en octets).
+/// @return Le tampon triple créé.
+TripleBuffer *TripleBuffer_create(size_t size);
+
+/// @brief Détruit un tampon triple.
+/// @param self le tampon triple.
+void TripleBuffer_destroy(TripleBuffer *self);
+
+/// @brief Renvoie le tampon dans lequel le producteur peut écrire.
+/// @param self le tampon triple.
+/// @return Le tampon arrière.
+void *TripleBuffer_getWriteBuffer(TripleBuffer *self);
+
+/// @brief Publie le tampon arrière pour le consommateur.
+/// Le producteur obtient un nouveau tampon arrière.
+/// @param self le tampon triple.
+void TripleBuffer_publish(TripleBuffer *self);
+
+/// @brief Renvoie la dernière version publiée par le producteur.
+/// Le tampon renvoyé reste valide jusqu'au prochain appel de cette fonction.
+/// @param self le tampon triple.
+/// @return Le tampon avant.
+const void *TripleBuffer_acquire(TripleBuffer *self);
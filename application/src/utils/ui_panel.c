@@ -0,0 +1,122 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "utils/ui_panel.h"
+#include "utils/common.h"
+
+UIPanel *UIPanel_create(SDL_Renderer *renderer, int width, int height, bool opaque)
+{
+    assert(renderer && "The SDL_Renderer must be created");
+    assert(width > 0 && height > 0);
+
+    UIPanel *self = (UIPanel *)calloc(1, sizeof(UIPanel));
+    AssertNew(self);
+
+    self->m_renderer = renderer;
+    self->m_rect.w = width;
+    self->m_rect.h = height;
+
+    if (SDL_RenderTargetSupported(renderer) == SDL_FALSE)
+        return self;
+
+    self->m_texture = SDL_CreateTexture(
+        renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height
+    );
+    if (self->m_texture == NULL)
+    {
+        printf("ERROR - Create UI panel %s\n", SDL_GetError());
+        return self;
+    }
+
+    // La texture contient des couleurs prémultipliées par l'alpha :
+    // dessiner avec SDL_BLENDMODE_BLEND sur un fond transparent donne
+    // (c.a, a), il faut donc la copier avec (ONE, ONE_MINUS_SRC_ALPHA)
+    SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+    if (opaque == false)
+    {
+        blendMode = SDL_ComposeCustomBlendMode(
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD
+        );
+    }
+    if (SDL_SetTextureBlendMode(self->m_texture, blendMode) < 0)
+    {
+        // Mode non supporté (moteur logiciel) : dessin direct
+        SDL_DestroyTexture(self->m_texture);
+        self->m_texture = NULL;
+    }
+
+    return self;
+}
+
+void UIPanel_destroy(UIPanel *self)
+{
+    if (!self) return;
+    if (self->m_texture) SDL_DestroyTexture(self->m_texture);
+    free(self);
+}
+
+void UIPanel_invalidate(UIPanel *self)
+{
+    assert(self && "The UIPanel must be created");
+    self->m_valid = false;
+}
+
+bool UIPanel_beginCompose(UIPanel *self, Uint64 key, int x, int y)
+{
+    assert(self && "The UIPanel must be created");
+    SDL_Renderer *renderer = self->m_renderer;
+
+    self->m_rect.x = x;
+    self->m_rect.y = y;
+
+    if (self->m_texture == NULL)
+    {
+        // Dessin direct, limité au rectangle du panneau
+        SDL_RenderGetViewport(renderer, &(self->m_prevViewport));
+        SDL_RenderSetViewport(renderer, &(self->m_rect));
+        return true;
+    }
+
+    if (self->m_valid && self->m_key == key)
+        return false;
+
+    self->m_prevTarget = SDL_GetRenderTarget(renderer);
+    if (SDL_SetRenderTarget(renderer, self->m_texture) < 0)
+    {
+        printf("ERROR - Compose UI panel %s\n", SDL_GetError());
+        return false;
+    }
+
+    assert(renderer == g_renderer);
+    RenderState_setDrawColor(g_renderState, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+
+    self->m_key = key;
+    self->m_valid = true;
+    return true;
+}
+
+void UIPanel_endCompose(UIPanel *self)
+{
+    assert(self && "The UIPanel must be created");
+    if (self->m_texture == NULL)
+    {
+        SDL_RenderSetViewport(self->m_renderer, &(self->m_prevViewport));
+        return;
+    }
+    SDL_SetRenderTarget(self->m_renderer, self->m_prevTarget);
+    self->m_prevTarget = NULL;
+}
+
+void UIPanel_render(UIPanel *self)
+{
+    assert(self && "The UIPanel must be created");
+    if (self->m_texture == NULL || self->m_valid == false)
+        return;
+
+    SDL_RenderCopy(self->m_renderer, self->m_texture, NULL, &(self->m_rect));
+}
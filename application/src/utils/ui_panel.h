@@ -0,0 +1,97 @@
+﻿/*
+    Copyright (c) Arnaud BANNIER and Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+
+/// @brief Structure représentant un panneau d'interface mis en cache.
+/// Le contenu du panneau est composé une seule fois dans une texture
+/// (cible de rendu), puis recomposé uniquement lorsque sa clé change.
+/// La clé résume l'état du contenu, par exemple les versions des textes
+/// (Text_getVersion()) et les couleurs utilisées.
+/// Chaque image coûte alors une seule copie.
+typedef struct UIPanel
+{
+    SDL_Renderer *m_renderer;
+
+    /// @brief Contenu du panneau, ou NULL si le panneau est dessiné
+    /// directement à chaque image (cibles de rendu non supportées).
+    SDL_Texture *m_texture;
+
+    /// @brief Position et dimensions du panneau sur le rendu (en pixels).
+    SDL_Rect m_rect;
+
+    /// @brief Clé du contenu de la texture.
+    Uint64 m_key;
+
+    /// @brief Booléen indiquant si la texture correspond à m_key.
+    bool m_valid;
+
+    /// @brief Cible de rendu et viewport à restaurer après la composition.
+    SDL_Texture *m_prevTarget;
+    SDL_Rect m_prevViewport;
+} UIPanel;
+
+/// @brief Crée un panneau d'interface.
+/// Un panneau transparent est composé avec l'alpha prémultiplié afin que
+/// ses zones semi-transparentes se mélangent comme en dessin direct.
+/// @param renderer le moteur de rendu.
+/// @param width la largeur du panneau (en pixels).
+/// @param height la hauteur du panneau (en pixels).
+/// @param opaque booléen indiquant si le panneau recouvre entièrement
+/// son rectangle.
+/// @return Le panneau créé.
+UIPanel *UIPanel_create(SDL_Renderer *renderer, int width, int height, bool opaque);
+
+/// @brief Détruit un panneau d'interface.
+/// @param self le panneau.
+void UIPanel_destroy(UIPanel *self);
+
+/// @brief Force la recomposition du panneau,
+/// par exemple après un événement SDL_RENDER_TARGETS_RESET.
+/// @param self le panneau.
+void UIPanel_invalidate(UIPanel *self);
+
+/// @brief Commence la composition du panneau si son contenu a changé.
+/// Lorsque la fonction renvoie true, l'appelant dessine le contenu dans
+/// le référentiel du panneau (origine en haut à gauche) puis appelle
+/// UIPanel_endCompose().
+/// @param self le panneau.
+/// @param key la clé du contenu.
+/// @param x l'abscisse du panneau sur le rendu (en pixels).
+/// @param y l'ordonnée du panneau sur le rendu (en pixels).
+/// @return true si le contenu doit être dessiné.
+bool UIPanel_beginCompose(UIPanel *self, Uint64 key, int x, int y);
+
+/// @brief Termine la composition du panneau.
+/// @param self le panneau.
+void UIPanel_endCompose(UIPanel *self);
+
+/// @brief Copie le contenu du panneau dans le rendu.
+/// @param self le panneau.
+void UIPanel_render(UIPanel *self);
+
+/// @brief Combine une valeur avec la clé d'un panneau.
+/// @param key la clé courante.
+/// @param value la valeur à combiner.
+/// @return La nouvelle clé.
+INLINE Uint64 UIPanel_hash(Uint64 key, Uint64 value)
+{
+    // FNV-1a appliqué à un mot de 64 bits
+    return (key ^ value) * 0x100000001B3ull;
+}
+
+/// @brief Combine une couleur avec la clé d'un panneau.
+/// @param key la clé courante.
+/// @param color la couleur.
+/// @return La nouvelle clé.
+INLINE Uint64 UIPanel_hashColor(Uint64 key, SDL_Color color)
+{
+    Uint32 value = ((Uint32)color.r << 24) | ((Uint32)color.g << 16)
+        | ((Uint32)color.b << 8) | (Uint32)color.a;
+    return UIPanel_hash(key, value);
+}